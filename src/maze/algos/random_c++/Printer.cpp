@@ -1,8 +1,14 @@
 #include "Printer.h"
 
+#include <cstdio>
 #include <iostream>
 #include <string>
 
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
 void Printer::print(
         std::vector<std::vector<std::map<char, bool> > >* maze) {
 
@@ -68,3 +74,45 @@ void Printer::print(
         std::cerr << rightSideUpLines.at(i) << std::endl;
     }
 }
+
+void Printer::printBinary(
+        std::vector<std::vector<std::map<char, bool> > >* maze,
+        unsigned int seed) {
+
+    int width = maze->size();
+    int height = maze->at(0).size();
+
+    // The header
+    std::string record = "MMSW";
+    for (int i = 0; i < 4; i += 1) {
+        record.push_back((seed >> (8 * i)) & 0xff);
+    }
+    record.push_back(width & 0xff);
+    record.push_back((width >> 8) & 0xff);
+    record.push_back(height & 0xff);
+    record.push_back((height >> 8) & 0xff);
+
+    // The walls, two tiles per byte
+    std::string walls((width * height + 1) / 2, '\0');
+    for (int y = 0; y < height; y += 1) {
+        for (int x = 0; x < width; x += 1) {
+            std::map<char, bool>& cell = maze->at(x).at(y);
+            int bits = (
+                (cell.at('n') ? 1 : 0) |
+                (cell.at('e') ? 2 : 0) |
+                (cell.at('s') ? 4 : 0) |
+                (cell.at('w') ? 8 : 0)
+            );
+            int index = y * width + x;
+            walls.at(index / 2) |= bits << (4 * (index % 2));
+        }
+    }
+    record += walls;
+
+    // Don't let Windows turn any of the bytes into line endings
+#ifdef _WIN32
+    _setmode(_fileno(stderr), _O_BINARY);
+#endif
+    std::cerr.write(record.data(), record.size());
+    std::cerr.flush();
+}
@@ -1,8 +1,7 @@
 #include "Algo.h"
 
-#include <stack>
+#include <algorithm>
 #include <cmath>
-#include <queue>
 #include <iostream>
 
 void Algo::generate(Interface* interface) {
@@ -17,16 +16,16 @@ void Algo::convertToBasicMaze(Interface* mazeInterface) {
             for (char c : {'n', 'e', 's', 'w'}) {
                 switch (c) {
                     case 'n':
-                        mazeInterface->setWall(x, y, 'n', getTile(x, y)->walls.at(NORTH));
+                        mazeInterface->setWall(x, y, 'n', getTile(x, y)->isWall(NORTH));
                         break;
                     case 'e':
-                        mazeInterface->setWall(x, y, 'e', getTile(x, y)->walls.at(EAST));
+                        mazeInterface->setWall(x, y, 'e', getTile(x, y)->isWall(EAST));
                         break;
                     case 's':
-                        mazeInterface->setWall(x, y, 's', getTile(x, y)->walls.at(SOUTH));
+                        mazeInterface->setWall(x, y, 's', getTile(x, y)->isWall(SOUTH));
                         break;
                     case 'w':
-                        mazeInterface->setWall(x, y, 'w', getTile(x, y)->walls.at(WEST));
+                        mazeInterface->setWall(x, y, 'w', getTile(x, y)->isWall(WEST));
                         break;
                         
                 }
@@ -47,38 +46,39 @@ void Algo::generateMaze(int mazeWidth, int mazeHeight) {
     getTile(0, 0)->explored = true; // Put the first cell on stack
     getTile(0, 0)->distanceFromStart = 0; // Cell 0
     TomMazeGenTile* t = getTile(0,0);
-    m_stack.push(t);
+    m_stack.clear();
+    m_stack.push_back(t);
                         
     const double deadEndBreak = tomDeadEndBreakChance;
     
     // Continue to DFS until we've explored every Tile
     while (m_stack.empty() == false) {
         // Grab and unpack the top thing from the stack
-        TomMazeGenTile* current = m_stack.top();
+        TomMazeGenTile* current = m_stack.back();
         
         const int xPos = current->column;
         const int yPos = current->row; 
         
         // Keep track of the next possible movements
 
-        std::map<Direction, bool> choices = {
-            {NORTH, isValidUnexploredMove(xPos, yPos, NORTH)},
-            {EAST,  isValidUnexploredMove(xPos, yPos, EAST) },
-            {SOUTH, isValidUnexploredMove(xPos, yPos, SOUTH)},
-            {WEST,  isValidUnexploredMove(xPos, yPos, WEST) }
+        const bool choices[4] = {
+            isValidUnexploredMove(xPos, yPos, NORTH),
+            isValidUnexploredMove(xPos, yPos, EAST),
+            isValidUnexploredMove(xPos, yPos, SOUTH),
+            isValidUnexploredMove(xPos, yPos, WEST)
         };
         
         int possible = 0;
         
-        for (auto &choice : choices) {
-            if (choice.second) {
+        for (bool choice : choices) {
+            if (choice) {
                 possible += 1; // Count how many cells can be moved to
             }
         }
 
         // If the current cell has no more paths forward, we're done
         if (possible == 0) {
-            m_stack.pop(); // Pop the tile of the stack, this will prompt the algorith to go back
+            m_stack.pop_back(); // Pop the tile of the stack, this will prompt the algorith to go back
                            // until a cell has possible moves
             //std::cout << "HERE2" << std::endl;
                                       
@@ -97,7 +97,7 @@ void Algo::generateMaze(int mazeWidth, int mazeHeight) {
             const double xCenterDistance = (abs(xPos - m_width / 2.0) * 2.0) / (m_width-1); //ratios of how far you are from the center
             const double yCenterDistance = (abs(yPos - m_height / 2.0) * 2.0) / (m_height-1);
             
-            const static double straightFactor = tomStraightFactor;
+            const double straightFactor = tomStraightFactor;
 
             // the chance the algorithm will continue same direction of tavel
             // if zero the maze will always turn. if 1 maze will be longest possible
@@ -230,25 +230,25 @@ Direction Algo::moveTowardDirection(int xPos, int yPos, Direction directionToMov
         case NORTH:
             setWall(xPos, yPos, NORTH, false);
             getTile(xPos, yPos, NORTH)->explored = true;
-            m_stack.push(getTile(xPos, yPos, NORTH)); // Push next cell unto stack
+            m_stack.push_back(getTile(xPos, yPos, NORTH)); // Push next cell unto stack
             exploreDIR = NORTH;
             break;
         case EAST:
             setWall(xPos, yPos, EAST, false);
             getTile(xPos, yPos, EAST)->explored = true;
-            m_stack.push(getTile(xPos, yPos, EAST));
+            m_stack.push_back(getTile(xPos, yPos, EAST));
             exploreDIR = EAST;
             break;
         case SOUTH:
             setWall(xPos, yPos, SOUTH, false);
             getTile(xPos, yPos, SOUTH)->explored = true;
-            m_stack.push(getTile(xPos, yPos, SOUTH));
+            m_stack.push_back(getTile(xPos, yPos, SOUTH));
             exploreDIR = SOUTH;
             break;
         case WEST:
             setWall(xPos, yPos, WEST, false);
             getTile(xPos, yPos, WEST)->explored = true;
-            m_stack.push(getTile(xPos, yPos, WEST));
+            m_stack.push_back(getTile(xPos, yPos, WEST));
             exploreDIR = WEST;
             break;
         case UNDEFINED:
@@ -270,69 +270,66 @@ void Algo::updateDistanceFromStart(int xPos, int yPos){
     // has been explored, since it will be walled off completely.  Cells start with all
     // walls up.
     
-     for (int x = 0; x < m_width; x++) {
-        std::vector<TomMazeGenTile> column;
-        for (int y = 0; y < m_height; y++) {
-             getTile(x, y)->distanceFromStart = -1; // reset all distances
-        }
+    for (TomMazeGenTile& tile : m_maze) {
+        tile.distanceFromStart = -1; // reset all distances
     }
     
-    std::queue<TomMazeGenTile*> pathQueue;
+    // The queue is a vector that's only ever appended to, with the front of
+    // the queue at the head index, so that its memory can be reused
+    m_queue.clear();
+    std::size_t head = 0;
     
-    std::map<Direction, bool> visited = {
-        {NORTH, false},
-        {EAST,  false},
-        {SOUTH, false},
-        {WEST,  false}
-    };
+    bool visitedNorth = false;
+    bool visitedEast = false;
+    bool visitedSouth = false;
+    bool visitedWest = false;
     
     TomMazeGenTile* t = getTile(xPos, yPos);
     t->distanceFromStart = 0; // tile xPos, yPos is start
-    pathQueue.push(t);
+    m_queue.push_back(t);
     
-    while(pathQueue.empty() == false){
-        TomMazeGenTile* tile = pathQueue.front();
-        pathQueue.pop();
+    while(head < m_queue.size()){
+        TomMazeGenTile* tile = m_queue.at(head);
+        head += 1;
         
         int xCurrentPos = tile->column;
         int yCurrentPos = tile->row;
         
         int newDistanceFromStart = tile->distanceFromStart + 1;
         
-        if(tile->walls[NORTH] == false && getTile(xCurrentPos, yCurrentPos, NORTH)->distanceFromStart == -1) {
+        if(tile->isWall(NORTH) == false && getTile(xCurrentPos, yCurrentPos, NORTH)->distanceFromStart == -1) {
             TomMazeGenTile* tileToAdd = getTile(xCurrentPos, yCurrentPos, NORTH);
             tileToAdd->distanceFromStart = newDistanceFromStart;
-            pathQueue.push(tileToAdd);   
-             
+            m_queue.push_back(tileToAdd);
         }
         
-        if(tile->walls[EAST] == false && getTile(xCurrentPos, yCurrentPos, EAST)->distanceFromStart == -1) {
+        if(tile->isWall(EAST) == false && getTile(xCurrentPos, yCurrentPos, EAST)->distanceFromStart == -1) {
             TomMazeGenTile* tileToAdd = getTile(xCurrentPos, yCurrentPos, EAST);
             tileToAdd->distanceFromStart = newDistanceFromStart;
-            pathQueue.push(tileToAdd);    
+            m_queue.push_back(tileToAdd);
         }
         
-        if(tile->walls[SOUTH] == false && getTile(xCurrentPos, yCurrentPos, SOUTH)->distanceFromStart == -1) {
+        if(tile->isWall(SOUTH) == false && getTile(xCurrentPos, yCurrentPos, SOUTH)->distanceFromStart == -1) {
             TomMazeGenTile* tileToAdd = getTile(xCurrentPos, yCurrentPos, SOUTH);
             tileToAdd->distanceFromStart = newDistanceFromStart;
-            pathQueue.push(tileToAdd);    
+            m_queue.push_back(tileToAdd);
         }
         
-        if(tile->walls[WEST] == false && getTile(xCurrentPos, yCurrentPos, WEST)->distanceFromStart == -1) {
+        if(tile->isWall(WEST) == false && getTile(xCurrentPos, yCurrentPos, WEST)->distanceFromStart == -1) {
             TomMazeGenTile* tileToAdd = getTile(xCurrentPos, yCurrentPos, WEST);
             tileToAdd->distanceFromStart = newDistanceFromStart;
-            pathQueue.push(tileToAdd);    
+            m_queue.push_back(tileToAdd);
         }
         
-        if((xCurrentPos == xPos)     && (yCurrentPos + 1 == yPos)) { visited[NORTH] = true; }
-        if((xCurrentPos + 1 == xPos) && (yCurrentPos == yPos))     { visited[EAST]  = true; }
-        if((xCurrentPos == xPos)     && (yCurrentPos - 1 == yPos)) { visited[SOUTH] = true; }
-        if((xCurrentPos - 1 == xPos) && (yCurrentPos == yPos))     { visited[WEST]  = true; }
+        if((xCurrentPos == xPos)     && (yCurrentPos + 1 == yPos)) { visitedNorth = true; }
+        if((xCurrentPos + 1 == xPos) && (yCurrentPos == yPos))     { visitedEast  = true; }
+        if((xCurrentPos == xPos)     && (yCurrentPos - 1 == yPos)) { visitedSouth = true; }
+        if((xCurrentPos - 1 == xPos) && (yCurrentPos == yPos))     { visitedWest  = true; }
         
-        if((visited[NORTH] == true) &&
-           (visited[EAST]  == true) &&
-           (visited[SOUTH] == true) &&
-           (visited[WEST]  == true) &&
+        if((visitedNorth == true) &&
+           (visitedEast  == true) &&
+           (visitedSouth == true) &&
+           (visitedWest  == true) &&
            ((xPos != 0) || (yPos != 0)) ){
            break; // If we are doing breadth search from a cell, we only really NEED the distance
                   // values of all cells adjacent to that cell.  No sense in wasting time
@@ -341,14 +338,14 @@ void Algo::updateDistanceFromStart(int xPos, int yPos){
     
 }
 
-Direction Algo::getDirectionToMove(float moveConst, std::map<Direction, bool> choices){
+Direction Algo::getDirectionToMove(float moveConst, const bool choices[4]){
 
     //if previous move exists, and repeating it will yeild a valid move AND its not the only valid move
 
     int possible = 0;
         
-    for(auto &choice : choices) {
-        if(choice.second == true){
+    for (int i = 0; i < 4; i++) {
+        if(choices[i] == true){
             possible++; // Count how many cells can be moved to
         }
     }   
@@ -359,37 +356,37 @@ Direction Algo::getDirectionToMove(float moveConst, std::map<Direction, bool> ch
         if (m_mazeInterface->getRandomFloat() <= moveConst) {  // if random variable is below threshold move in last direction
             directionToMove = m_direction;
         } else {
-            auto item = choices.begin();
-            std::advance( item, std::floor(m_mazeInterface->getRandomFloat() * 4 ));
-            directionToMove =  item->first;
+            directionToMove = getRandomDirection();
 
             while (choices[directionToMove] == false || directionToMove == m_direction) { // but the last moved direction
-                item = choices.begin();
-                std::advance( item, std::floor(m_mazeInterface->getRandomFloat() * 4 ));
-                directionToMove = item->first;         
+                directionToMove = getRandomDirection();
             }
         }
     }
     else { // otherwise just move in a random viable direction
-        auto item = choices.begin();
-        std::advance( item, std::floor(m_mazeInterface->getRandomFloat() * 4 ));
-        directionToMove = item->first;   
+        directionToMove = getRandomDirection();
 
         while (choices[directionToMove] == false) { // but the last moved direction
-            item = choices.begin();
-            std::advance( item, std::floor(m_mazeInterface->getRandomFloat() * 4 ));
-            directionToMove = item->first;
+            directionToMove = getRandomDirection();
         }
     }
     
     return directionToMove;
 }
+
+Direction Algo::getRandomDirection() {
+    // The random float may be exactly one, which would otherwise be an
+    // index past the last direction
+    int index = static_cast<int>(std::floor(m_mazeInterface->getRandomFloat() * 4));
+    return static_cast<Direction>(std::min(index, 3));
+}
+
 void Algo::breakGradientWall(int xPos, int yPos) {
 
     int currentCellDist = getTile(xPos, yPos)->distanceFromStart;
     int biggestDifference = 0;
     Direction cellToBreak = UNDEFINED;
-    const static double breakThreshold = tomDeadEndBreakThreshold;
+    const double breakThreshold = tomDeadEndBreakThreshold;
         
     // If cell to the North is valid and explored
     if (isValidExploredTile(xPos, yPos, NORTH)) {
@@ -495,26 +492,22 @@ bool Algo::isValidExploredTile(int x, int y, Direction direction) {
 
 void Algo::initializeMaze() {
 
-    m_maze.clear(); // In case the calling code called generate twice.
-                    // We want to clear the vector, to not push twice
-                    // the maze.
+    // Assigning, rather than clearing and pushing, both handles the calling
+    // code calling generate twice and reuses the memory of the last maze
+    TomMazeGenTile tile;
+    tile.row = 0;
+    tile.column = 0;
+    tile.walls = getBit(NORTH) | getBit(EAST) | getBit(SOUTH) | getBit(WEST);
+    tile.isCenter = false;
+    tile.explored = false;
+    tile.distanceFromStart = -1;
+    m_maze.assign(m_width * m_height, tile);
     
     for (int x = 0; x < m_width; x++) {
-        std::vector<TomMazeGenTile> column;
         for (int y = 0; y < m_height; y++) {
-            TomMazeGenTile tile;
-            tile.row = y;
-            tile.column = x;
-            tile.walls[NORTH] = true;
-            tile.walls[EAST]  = true;
-            tile.walls[SOUTH] = true;
-            tile.walls[WEST]  = true;
-            tile.isCenter = false;
-            tile.explored = false;
-            tile.distanceFromStart = -1;
-            column.push_back(tile);
+            getTile(x, y)->row = y;
+            getTile(x, y)->column = x;
         }
-        m_maze.push_back(column);
     }
     
     makeCenter();
@@ -551,26 +544,33 @@ void Algo::makeCenter(){
 
 void Algo::setWall(int x, int y, Direction direction, bool value) {
 
+    Direction opposite = UNDEFINED;
     switch (direction) {
         case NORTH:
-            getTile(x, y)->walls[NORTH] = value;
-            getTile(x, y, NORTH)->walls[SOUTH] = value;
+            opposite = SOUTH;
             break;
         case SOUTH:
-            getTile(x, y)->walls[SOUTH] = value;
-            getTile(x, y, SOUTH)->walls[NORTH] = value;
+            opposite = NORTH;
             break;
         case EAST:
-            getTile(x, y)->walls[EAST] = value;
-            getTile(x, y, EAST)->walls[WEST] = value;
+            opposite = WEST;
             break;
         case WEST:
-            getTile(x, y)->walls[WEST] = value;
-            getTile(x, y, WEST)->walls[EAST] = value;
+            opposite = EAST;
             break;
         case UNDEFINED:
             std::cout << "This should never happen in " << __FILE__ << ", line: " << __LINE__ << std::endl;
-            break;
+            return;
+    }
+    
+    TomMazeGenTile* tiles[2] = {getTile(x, y), getTile(x, y, direction)};
+    unsigned char bits[2] = {getBit(direction), getBit(opposite)};
+    for (int i = 0; i < 2; i++) {
+        if (value) {
+            tiles[i]->walls |= bits[i];
+        } else {
+            tiles[i]->walls &= ~bits[i];
+        }
     }
 }
 
@@ -580,5 +580,13 @@ Algo::TomMazeGenTile* Algo::getTile(int x, int y, Direction direction){
     if (direction == SOUTH) { y--; }
     if (direction == WEST)  { x--; }
     
-    return &m_maze.at(x).at(y);
+    return &m_maze.at(x * m_height + y);
+}
+
+bool Algo::TomMazeGenTile::isWall(Direction direction) const {
+    return (walls & getBit(direction)) != 0;
+}
+
+unsigned char Algo::getBit(Direction direction) {
+    return direction == UNDEFINED ? 0 : 1 << direction;
 }
@@ -1,8 +1,6 @@
 #pragma once
 
-#include <map>
 #include <vector>
-#include <stack>
 
 #include "Interface.h"
 
@@ -46,11 +44,16 @@ private:
         // whether the tile is located in the middle or not
 	    bool isCenter;
         
-        // a map of the wall values.  Keys are NORTH, SOUTH, EAST, WEST.
-        // False for no wall, true for the presence of a wall
-    	std::map<Direction, bool> walls;
+        // a bitmask of the wall values, with one bit per direction (see
+        // getBit). Set for the presence of a wall, clear for no wall
+        unsigned char walls;
+
+        bool isWall(Direction direction) const;
     };
 
+    // The bit of a tile's walls that corresponds to the direction
+    static unsigned char getBit(Direction direction);
+
     // generate a maze, but do not return it
     void generateMaze(int mazeWidth, int mazeHeight);
     
@@ -68,7 +71,11 @@ private:
     
     // Determines which way the algorithm should procede.  This takes into account the
     // configuration values and determine whether or not the algorithm should turn or not
-    Direction getDirectionToMove(float moveConst, std::map<Direction, bool> choices);
+    // The choices are indexed by direction, and at least one must be true
+    Direction getDirectionToMove(float moveConst, const bool choices[4]);
+
+    // A uniformly random direction, other than UNDEFINED
+    Direction getRandomDirection();
     
     //Initialize a maze with walls in every location.  Mark center as exlpored
     // and set the special center flag so the maze generation algorithm will not
@@ -107,18 +114,23 @@ private:
     // that is touching the center of tiles, and breaks that wall.
     void pathIntoCenter();
     
-    // Get a pointer to the tile at location x and y from the vector of vectors
+    // Get a pointer to the tile at location x and y from the vector
     // If the direction is specified, it will get the tile in that direction from
     // tile x, y
     // If a direction is supplied, the method will return the cell to the NORTH, EAST, SOUTH, or
     // WEST of cell x, y
     TomMazeGenTile* getTile(int x, int y, Direction direction = UNDEFINED);
     
-    // Vector of vectors which is the representation of the maze
-    std::vector<std::vector<TomMazeGenTile> > m_maze;
+    // The representation of the maze, in column-major order. It (like the
+    // stack and queue below) is reused when the algorithm generates
+    // several mazes, so that its memory is only allocated once.
+    std::vector<TomMazeGenTile> m_maze;
     
     // Stack for the depth first search
-    std::stack<TomMazeGenTile*> m_stack;
+    std::vector<TomMazeGenTile*> m_stack;
+
+    // Queue for the breadth first search
+    std::vector<TomMazeGenTile*> m_queue;
     
     // Width of the maze
     int m_width;
@@ -1,25 +1,29 @@
 #include "Interface.h"
 
-#include <cstdlib>
 #include <iostream>
 
-Interface::Interface(
-    std::vector<std::vector<std::map<char, bool> > >* maze,
-    bool* success) :
-    m_maze(maze),
+Interface::Interface(int width, int height, unsigned int seed, bool* success) :
+    m_width(width),
+    m_height(height),
+    m_packedWalls((width * height + 1) / 2, 0),
+    m_generator(seed),
     m_success(success) {
 }
 
 int Interface::getWidth() {
-    return m_maze->size();
+    return m_width;
 }
 
 int Interface::getHeight() {
-    return m_maze->at(0).size();
+    return m_height;
 }
 
 double Interface::getRandomFloat() {
-    return static_cast<double>(rand()) / static_cast<double>(RAND_MAX);
+    // Each interface has its own generator (rather than sharing rand()), so
+    // that mazes can be generated on several threads at once, and so that a
+    // seed always produces the same maze
+    return static_cast<double>(m_generator()) /
+           static_cast<double>(m_generator.max());
 }
 
 void Interface::setWall(int x, int y, char direction, bool wallExists) {
@@ -45,33 +49,73 @@ void Interface::setWall(int x, int y, char direction, bool wallExists) {
     }
 
     // Set the wall value
-    m_maze->at(x).at(y).at(direction) = wallExists;
+    setBit(x, y, direction, wallExists);
 
     // Set the opposing wall value
     switch (direction) {
         case 'n': {
             if (y < getHeight() - 1) {
-                m_maze->at(x).at(y + 1).at('s') = wallExists;
+                setBit(x, y + 1, 's', wallExists);
             }
             break;
         }
         case 'e': {
             if (x < getWidth() - 1) {
-                m_maze->at(x + 1).at(y).at('w') = wallExists;
+                setBit(x + 1, y, 'w', wallExists);
             }
             break;
         }
         case 's': {
             if (0 < y) {
-                m_maze->at(x).at(y - 1).at('n') = wallExists;
+                setBit(x, y - 1, 'n', wallExists);
             }
             break;
         }
         case 'w': {
             if (0 < x) {
-                m_maze->at(x - 1).at(y).at('e') = wallExists;
+                setBit(x - 1, y, 'e', wallExists);
             }
             break;
         }
     }
 }
+
+void Interface::reset(unsigned int seed) {
+    m_packedWalls.assign(m_packedWalls.size(), 0);
+    m_generator.seed(seed);
+}
+
+const std::vector<unsigned char>& Interface::getPackedWalls() const {
+    return m_packedWalls;
+}
+
+bool Interface::isWall(int x, int y, char direction) const {
+    int index = y * m_width + x;
+    int shift = 4 * (index % 2);
+    return ((m_packedWalls.at(index / 2) >> shift) & getBit(direction)) != 0;
+}
+
+unsigned char Interface::getBit(char direction) {
+    switch (direction) {
+        case 'n':
+            return 1;
+        case 'e':
+            return 2;
+        case 's':
+            return 4;
+        case 'w':
+            return 8;
+    }
+    return 0;
+}
+
+void Interface::setBit(int x, int y, char direction, bool value) {
+    int index = y * m_width + x;
+    unsigned char bit = getBit(direction) << (4 * (index % 2));
+    if (value) {
+        m_packedWalls.at(index / 2) |= bit;
+    }
+    else {
+        m_packedWalls.at(index / 2) &= ~bit;
+    }
+}
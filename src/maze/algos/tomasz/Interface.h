@@ -1,22 +1,36 @@
 #pragma once
 
-#include <map>
+#include <random>
 #include <vector>
 
 class Interface {
 
 public:
-    Interface(
-        std::vector<std::vector<std::map<char, bool> > >* maze,
-        bool* success);
+    Interface(int width, int height, unsigned int seed, bool* success);
 
     int getWidth();
     int getHeight();
     double getRandomFloat();
     void setWall(int x, int y, char direction, bool wallExists);
 
+    // Clears all of the walls and reseeds the random number generator, so
+    // that one interface can be reused for many mazes of the same size
+    void reset(unsigned int seed);
+
+    // The walls of each tile, as four bits in the order north, east, south,
+    // west (from least to most significant), with tiles in row-major order
+    // from the bottom left, two to a byte, low nibble first
+    const std::vector<unsigned char>& getPackedWalls() const;
+    bool isWall(int x, int y, char direction) const;
+
 private:
-    std::vector<std::vector<std::map<char, bool> > >* m_maze;
+    int m_width;
+    int m_height;
+    std::vector<unsigned char> m_packedWalls;
+    std::mt19937 m_generator;
     bool* m_success;
 
+    static unsigned char getBit(char direction);
+    void setBit(int x, int y, char direction, bool value);
+
 };
@@ -2,15 +2,147 @@
 #include "Interface.h"
 #include "Printer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+// The number of consecutive seeds that a thread generates at a time, and
+// writes out together
+static const int SEEDS_PER_CHUNK = 256;
+
+// Generates the mazes for seeds [firstSeed, firstSeed + count) on every core,
+// and writes their records (see Printer::appendRecord) to the file, in order
+static bool generateBulk(
+        int width,
+        int height,
+        unsigned int firstSeed,
+        long long count,
+        FILE* file) {
+
+    long long numChunks = (count + SEEDS_PER_CHUNK - 1) / SEEDS_PER_CHUNK;
+    std::atomic<long long> nextChunk(0);
+    std::mutex mutex;
+    std::condition_variable written;
+    long long nextChunkToWrite = 0;
+    bool success = true;
+
+    auto work = [&]() {
+        // Each thread reuses one interface, algorithm and buffer for all of
+        // its mazes, so the only allocations happen for the first chunk
+        bool threadSuccess = true;
+        Interface interface(width, height, firstSeed, &threadSuccess);
+        Algo algo;
+        std::string records;
+        while (true) {
+            long long chunk = nextChunk.fetch_add(1);
+            if (numChunks <= chunk) {
+                break;
+            }
+            records.clear();
+            long long first = chunk * SEEDS_PER_CHUNK;
+            long long last = std::min(first + SEEDS_PER_CHUNK, count);
+            for (long long i = first; i < last; i += 1) {
+                unsigned int seed = firstSeed + static_cast<unsigned int>(i);
+                interface.reset(seed);
+                algo.generate(&interface);
+                Printer::appendRecord(&interface, seed, &records);
+            }
+
+            // Wait for the preceding chunks, so the records are in seed order
+            std::unique_lock<std::mutex> lock(mutex);
+            written.wait(lock, [&]() { return nextChunkToWrite == chunk; });
+            if (fwrite(records.data(), 1, records.size(), file) != records.size()) {
+                success = false;
+            }
+            if (!threadSuccess) {
+                success = false;
+            }
+            nextChunkToWrite += 1;
+            written.notify_all();
+        }
+    };
+
+    int numThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; i += 1) {
+        threads.push_back(std::thread(work));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return success && fflush(file) == 0;
+}
 
 int main(int argc, char* argv[]) {
 
+    // Bulk mode writes a binary record per seed instead of printing a maze
+    if (1 < argc && strcmp(argv[1], "--bulk") == 0) {
+        if (argc < 6 || 7 < argc) {
+            std::cout << "Usage: a.out --bulk <WIDTH> <HEIGHT> <FIRST_SEED> <COUNT> [<OUTPUT_FILE>]"
+                      << std::endl;
+            return 1;
+        }
+        int width = atoi(argv[2]);
+        int height = atoi(argv[3]);
+        long long firstSeed = atoll(argv[4]);
+        long long count = atoll(argv[5]);
+        if (width <= 0 || height <= 0 || 65535 < width || 65535 < height) {
+            std::cout << "Error: <WIDTH> and <HEIGHT> must be integers from 1 to 65535"
+                      << std::endl;
+            return 1;
+        }
+        if (firstSeed < 0 || count <= 0 || 4294967296LL < firstSeed + count) {
+            std::cout << "Error: <FIRST_SEED> and <COUNT> must be non-negative and positive "
+                      << "integers whose seeds fit in 32 bits"
+                      << std::endl;
+            return 1;
+        }
+        FILE* file = argc == 7 ? fopen(argv[6], "wb") : stdout;
+        if (file == nullptr) {
+            std::cout << "Error: unable to open \"" << argv[6] << "\"" << std::endl;
+            return 1;
+        }
+        bool success = generateBulk(
+            width, height, static_cast<unsigned int>(firstSeed), count, file);
+        if (file != stdout && fclose(file) != 0) {
+            success = false;
+        }
+        return success ? 0 : 1;
+    }
+
+    // Pull out the --binary flag, wherever it is
+    bool binary = false;
+    int numArgs = 0;
+    for (int i = 0; i < argc; i += 1) {
+        if (0 < i && strcmp(argv[i], "--binary") == 0) {
+            binary = true;
+        }
+        else {
+            argv[numArgs] = argv[i];
+            numArgs += 1;
+        }
+    }
+    argc = numArgs;
+
     // Print the usage
     if (argc < 3 || 4 < argc) {
-        std::cout << "Usage: a.out <WIDTH> <HEIGHT> [<SEED>]"
+        std::cout << "Usage: a.out <WIDTH> <HEIGHT> [<SEED>] [--binary]"
+                  << std::endl;
+        std::cout << "       a.out --bulk <WIDTH> <HEIGHT> <FIRST_SEED> <COUNT> [<OUTPUT_FILE>]"
                   << std::endl;
         return 1;
     }
@@ -35,33 +167,27 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    // Seed rand()
-    srand(seed);
-
-    // Generate an empty maze
-    std::vector<std::vector<std::map<char, bool> > > maze;
-    for (int i = 0; i < width; i += 1) {
-        std::vector<std::map<char, bool> > column;
-        for (int j = 0; j < height; j += 1) {
-            std::map<char, bool> cell;
-            cell['n'] = false;
-            cell['e'] = false;
-            cell['s'] = false;
-            cell['w'] = false;
-            column.push_back(cell);
-        }
-        maze.push_back(column);
-    }
-
     bool success = true;
 
-    Interface interface(&maze, &success);
+    Interface interface(width, height, seed, &success);
     Algo().generate(&interface);
 
     if (!success) {
         return 1;
     }
 
-    Printer::print(&maze);
+    // The binary form is a single record, as in bulk mode
+    if (binary) {
+        std::string record;
+        Printer::appendRecord(&interface, seed, &record);
+#ifdef _WIN32
+        _setmode(_fileno(stderr), _O_BINARY);
+#endif
+        fwrite(record.data(), 1, record.size(), stderr);
+        fflush(stderr);
+        return 0;
+    }
+
+    Printer::print(&interface);
     return 0;
 }
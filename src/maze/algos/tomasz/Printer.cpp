@@ -1,10 +1,8 @@
 #include "Printer.h"
 
 #include <iostream>
-#include <string>
 
-void Printer::print(
-        std::vector<std::vector<std::map<char, bool> > >* maze) {
+void Printer::print(Interface* maze) {
 
     // The characters to use in the file
     char post = '+';
@@ -12,59 +10,56 @@ void Printer::print(
     char vertical = '|';
     char horizontal = '-';
 
-    // A blank line, and a list of all lines to be written
-    std::string blankLine(4 * maze->size() + 1, space);
-    std::vector<std::string> upsideDownLines;
-    upsideDownLines.push_back(blankLine);
-
-    // For all tiles in the maze
-    for (int i = 0; i < maze->size(); i += 1) {
-        for (int j = 0; j < maze->at(i).size(); j += 1) {
-
-            // Insert more lines if necessary
-            if (upsideDownLines.size() <= 2 * j + 1) {
-                upsideDownLines.push_back(blankLine);
-                upsideDownLines.push_back(blankLine);
-            }
-
-            // Insert posts at the boundaries
-            int left  = 4 * (i + 0);
-            int right = 4 * (i + 1);
-            int up    = 2 * (j + 1);
-            int down  = 2 * (j + 0);
-            upsideDownLines.at(down).at(left)  = post;
-            upsideDownLines.at(down).at(right) = post;
-            upsideDownLines.at(up).at(left)    = post;
-            upsideDownLines.at(up).at(right)   = post;
-
-            // Insert walls if they exist
-            if (maze->at(i).at(j).at('n')) {
-                for (int k = 0; k < 3; k += 1) {
-                    upsideDownLines.at(up).at(left + 1 + k) = horizontal;
-                }
+    // The lines are written from the top of the maze down, reusing a single
+    // line rather than building the whole file in memory. A wall shared by
+    // two tiles is drawn if either of the tiles has it.
+    int width = maze->getWidth();
+    int height = maze->getHeight();
+    std::string line(4 * width + 1, space);
+    for (int y = height; 0 <= y; y -= 1) {
+        for (int x = 0; x < width; x += 1) {
+            bool isWall =
+                (y < height && maze->isWall(x, y, 's')) ||
+                (0 < y && maze->isWall(x, y - 1, 'n'));
+            line[4 * x] = post;
+            for (int k = 0; k < 3; k += 1) {
+                line[4 * x + 1 + k] = isWall ? horizontal : space;
             }
-            if (maze->at(i).at(j).at('s')) {
+        }
+        line[4 * width] = post;
+        std::cerr << line << '\n';
+        if (y == 0) {
+            break;
+        }
+        for (int x = 0; x <= width; x += 1) {
+            bool isWall =
+                (x < width && maze->isWall(x, y - 1, 'w')) ||
+                (0 < x && maze->isWall(x - 1, y - 1, 'e'));
+            line[4 * x] = isWall ? vertical : space;
+            if (x < width) {
                 for (int k = 0; k < 3; k += 1) {
-                    upsideDownLines.at(down).at(left + 1 + k) = horizontal;
+                    line[4 * x + 1 + k] = space;
                 }
             }
-            if (maze->at(i).at(j).at('e')) {
-                upsideDownLines.at(down + 1).at(right) = vertical;
-            }
-            if (maze->at(i).at(j).at('w')) {
-                upsideDownLines.at(down + 1).at(left) = vertical;
-            }
         }
+        std::cerr << line << '\n';
     }
+    std::cerr << std::flush;
+}
 
-    // Flip the lines so that they're right side up
-    std::vector<std::string> rightSideUpLines;
-    for (int i = upsideDownLines.size() - 1; i >= 0; i -= 1) {
-        rightSideUpLines.push_back(upsideDownLines.at(i));
+void Printer::appendRecord(Interface* maze, unsigned int seed, std::string* records) {
+    unsigned int width = maze->getWidth();
+    unsigned int height = maze->getHeight();
+    records->append("MMSW");
+    for (int i = 0; i < 4; i += 1) {
+        records->push_back(static_cast<char>(seed >> (8 * i)));
     }
-
-    // Print the lines to stderr
-    for (int i = 0; i < rightSideUpLines.size(); i += 1) {
-        std::cerr << rightSideUpLines.at(i) << std::endl;
+    for (int i = 0; i < 2; i += 1) {
+        records->push_back(static_cast<char>(width >> (8 * i)));
+    }
+    for (int i = 0; i < 2; i += 1) {
+        records->push_back(static_cast<char>(height >> (8 * i)));
     }
+    const std::vector<unsigned char>& walls = maze->getPackedWalls();
+    records->append(reinterpret_cast<const char*>(walls.data()), walls.size());
 }
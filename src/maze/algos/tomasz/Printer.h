@@ -1,11 +1,22 @@
 #pragma once
 
-#include <map>
-#include <vector>
+#include <string>
+
+#include "Interface.h"
 
 class Printer {
 
 public:
-    static void print(std::vector<std::vector<std::map<char, bool> > >* maze);
+    // Prints the maze as text (in the map format) to stderr
+    static void print(Interface* maze);
+
+    // Appends a binary record of the maze to the records:
+    //
+    //   bytes 0-3   the magic "MMSW"
+    //   bytes 4-7   the seed, little-endian
+    //   bytes 8-9   the width, little-endian
+    //   bytes 10-11 the height, little-endian
+    //   bytes 12-   the packed walls (see Interface::getPackedWalls)
+    static void appendRecord(Interface* maze, unsigned int seed, std::string* records);
 
 };
@@ -3,14 +3,29 @@
 #include "Printer.h"
 
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <iostream>
 
 int main(int argc, char* argv[]) {
 
+    // Pull out the --binary flag, wherever it is
+    bool binary = false;
+    int numArgs = 0;
+    for (int i = 0; i < argc; i += 1) {
+        if (0 < i && strcmp(argv[i], "--binary") == 0) {
+            binary = true;
+        }
+        else {
+            argv[numArgs] = argv[i];
+            numArgs += 1;
+        }
+    }
+    argc = numArgs;
+
     // Print the usage
     if (argc < 3 || 4 < argc) {
-        std::cout << "Usage: a.out <WIDTH> <HEIGHT> [<SEED>]"
+        std::cout << "Usage: a.out <WIDTH> <HEIGHT> [<SEED>] [--binary]"
                   << std::endl;
         return 1;
     }
@@ -62,6 +77,13 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    Printer::print(&maze);
+    if (binary) {
+        if (!Printer::printBinary(&maze, seed)) {
+            return 1;
+        }
+    }
+    else {
+        Printer::print(&maze);
+    }
     return 0;
 }
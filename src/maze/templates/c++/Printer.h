@@ -8,4 +8,15 @@ class Printer {
 public:
     static void print(std::vector<std::vector<std::map<char, bool> > >* maze);
 
+    // Prints the maze to stderr as a compact binary record instead, which is
+    // much faster for the simulator to read for large mazes: the bytes "MMSW",
+    // the seed (4 bytes), the width and the height (2 bytes each, all little
+    // endian), and then 4 bits per tile (n = 1, e = 2, s = 4, w = 8), row by
+    // row from the bottom left, two tiles per byte with the first in the low
+    // bits. The width and the height can't be more than 65535; returns false,
+    // and prints nothing, if either is.
+    static bool printBinary(
+        std::vector<std::vector<std::map<char, bool> > >* maze,
+        unsigned int seed);
+
 };
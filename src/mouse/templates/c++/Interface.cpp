@@ -146,6 +146,16 @@ void Interface::resetPosition() {
     READ();
 }
 
+int Interface::waitForRun(int* mazeWidth, int* mazeHeight) {
+    PRINT("waitForRun");
+    READ();
+    *mazeWidth = atoi(input.c_str());
+    std::cin >> input;
+    *mazeHeight = atoi(input.c_str());
+    std::cin >> input;
+    return atoi(input.c_str());
+}
+
 bool Interface::inputButtonPressed(int inputButton) {
     PRINT("inputButtonPressed", inputButton);
     READ_AND_RETURN_BOOL();
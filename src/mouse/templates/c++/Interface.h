@@ -39,6 +39,11 @@ public:
     void delay(int milliseconds); // # of milliseconds of sim time (adjusted based on sim speed)
     void resetPosition(); // Reset position of the mouse
 
+    // Persistent algos: tells the simulator that this run is done, and waits
+    // for the next one rather than exiting; returns the seed of the next run
+    // and sets the size of its maze
+    int waitForRun(int* mazeWidth, int* mazeHeight);
+
     // Input buttons
     bool inputButtonPressed(int inputButton);
     void acknowledgeInputButtonPressed(int inputButton);
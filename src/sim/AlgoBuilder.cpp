@@ -0,0 +1,199 @@
+#include "AlgoBuilder.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QEventLoop>
+#include <QProcess>
+#include <QSaveFile>
+#include <QThread>
+#include <QVector>
+
+#include <algorithm>
+#include <functional>
+
+#include "ParallelUtilities.h"
+#include "ProcessUtilities.h"
+#include "SettingsMazeAlgos.h"
+#include "SettingsMouseAlgos.h"
+#include "SimUtilities.h"
+
+namespace mms {
+
+quint64 AlgoBuilder::getSourceHash(
+        const QString& dirPath,
+        const QString& buildCommand) {
+    quint64 hash = SimUtilities::hashDirectory(dirPath);
+    return SimUtilities::hashBytes(buildCommand.toUtf8() + '\0', hash);
+}
+
+bool AlgoBuilder::isMazeAlgoBuilt(const QString& name) {
+    return SettingsMazeAlgos::getBuiltHash(name) == toHex(getSourceHash(
+        SettingsMazeAlgos::getDirPath(name),
+        SettingsMazeAlgos::getBuildCommand(name)));
+}
+
+bool AlgoBuilder::isMouseAlgoBuilt(const QString& name) {
+    return SettingsMouseAlgos::getBuiltHash(name) == toHex(getSourceHash(
+        SettingsMouseAlgos::getDirPath(name),
+        SettingsMouseAlgos::getBuildCommand(name)));
+}
+
+void AlgoBuilder::setMazeAlgoBuilt(const QString& name) {
+    SettingsMazeAlgos::setBuiltHash(name, toHex(getSourceHash(
+        SettingsMazeAlgos::getDirPath(name),
+        SettingsMazeAlgos::getBuildCommand(name))));
+}
+
+void AlgoBuilder::setMouseAlgoBuilt(const QString& name) {
+    SettingsMouseAlgos::setBuiltHash(name, toHex(getSourceHash(
+        SettingsMouseAlgos::getDirPath(name),
+        SettingsMouseAlgos::getBuildCommand(name))));
+}
+
+int AlgoBuilder::buildMouseAlgos(
+        const QStringList& algoNames,
+        const QString& logDirPath) {
+
+    // An algorithm can only be built once at a time
+    QStringList names = algoNames;
+    names.removeDuplicates();
+
+    // The settings are only read and written on this thread
+    QStringList dirPaths;
+    QStringList buildCommands;
+    QStringList builtHashes;
+    for (const QString& name : names) {
+        if (!SettingsMouseAlgos::names().contains(name)) {
+            qWarning().noquote().nospace()
+                << "Unknown mouse algorithm \"" << name << "\".";
+            return -1;
+        }
+        dirPaths.append(SettingsMouseAlgos::getDirPath(name));
+        buildCommands.append(SettingsMouseAlgos::getBuildCommand(name));
+        builtHashes.append(SettingsMouseAlgos::getBuiltHash(name));
+    }
+
+    // Hashing reads every file of every directory, so it's spread across the
+    // cores. Each index is only ever written by the thread that claimed it.
+    QVector<quint64> hashes(names.size());
+    ParallelUtilities::forEachIndex(names.size(), [&](int i){
+        hashes[i] = getSourceHash(dirPaths.at(i), buildCommands.at(i));
+    });
+    QVector<int> stale;
+    for (int i = 0; i < names.size(); i += 1) {
+        if (buildCommands.at(i).isEmpty() || toHex(hashes.at(i)) == builtHashes.at(i)) {
+            qInfo().noquote().nospace() << names.at(i) << " is up to date.";
+        }
+        else {
+            stale.append(i);
+        }
+    }
+    if (!stale.isEmpty() && !logDirPath.isEmpty() && !QDir().mkpath(logDirPath)) {
+        qWarning().noquote().nospace()
+            << "Unable to create the build log directory \"" << logDirPath << "\".";
+        return -1;
+    }
+
+    // Each build gets its own process, with its own output, and each free
+    // slot takes the next build in the queue
+    QVector<QByteArray> outputs(names.size());
+    QVector<bool> succeeded(names.size(), false);
+    int numSlots = std::max(1, QThread::idealThreadCount());
+    int next = 0;
+    int numRunning = 0;
+    int numFinished = 0;
+    QEventLoop loop;
+    std::function<void()> startBuilds;
+    auto finishBuild = [&](int i) {
+        numFinished += 1;
+        if (succeeded.at(i)) {
+            qInfo().noquote().nospace()
+                << "[" << numFinished << "/" << stale.size() << "] Built "
+                << names.at(i) << ".";
+        }
+        else {
+            qWarning().noquote().nospace()
+                << "[" << numFinished << "/" << stale.size() << "] Build of "
+                << names.at(i) << " failed:\n" << QString::fromUtf8(outputs.at(i));
+        }
+        if (!logDirPath.isEmpty()) {
+            QSaveFile file(QDir(logDirPath).filePath(names.at(i) + ".log"));
+            if (
+                !file.open(QIODevice::WriteOnly) ||
+                file.write(outputs.at(i)) != outputs.at(i).size() ||
+                !file.commit()
+            ) {
+                qWarning().noquote().nospace()
+                    << "Unable to write the build log of " << names.at(i) << ".";
+            }
+        }
+    };
+    startBuilds = [&]() {
+        while (numRunning < numSlots && next < stale.size()) {
+            int i = stale.at(next);
+            next += 1;
+            QProcess* process = new QProcess();
+            process->setProcessChannelMode(QProcess::MergedChannels);
+            QObject::connect(
+                process,
+                &QProcess::readyRead,
+                process,
+                [&, i, process](){
+                    outputs[i] += process->readAll();
+                }
+            );
+            QObject::connect(
+                process,
+                static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(
+                    &QProcess::finished
+                ),
+                process,
+                [&, i, process](int exitCode, QProcess::ExitStatus exitStatus){
+                    outputs[i] += process->readAll();
+                    succeeded[i] = exitStatus == QProcess::NormalExit && exitCode == 0;
+                    process->deleteLater();
+                    numRunning -= 1;
+                    finishBuild(i);
+                    startBuilds();
+                }
+            );
+            if (ProcessUtilities::start(buildCommands.at(i), dirPaths.at(i), process)) {
+                numRunning += 1;
+            }
+            else {
+                outputs[i] += "Unable to start \"" + buildCommands.at(i).toUtf8() + "\".\n";
+                delete process;
+                finishBuild(i);
+            }
+        }
+        if (numFinished == stale.size()) {
+            loop.quit();
+        }
+    };
+    startBuilds();
+    if (numFinished < stale.size()) {
+        loop.exec();
+    }
+
+    // The builds wrote to their directories, so those are hashed again
+    QVector<int> built;
+    for (int i : stale) {
+        if (succeeded.at(i)) {
+            built.append(i);
+        }
+    }
+    ParallelUtilities::forEachIndex(built.size(), [&](int j){
+        int i = built.at(j);
+        hashes[i] = getSourceHash(dirPaths.at(i), buildCommands.at(i));
+    });
+    for (int i : built) {
+        SettingsMouseAlgos::setBuiltHash(names.at(i), toHex(hashes.at(i)));
+    }
+    return stale.size() - built.size();
+}
+
+QString AlgoBuilder::toHex(quint64 hash) {
+    return QString("%1").arg(hash, 16, 16, QChar('0'));
+}
+
+} // namespace mms
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+namespace mms {
+
+// Skips the builds of algorithms that haven't changed. After each successful
+// build, the hash of the algorithm's directory, including whatever the build
+// wrote to it, and of its build command is kept in the settings, and the
+// algorithm is stale if the hash is different now. Content hashes, unlike
+// modification times, survive checkouts and copies that don't change a file.
+class AlgoBuilder {
+
+public:
+
+    AlgoBuilder() = delete;
+
+    static quint64 getSourceHash(
+        const QString& dirPath,
+        const QString& buildCommand);
+
+    // Whether nothing changed since the last successful build
+    static bool isMazeAlgoBuilt(const QString& name);
+    static bool isMouseAlgoBuilt(const QString& name);
+
+    // Records a successful build
+    static void setMazeAlgoBuilt(const QString& name);
+    static void setMouseAlgoBuilt(const QString& name);
+
+    // Builds the stale mouse algorithms, as many at once as there are cores,
+    // and writes the output of each build, stdout and stderr together, to
+    // "<name>.log" in the log directory, if any. The output of a failed build
+    // is also logged. Returns the number of builds that failed, or -1 if an
+    // algorithm doesn't exist.
+    static int buildMouseAlgos(
+        const QStringList& names,
+        const QString& logDirPath);
+
+private:
+
+    static QString toHex(quint64 hash);
+};
+
+} // namespace mms
@@ -12,6 +12,14 @@ BufferInterface::BufferInterface(
         m_mazeSize(mazeSize),
         m_graphicCpuBuffer(graphicCpuBuffer),
         m_textureCpuBuffer(textureCpuBuffer) {
+
+    // Every triangle of every layer is inserted exactly once, so the buffer
+    // can be allocated up front instead of growing as the tiles are drawn
+    int numTriangles = 0;
+    for (TileGraphicLayer layer : TILE_GRAPHIC_LAYERS()) {
+        numTriangles += getTileGraphicLayerRange(layer).second;
+    }
+    m_graphicCpuBuffer->reserve(numTriangles);
 }
 
 void BufferInterface::initTileGraphicText(
@@ -28,17 +36,59 @@ void BufferInterface::initTileGraphicText(
         borderFraction,
         tileTextAlignment
     );
+
+    // Likewise, each tile gets two triangles per character of text
+    m_textureCpuBuffer->reserve(
+        2 * tileGraphicTextMaxSize.first * tileGraphicTextMaxSize.second *
+        m_mazeSize.first * m_mazeSize.second);
 }
 
-QPair<int, int> BufferInterface::getTileGraphicTextMaxSize() {
+QPair<int, int> BufferInterface::getMazeSize() const {
+    return m_mazeSize;
+}
+
+QPair<int, int> BufferInterface::getTileGraphicTextMaxSize() const {
     return m_tileGraphicTextCache.getTileGraphicTextMaxSize();
 }
 
-void BufferInterface::insertIntoGraphicCpuBuffer(const Polygon& polygon, Color color, double alpha) {
-    QVector<TriangleGraphic> tgs = SimUtilities::polygonToTriangleGraphics(polygon, color, alpha);
-    for (int i = 0; i < tgs.size(); i += 1) {
-        m_graphicCpuBuffer->push_back(tgs.at(i));
+QPair<int, int> BufferInterface::getTileGraphicLayerRange(TileGraphicLayer layer) const {
+    int numTiles = m_mazeSize.first * m_mazeSize.second;
+    int start = 0;
+    for (TileGraphicLayer other : TILE_GRAPHIC_LAYERS()) {
+        if (other == layer) {
+            break;
+        }
+        start += trianglesPerTile(other) * numTiles;
     }
+    return {start, trianglesPerTile(layer) * numTiles};
+}
+
+void BufferInterface::insertIntoGraphicCpuBuffer(
+        const QPair<Coordinate, Coordinate>& rectangle,
+        Color color,
+        double alpha) {
+
+    //   [p2]-------[UR]
+    //    |  t1   /   |
+    //    |     /     |
+    //    |   /   t2  |
+    //   [LL]-------[p4]
+
+    double left = rectangle.first.getX().getMeters();
+    double bottom = rectangle.first.getY().getMeters();
+    double right = rectangle.second.getX().getMeters();
+    double top = rectangle.second.getY().getMeters();
+    RGB rgb = COLOR_TO_RGB().value(color);
+    m_graphicCpuBuffer->push_back({
+        {left, bottom, rgb, alpha},
+        {left, top, rgb, alpha},
+        {right, top, rgb, alpha},
+    });
+    m_graphicCpuBuffer->push_back({
+        {left, bottom, rgb, alpha},
+        {right, top, rgb, alpha},
+        {right, bottom, rgb, alpha},
+    });
 }
 
 void BufferInterface::insertIntoTextureCpuBuffer() {
@@ -137,37 +187,55 @@ void BufferInterface::updateTileGraphicText(int x, int y, int numRows, int numCo
     t2->p3.u = fontImageCharacterPosition.second;
 }
 
-int BufferInterface::trianglesPerTile() {
-    // This value must be predetermined, and was done so as follows:
+int BufferInterface::trianglesPerTile(TileGraphicLayer layer) {
+    // These values must be predetermined, and were done so as follows:
     // Base polygon:      2 (2 triangles x 1 polygon  per tile)
     // Wall polygon:      8 (2 triangles x 4 polygons per tile)
     // Corner polygon:    8 (2 triangles x 4 polygons per tile)
     // Fog polygon:       2 (2 triangles x 1 polygon  per tile)
-    // --------------------
-    // Total             20
-    return 20;
+    switch (layer) {
+        case TileGraphicLayer::BASE:
+            return 2;
+        case TileGraphicLayer::WALLS:
+            return 8;
+        case TileGraphicLayer::CORNERS:
+            return 8;
+        case TileGraphicLayer::FOG:
+            return 2;
+    }
+    return 0;
+}
+
+int BufferInterface::getTileIndex(int x, int y) const {
+    return m_mazeSize.second * x + y;
 }
 
 int BufferInterface::getTileGraphicBaseStartingIndex(int x, int y) {
-    return  0 + trianglesPerTile() * (m_mazeSize.second * x + y);
+    return getTileGraphicLayerRange(TileGraphicLayer::BASE).first +
+        trianglesPerTile(TileGraphicLayer::BASE) * getTileIndex(x, y);
 }
 
 int BufferInterface::getTileGraphicWallStartingIndex(int x, int y, Direction direction) {
-    return  2 + trianglesPerTile() * (m_mazeSize.second * x + y) + (2 * DIRECTIONS().indexOf(direction));
+    return getTileGraphicLayerRange(TileGraphicLayer::WALLS).first +
+        trianglesPerTile(TileGraphicLayer::WALLS) * getTileIndex(x, y) +
+        (2 * DIRECTIONS().indexOf(direction));
 }
 
 int BufferInterface::getTileGraphicCornerStartingIndex(int x, int y, int cornerNumber) {
-    return 10 + trianglesPerTile() * (m_mazeSize.second * x + y) + (2 * cornerNumber);
+    return getTileGraphicLayerRange(TileGraphicLayer::CORNERS).first +
+        trianglesPerTile(TileGraphicLayer::CORNERS) * getTileIndex(x, y) +
+        (2 * cornerNumber);
 }
 
 int BufferInterface::getTileGraphicFogStartingIndex(int x, int y) {
-    return 18 + trianglesPerTile() * (m_mazeSize.second * x + y);
+    return getTileGraphicLayerRange(TileGraphicLayer::FOG).first +
+        trianglesPerTile(TileGraphicLayer::FOG) * getTileIndex(x, y);
 }
 
 int BufferInterface::getTileGraphicTextStartingIndex(int x, int y, int row, int col) {
     QPair<int, int> maxRowsAndCols = getTileGraphicTextMaxSize();
     int triangleTexturesPerTile = 2 * maxRowsAndCols.first * maxRowsAndCols.second;
-    return triangleTexturesPerTile * (m_mazeSize.second * x + y) + 2 * (row * maxRowsAndCols.second + col);
+    return triangleTexturesPerTile * getTileIndex(x, y) + 2 * (row * maxRowsAndCols.second + col);
 }
 
 } // namespace mms
@@ -6,7 +6,7 @@
 
 #include "Color.h"
 #include "Direction.h"
-#include "Polygon.h"
+#include "TileGraphicLayer.h"
 #include "TileGraphicTextCache.h"
 #include "TileTextAlignment.h"
 #include "TriangleGraphic.h"
@@ -23,6 +23,9 @@ public:
         QVector<TriangleGraphic>* graphicCpuBuffer,
         QVector<TriangleTexture>* textureCpuBuffer);
 
+    // Returns the width and height of the maze, in tiles
+    QPair<int, int> getMazeSize() const;
+
     // Initializes and caches all possible tile text positions. We need this
     // extra initialization function since the max size is from the algorithm.
     void initTileGraphicText(
@@ -33,10 +36,19 @@ public:
         TileTextAlignment tileTextAlignment);
 
     // Returns the maximum number of rows and columns of text in a tile graphic
-    QPair<int, int> getTileGraphicTextMaxSize();
-
-    // Fills the graphic cpu buffer and texture cpu buffer
-    void insertIntoGraphicCpuBuffer(const Polygon& polygon, Color color, double alpha);
+    QPair<int, int> getTileGraphicTextMaxSize() const;
+
+    // Returns the starting triangle index and number of triangles of a layer
+    // of the graphic cpu buffer
+    QPair<int, int> getTileGraphicLayerRange(TileGraphicLayer layer) const;
+
+    // Fills the graphic cpu buffer and texture cpu buffer. Note that rectangles
+    // (given by their LL and UR corners) must be inserted layer by layer, in
+    // the order of TILE_GRAPHIC_LAYERS().
+    void insertIntoGraphicCpuBuffer(
+        const QPair<Coordinate, Coordinate>& rectangle,
+        Color color,
+        double alpha);
     void insertIntoTextureCpuBuffer();
 
     // These methods are inexpensive, and may be called many times
@@ -59,7 +71,8 @@ private:
 
     // Retrieve the indices into the graphic cpu buffer,
     // for each specific type of Tile triangle
-    int trianglesPerTile();
+    static int trianglesPerTile(TileGraphicLayer layer);
+    int getTileIndex(int x, int y) const;
     int getTileGraphicBaseStartingIndex(int x, int y);
     int getTileGraphicWallStartingIndex(int x, int y, Direction direction);
     int getTileGraphicCornerStartingIndex(int x, int y, int cornerNumber);
@@ -0,0 +1,159 @@
+#include "CheckpointHistory.h"
+
+#include <algorithm>
+
+#include "Assert.h"
+
+namespace mms {
+
+CheckpointHistory::CheckpointHistory() :
+    m_capacity(KEYFRAME_INTERVAL),
+    m_numSinceKeyframe(0) {
+}
+
+void CheckpointHistory::start(
+        const QString& mouseFile,
+        const Duration& interval,
+        int capacity) {
+    m_mutex.lock();
+    m_mouseFile = mouseFile;
+    m_interval = interval;
+    // At least two keyframes' worth, so that dropping the oldest one always
+    // leaves some checkpoints
+    m_capacity = std::max(capacity, 2 * KEYFRAME_INTERVAL);
+    m_deltas.clear();
+    m_numSinceKeyframe = 0;
+    m_nextCaptureTime = Duration::Seconds(0);
+    m_previousTraversedTileLocations.clear();
+    m_previousTileTextSize = {0, 0};
+    m_previousTileStates.clear();
+    m_mutex.unlock();
+}
+
+void CheckpointHistory::clear() {
+    m_mutex.lock();
+    Duration interval = m_interval;
+    int capacity = m_capacity;
+    m_mutex.unlock();
+    start("", interval, capacity);
+}
+
+QString CheckpointHistory::getMouseFile() const {
+    m_mutex.lock();
+    QString mouseFile = m_mouseFile;
+    m_mutex.unlock();
+    return mouseFile;
+}
+
+bool CheckpointHistory::isDue(const Duration& simTime) const {
+    m_mutex.lock();
+    bool isDue = !(simTime < m_nextCaptureTime);
+    m_mutex.unlock();
+    return isDue;
+}
+
+void CheckpointHistory::capture(
+        const Duration& simTime,
+        const Mouse* mouse,
+        const MouseStats& stats,
+        const MazeView* view) {
+
+    // Read everything before taking the lock, so that the UI thread is never
+    // kept waiting on the copy
+    MouseState mouseState = mouse->getState();
+    QPair<int, int> tileTextSize = view->getTileGraphicTextSize();
+    QVector<TileGraphicState> tileStates = view->getMazeGraphic()->getTileStates();
+
+    m_mutex.lock();
+    Delta delta;
+    delta.isKeyframe = (
+        m_deltas.isEmpty() ||
+        KEYFRAME_INTERVAL <= m_numSinceKeyframe + 1 ||
+        tileTextSize != m_previousTileTextSize ||
+        tileStates.size() != m_previousTileStates.size()
+    );
+    delta.simTime = simTime;
+    delta.mouseState = mouseState;
+    delta.stats = stats;
+    delta.tileTextSize = tileTextSize;
+    if (delta.isKeyframe) {
+        delta.tileStates = tileStates;
+        m_numSinceKeyframe = 0;
+    }
+    else {
+        // Traversed tiles are never untraversed during a run, so only the
+        // new ones need to be kept
+        delta.stats.traversedTileLocations.subtract(m_previousTraversedTileLocations);
+        for (int i = 0; i < tileStates.size(); i += 1) {
+            if (!(tileStates.at(i) == m_previousTileStates.at(i))) {
+                delta.tileIndices.append(i);
+                delta.tileStates.append(tileStates.at(i));
+            }
+        }
+        m_numSinceKeyframe += 1;
+    }
+    m_deltas.append(delta);
+    m_previousTraversedTileLocations = stats.traversedTileLocations;
+    m_previousTileTextSize = tileTextSize;
+    m_previousTileStates = tileStates;
+    m_nextCaptureTime = simTime + m_interval;
+
+    // Drop the oldest keyframe and its deltas, so that the history always
+    // starts with a keyframe
+    if (m_capacity < m_deltas.size()) {
+        m_deltas.removeFirst();
+        while (!m_deltas.isEmpty() && !m_deltas.first().isKeyframe) {
+            m_deltas.removeFirst();
+        }
+    }
+    m_mutex.unlock();
+}
+
+int CheckpointHistory::size() const {
+    m_mutex.lock();
+    int size = m_deltas.size();
+    m_mutex.unlock();
+    return size;
+}
+
+Duration CheckpointHistory::getSimTime(int index) const {
+    m_mutex.lock();
+    ASSERT_LE(0, index);
+    ASSERT_LT(index, m_deltas.size());
+    Duration simTime = m_deltas.at(index).simTime;
+    m_mutex.unlock();
+    return simTime;
+}
+
+Checkpoint CheckpointHistory::get(int index) const {
+    m_mutex.lock();
+    ASSERT_LE(0, index);
+    ASSERT_LT(index, m_deltas.size());
+
+    // Start from the keyframe at or before the index, which there always is,
+    // and apply the deltas after it in order
+    int keyframe = index;
+    while (!m_deltas.at(keyframe).isKeyframe) {
+        keyframe -= 1;
+    }
+    const Delta& last = m_deltas.at(index);
+    Checkpoint checkpoint;
+    checkpoint.simTime = last.simTime;
+    checkpoint.mouseState = last.mouseState;
+    checkpoint.stats = last.stats;
+    checkpoint.stats.traversedTileLocations =
+        m_deltas.at(keyframe).stats.traversedTileLocations;
+    checkpoint.tileTextSize = last.tileTextSize;
+    checkpoint.tileStates = m_deltas.at(keyframe).tileStates;
+    for (int i = keyframe + 1; i <= index; i += 1) {
+        const Delta& delta = m_deltas.at(i);
+        checkpoint.stats.traversedTileLocations.unite(delta.stats.traversedTileLocations);
+        for (int j = 0; j < delta.tileIndices.size(); j += 1) {
+            checkpoint.tileStates[delta.tileIndices.at(j)] = delta.tileStates.at(j);
+        }
+    }
+    m_mutex.unlock();
+    return checkpoint;
+}
+
+} // namespace mms
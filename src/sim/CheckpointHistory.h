@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include "MazeView.h"
+#include "Mouse.h"
+#include "MouseState.h"
+#include "MouseStats.h"
+#include "TileGraphic.h"
+#include "units/Duration.h"
+
+namespace mms {
+
+// A run as it was at some point, enough to show it again: the mouse, its
+// stats, and what the algorithm drew. The view's buffers are redrawn from the
+// tile states rather than kept, since they're many times larger.
+struct Checkpoint {
+    Duration simTime;
+    MouseState mouseState;
+    MouseStats stats;
+    // The rows and columns of tile text, see MazeView::initTileGraphicText()
+    QPair<int, int> tileTextSize;
+    // In the order of the tile graphics of MazeGraphic
+    QVector<TileGraphicState> tileStates;
+};
+
+// Checkpoints of a run, taken at an interval of sim time, from which the view
+// of the run can be rewound. Most checkpoints only keep what changed since
+// the one before: the tiles that were drawn on and the tiles that were newly
+// traversed. Every KEYFRAME_INTERVAL-th keeps everything, so that getting a
+// checkpoint applies a bounded number of deltas. Taking a checkpoint costs a
+// pass over the tiles, and once the history is full the oldest keyframe and
+// its deltas are dropped, so the history can stay on for long runs.
+//
+// Checkpoints are taken from the thread that draws on the view and read from
+// the UI thread, so every method is thread-safe.
+class CheckpointHistory {
+
+public:
+
+    CheckpointHistory();
+
+    // Discards the checkpoints, for a new run of a mouse with the given file
+    void start(const QString& mouseFile, const Duration& interval, int capacity);
+    void clear();
+
+    QString getMouseFile() const;
+
+    // Whether a checkpoint is due at the sim time
+    bool isDue(const Duration& simTime) const;
+
+    // Takes a checkpoint. This reads the view, so it must be called from the
+    // thread that draws on it.
+    void capture(
+        const Duration& simTime,
+        const Mouse* mouse,
+        const MouseStats& stats,
+        const MazeView* view);
+
+    int size() const;
+    Duration getSimTime(int index) const;
+    Checkpoint get(int index) const;
+
+private:
+
+    static const int KEYFRAME_INTERVAL = 32;
+
+    // A checkpoint as kept. The traversed tiles of a delta's stats are only
+    // the newly traversed ones, and its tile states are only those of the
+    // tiles that changed, at the tile indices.
+    struct Delta {
+        bool isKeyframe;
+        Duration simTime;
+        MouseState mouseState;
+        MouseStats stats;
+        QPair<int, int> tileTextSize;
+        QVector<int> tileIndices;
+        QVector<TileGraphicState> tileStates;
+    };
+
+    mutable QMutex m_mutex;
+    QString m_mouseFile;
+    Duration m_interval;
+    int m_capacity;
+    QList<Delta> m_deltas;
+    int m_numSinceKeyframe;
+    Duration m_nextCaptureTime;
+
+    // The latest checkpoint, for the next one to be diffed against
+    QSet<QPair<int, int>> m_previousTraversedTileLocations;
+    QPair<int, int> m_previousTileTextSize;
+    QVector<TileGraphicState> m_previousTileStates;
+};
+
+} // namespace mms
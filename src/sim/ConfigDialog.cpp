@@ -121,6 +121,13 @@ bool ConfigDialog::getComboBoxSelected(const QString& label) {
     return m_comboBoxes[label]->isEnabled();
 }
 
+int ConfigDialog::getSpinBoxValue(const QString& label) {
+    if (!m_spinBoxes.contains(label)) {
+        return 0;
+    }
+    return m_spinBoxes[label]->value();
+}
+
 void ConfigDialog::addLabel(QString text, QGridLayout* layout, int row) {
 	QLabel* label = new QLabel(text);
 	label->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
@@ -137,6 +144,7 @@ void ConfigDialog::appendNumberField(
     if (field.type == ConfigDialogFieldType::INTEGER) {
         QSpinBox* spinBox = new QSpinBox(this);
         m_spinBoxes[field.label] = spinBox;
+        spinBox->setRange(field.spinBoxMinimum, field.spinBoxMaximum);
         spinBox->setValue(field.initialSpinBoxValue.toInt());
         connect(
             spinBox,
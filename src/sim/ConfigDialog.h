@@ -30,6 +30,7 @@ public:
     QString getComboBoxValue(const QString& label);
     QString getLineEditValue(const QString& label);
     bool getComboBoxSelected(const QString& label);
+    int getSpinBoxValue(const QString& label);
 
 private:
 
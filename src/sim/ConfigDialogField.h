@@ -24,6 +24,8 @@ struct ConfigDialogField {
     QVariant initialLineEditValue;
     QVariant initialSpinBoxValue;
     QVariant initialDoubleSpinBoxValue;
+    int spinBoxMinimum = 0;
+    int spinBoxMaximum = 99;
 
     bool allowEmptyLineEditValue = true;
     bool comboBoxSelected = true;
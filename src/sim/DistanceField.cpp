@@ -0,0 +1,377 @@
+#include "DistanceField.h"
+
+#include <QQueue>
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+#include "Assert.h"
+#include "MazeUtilities.h"
+
+namespace mms {
+
+DistanceFieldCosts::DistanceFieldCosts() :
+    straight(1),
+    diagonal(1),
+    turn(0),
+    allowDiagonals(false) {
+}
+
+const int DistanceField::INFINITE_DISTANCE = std::numeric_limits<int>::max();
+
+const int DistanceField::MOVE_DX[NUM_MOVES] = {0, 1, 1, 1, 0, -1, -1, -1};
+const int DistanceField::MOVE_DY[NUM_MOVES] = {1, 1, 0, -1, -1, -1, 0, 1};
+const Direction DistanceField::MOVE_DIRECTION[NUM_MOVES / 2] = {
+    Direction::NORTH,
+    Direction::EAST,
+    Direction::SOUTH,
+    Direction::WEST,
+};
+
+DistanceField::DistanceField(
+        const WallGridView& walls,
+        const QVector<QPair<int, int>>& goals,
+        const DistanceFieldCosts& costs) :
+        m_walls(walls),
+        m_goals(goals),
+        m_costs(costs) {
+    ASSERT_LT(0, m_costs.straight);
+    ASSERT_LT(0, m_costs.diagonal);
+    ASSERT_LE(0, m_costs.turn);
+    m_numHeadings = (
+        m_costs.turn == 0 ? 1 :
+        m_costs.allowDiagonals ? 8 : 4
+    );
+    computeAll();
+}
+
+int DistanceField::getWidth() const {
+    return m_walls.getWidth();
+}
+
+int DistanceField::getHeight() const {
+    return m_walls.getHeight();
+}
+
+const WallGridView& DistanceField::getWalls() const {
+    return m_walls;
+}
+
+const QVector<QPair<int, int>>& DistanceField::getGoals() const {
+    return m_goals;
+}
+
+int DistanceField::getDistance(int x, int y) const {
+    ASSERT_TR(m_walls.withinGrid(x, y));
+    return m_distances.at(y * getWidth() + x);
+}
+
+const QVector<int>& DistanceField::getDistances() const {
+    return m_distances;
+}
+
+int DistanceField::getMaximumDistance() const {
+    int max = 0;
+    for (int distance : m_distances) {
+        max = std::max(max, distance);
+    }
+    return max;
+}
+
+void DistanceField::setWall(int x, int y, Direction direction, bool isWall) {
+    ASSERT_TR(m_walls.withinGrid(x, y));
+    QPair<int, int> neighbor =
+        MazeUtilities::positionAfterMovingForward({x, y}, direction);
+    bool hasNeighbor = m_walls.withinGrid(neighbor.first, neighbor.second);
+    Direction opposite = DIRECTION_OPPOSITE().value(direction);
+    if (
+        m_walls.isWall(x, y, direction) == isWall &&
+        (!hasNeighbor || m_walls.isWall(neighbor.first, neighbor.second, opposite) == isWall)
+    ) {
+        return;
+    }
+    m_walls.setWall(x, y, direction, isWall);
+    if (hasNeighbor) {
+        m_walls.setWall(neighbor.first, neighbor.second, opposite, isWall);
+    }
+
+    // Only moves that start and end within one tile of the edge (including
+    // diagonal moves past either of its posts) can be affected
+    int minX = std::min(x, neighbor.first) - 1;
+    int minY = std::min(y, neighbor.second) - 1;
+    int maxX = std::max(x, neighbor.first) + 1;
+    int maxY = std::max(y, neighbor.second) + 1;
+    if (isWall) {
+        removeMoves(minX, minY, maxX, maxY);
+    }
+    else {
+        addMoves(minX, minY, maxX, maxY);
+    }
+    updateDistances();
+}
+
+void DistanceField::setGoals(const QVector<QPair<int, int>>& goals) {
+    m_goals = goals;
+    computeAll();
+}
+
+void DistanceField::computeAll() {
+
+    int numStates = getWidth() * getHeight() * m_numHeadings;
+    m_stateDistances.fill(INFINITE_DISTANCE, numStates);
+    m_parents.fill(-1, numStates);
+
+    // Every heading of every goal tile is a source
+    QVector<int> sources;
+    for (QPair<int, int> goal : m_goals) {
+        ASSERT_TR(m_walls.withinGrid(goal.first, goal.second));
+        int tile = goal.second * getWidth() + goal.first;
+        for (int heading = 0; heading < m_numHeadings; heading += 1) {
+            int state = tile * m_numHeadings + heading;
+            m_stateDistances[state] = 0;
+            sources.append(state);
+        }
+    }
+
+    // With no headings and only straight moves, every move costs the same,
+    // so a plain BFS over the tiles suffices
+    if (m_numHeadings == 1 && !m_costs.allowDiagonals) {
+        QQueue<int> discovered;
+        for (int source : sources) {
+            discovered.enqueue(source);
+        }
+        while (!discovered.empty()) {
+            int tile = discovered.dequeue();
+            int x = tile % getWidth();
+            int y = tile / getWidth();
+            for (int move = 0; move < NUM_MOVES; move += 2) {
+                if (!canMove(x, y, move)) {
+                    continue;
+                }
+                int next = (y + MOVE_DY[move]) * getWidth() + x + MOVE_DX[move];
+                if (m_stateDistances.at(next) == INFINITE_DISTANCE) {
+                    m_stateDistances[next] = m_stateDistances.at(tile) + m_costs.straight;
+                    m_parents[next] = tile;
+                    discovered.enqueue(next);
+                }
+            }
+        }
+    }
+    else {
+        Queue queue;
+        for (int source : sources) {
+            queue.push({0, source});
+        }
+        search(&queue);
+    }
+
+    updateDistances();
+}
+
+void DistanceField::search(Queue* queue) {
+    int step = m_costs.allowDiagonals ? 1 : 2;
+    while (!queue->empty()) {
+        QueueItem item = queue->top();
+        queue->pop();
+        int distance = item.first;
+        int state = item.second;
+        if (m_stateDistances.at(state) < distance) {
+            continue;
+        }
+        int tile = state / m_numHeadings;
+        int heading = state % m_numHeadings;
+        int x = tile % getWidth();
+        int y = tile / getWidth();
+        for (int move = 0; move < NUM_MOVES; move += step) {
+            if (!canMove(x, y, move)) {
+                continue;
+            }
+            int nextHeading = getHeading(move);
+            int nextTile = (y + MOVE_DY[move]) * getWidth() + x + MOVE_DX[move];
+            int next = nextTile * m_numHeadings + nextHeading;
+            int nextDistance = (
+                distance +
+                getTurnCost(heading, nextHeading) +
+                getMoveCost(move)
+            );
+            if (nextDistance < m_stateDistances.at(next)) {
+                m_stateDistances[next] = nextDistance;
+                m_parents[next] = state;
+                queue->push({nextDistance, next});
+            }
+        }
+    }
+}
+
+void DistanceField::updateDistances() {
+    int numTiles = getWidth() * getHeight();
+    m_distances.fill(-1, numTiles);
+    for (int tile = 0; tile < numTiles; tile += 1) {
+        int min = INFINITE_DISTANCE;
+        for (int heading = 0; heading < m_numHeadings; heading += 1) {
+            min = std::min(min, m_stateDistances.at(tile * m_numHeadings + heading));
+        }
+        if (min != INFINITE_DISTANCE) {
+            m_distances[tile] = min;
+        }
+    }
+}
+
+void DistanceField::addMoves(int minX, int minY, int maxX, int maxY) {
+    // Distances can only shrink, and any shorter path must start with one
+    // of the new moves, so it suffices to search again from around the edge
+    Queue queue;
+    for (int x = std::max(minX, 0); x <= std::min(maxX, getWidth() - 1); x += 1) {
+        for (int y = std::max(minY, 0); y <= std::min(maxY, getHeight() - 1); y += 1) {
+            int tile = y * getWidth() + x;
+            for (int heading = 0; heading < m_numHeadings; heading += 1) {
+                int state = tile * m_numHeadings + heading;
+                if (m_stateDistances.at(state) != INFINITE_DISTANCE) {
+                    queue.push({m_stateDistances.at(state), state});
+                }
+            }
+        }
+    }
+    search(&queue);
+}
+
+void DistanceField::removeMoves(int minX, int minY, int maxX, int maxY) {
+
+    // Find the states whose shortest path ends with a move that's now blocked
+    int numStates = m_stateDistances.size();
+    QVector<char> invalid(numStates, -1);
+    bool anyInvalid = false;
+    for (int x = std::max(minX, 0); x <= std::min(maxX, getWidth() - 1); x += 1) {
+        for (int y = std::max(minY, 0); y <= std::min(maxY, getHeight() - 1); y += 1) {
+            int tile = y * getWidth() + x;
+            for (int heading = 0; heading < m_numHeadings; heading += 1) {
+                int state = tile * m_numHeadings + heading;
+                int parent = m_parents.at(state);
+                if (parent == -1) {
+                    continue;
+                }
+                int parentTile = parent / m_numHeadings;
+                int move = getMoveBetween(parentTile, tile);
+                if (!canMove(parentTile % getWidth(), parentTile / getWidth(), move)) {
+                    invalid[state] = 1;
+                    anyInvalid = true;
+                }
+            }
+        }
+    }
+    if (!anyInvalid) {
+        return;
+    }
+
+    // Every state whose shortest path ran through one of those states is
+    // invalid too; walk each path up the tree until its status is known
+    QVector<int> path;
+    for (int state = 0; state < numStates; state += 1) {
+        int current = state;
+        while (current != -1 && invalid.at(current) == -1) {
+            path.append(current);
+            current = m_parents.at(current);
+        }
+        char status = current == -1 ? 0 : invalid.at(current);
+        for (int visited : path) {
+            invalid[visited] = status;
+        }
+        path.clear();
+    }
+
+    // Forget the invalid distances, then search again from the valid states
+    // bordering them, whose distances can't have changed
+    QVector<bool> seeded(getWidth() * getHeight(), false);
+    Queue queue;
+    for (int state = 0; state < numStates; state += 1) {
+        if (invalid.at(state) != 1) {
+            continue;
+        }
+        m_stateDistances[state] = INFINITE_DISTANCE;
+        m_parents[state] = -1;
+    }
+    for (int state = 0; state < numStates; state += 1) {
+        if (invalid.at(state) != 1) {
+            continue;
+        }
+        int tile = state / m_numHeadings;
+        int x = tile % getWidth();
+        int y = tile / getWidth();
+        for (int move = 0; move < NUM_MOVES; move += 1) {
+            int neighborX = x - MOVE_DX[move];
+            int neighborY = y - MOVE_DY[move];
+            if (!m_walls.withinGrid(neighborX, neighborY)) {
+                continue;
+            }
+            int neighborTile = neighborY * getWidth() + neighborX;
+            if (seeded.at(neighborTile)) {
+                continue;
+            }
+            seeded[neighborTile] = true;
+            for (int heading = 0; heading < m_numHeadings; heading += 1) {
+                int neighbor = neighborTile * m_numHeadings + heading;
+                if (m_stateDistances.at(neighbor) != INFINITE_DISTANCE) {
+                    queue.push({m_stateDistances.at(neighbor), neighbor});
+                }
+            }
+        }
+    }
+    search(&queue);
+}
+
+bool DistanceField::canMove(int x, int y, int move) const {
+    if (!m_walls.withinGrid(x + MOVE_DX[move], y + MOVE_DY[move])) {
+        return false;
+    }
+    if (move % 2 == 0) {
+        return !m_walls.isWall(x, y, MOVE_DIRECTION[move / 2]);
+    }
+    // A diagonal move passes between two posts, through one of the two
+    // tiles beside it, e.g., north then east, or east then north
+    int first = move - 1;
+    int second = (move + 1) % NUM_MOVES;
+    Direction firstDirection = MOVE_DIRECTION[first / 2];
+    Direction secondDirection = MOVE_DIRECTION[second / 2];
+    return (
+        (
+            !m_walls.isWall(x, y, firstDirection) &&
+            !m_walls.isWall(x + MOVE_DX[first], y + MOVE_DY[first], secondDirection)
+        ) || (
+            !m_walls.isWall(x, y, secondDirection) &&
+            !m_walls.isWall(x + MOVE_DX[second], y + MOVE_DY[second], firstDirection)
+        )
+    );
+}
+
+int DistanceField::getMoveCost(int move) const {
+    return move % 2 == 0 ? m_costs.straight : m_costs.diagonal;
+}
+
+int DistanceField::getTurnCost(int fromHeading, int toHeading) const {
+    if (m_numHeadings == 1) {
+        return 0;
+    }
+    // Headings are converted to 45 degree steps
+    int stepsPerHeading = NUM_MOVES / m_numHeadings;
+    int steps = std::abs(fromHeading - toHeading) * stepsPerHeading;
+    return m_costs.turn * std::min(steps, NUM_MOVES - steps);
+}
+
+int DistanceField::getHeading(int move) const {
+    return move * m_numHeadings / NUM_MOVES;
+}
+
+int DistanceField::getMoveBetween(int fromTile, int toTile) const {
+    int dx = toTile % getWidth() - fromTile % getWidth();
+    int dy = toTile / getWidth() - fromTile / getWidth();
+    for (int move = 0; move < NUM_MOVES; move += 1) {
+        if (MOVE_DX[move] == dx && MOVE_DY[move] == dy) {
+            return move;
+        }
+    }
+    ASSERT_NEVER_RUNS();
+    return -1;
+}
+
+} // namespace mms
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <QPair>
+#include <QVector>
+
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "Direction.h"
+#include "WallGridView.h"
+
+namespace mms {
+
+// The cost of each kind of move through a maze
+struct DistanceFieldCosts {
+    DistanceFieldCosts();
+    // Moving one tile north, east, south, or west
+    int straight;
+    // Moving one tile diagonally, between two posts, if diagonals are allowed
+    int diagonal;
+    // Changing heading, per 45 degrees; a right-angle turn costs twice this
+    int turn;
+    bool allowDiagonals;
+};
+
+// The distance from every tile of a maze to the nearest of a set of goal
+// tiles. With unit costs this is a BFS over tiles; with a turn cost the
+// search is a Dijkstra over (tile, heading) states, since the cost of a move
+// depends on the direction the mouse was already heading. The field keeps its
+// shortest path tree so that it can be updated incrementally when a single
+// wall changes, e.g., as a mouse discovers the maze. The walls are read
+// through a view, so a field of a rotated or mirrored maze doesn't copy them.
+class DistanceField {
+
+public:
+
+    DistanceField(
+        const WallGridView& walls,
+        const QVector<QPair<int, int>>& goals,
+        const DistanceFieldCosts& costs = DistanceFieldCosts());
+
+    int getWidth() const;
+    int getHeight() const;
+    const WallGridView& getWalls() const;
+    const QVector<QPair<int, int>>& getGoals() const;
+
+    // The distance of a tile from the nearest goal, or -1 if unreachable
+    int getDistance(int x, int y) const;
+
+    // All of the distances, row by row from the bottom left
+    const QVector<int>& getDistances() const;
+    int getMaximumDistance() const;
+
+    // Adds or removes the wall on both sides of an edge, and updates only
+    // the distances that could have changed
+    void setWall(int x, int y, Direction direction, bool isWall);
+
+    // Replaces the goals and recomputes every distance
+    void setGoals(const QVector<QPair<int, int>>& goals);
+
+private:
+
+    // Distances of unreached states
+    static const int INFINITE_DISTANCE;
+
+    // Moves are numbered clockwise from north in 45 degree steps, so even
+    // moves are straight and odd moves are diagonal
+    static const int NUM_MOVES = 8;
+    static const int MOVE_DX[NUM_MOVES];
+    static const int MOVE_DY[NUM_MOVES];
+    static const Direction MOVE_DIRECTION[NUM_MOVES / 2];
+
+    typedef std::pair<int, int> QueueItem;
+    typedef std::priority_queue<
+        QueueItem,
+        std::vector<QueueItem>,
+        std::greater<QueueItem>> Queue;
+
+    WallGridView m_walls;
+    QVector<QPair<int, int>> m_goals;
+    DistanceFieldCosts m_costs;
+
+    // Headings are only tracked if turning costs something
+    int m_numHeadings;
+
+    // Indexed by tile * m_numHeadings + heading
+    QVector<int> m_stateDistances;
+    QVector<int> m_parents;
+
+    // The minimum over the headings of each tile
+    QVector<int> m_distances;
+
+    void computeAll();
+    void search(Queue* queue);
+    void updateDistances();
+
+    // Repairs the field after moves near a changed edge were added or removed
+    void addMoves(int minX, int minY, int maxX, int maxY);
+    void removeMoves(int minX, int minY, int maxX, int maxY);
+
+    bool canMove(int x, int y, int move) const;
+    int getMoveCost(int move) const;
+    int getTurnCost(int fromHeading, int toHeading) const;
+    int getHeading(int move) const;
+    int getMoveBetween(int fromTile, int toTile) const;
+};
+
+} // namespace mms
@@ -1,14 +1,23 @@
 #include "Driver.h"
 
 #include <QApplication>
+#include <QCommandLineOption>
+#include <QCommandLineParser>
 
 #include "ColorManager.h"
 #include "FontImage.h"
+#include "Instrumentation.h"
 #include "Logging.h"
+#include "MazeAnalyzer.h"
+#include "MazeBenchmark.h"
+#include "MazeCorpus.h"
+#include "MazeSearch.h"
+#include "RunComparison.h"
 #include "Screen.h"
 #include "Settings.h"
 #include "SimTime.h"
 #include "Model.h"
+#include "Tournament.h"
 #include "Window.h"
 
 namespace mms {
@@ -32,10 +41,79 @@ int Driver::drive(int argc, char* argv[]) {
     FontImage::init();
     Screen::init();
     SimTime::init();
+    Instrumentation::init();
 
     // Initialize the Param object
     P();
 
+    // Parse the command line options, some of which run without the GUI
+    QCommandLineParser parser;
+    parser.addHelpOption();
+
+    // The options shared by several of the modes that run without the GUI
+    QCommandLineOption outputOption(
+        "output",
+        "Write the --analyze results to <file> (CSV, or JSON if the suffix "
+        "is .json) instead of stdout, the --search matches to <file> as "
+        "MMSW records, or the --tournament results or the --compare table to "
+        "<file> as CSV.",
+        "file"
+    );
+    parser.addOption(outputOption);
+    QCommandLineOption firstSeedOption(
+        "first-seed",
+        "The first seed to --search from, or of the --tournament runs "
+        "(default 0).",
+        "seed",
+        "0"
+    );
+    parser.addOption(firstSeedOption);
+    parser.addPositionalArgument(
+        "directories",
+        "Directories of maze files, for --build-corpus, --analyze and "
+        "--tournament.",
+        "[directories...]"
+    );
+
+    // The options of each mode
+    MazeCorpus::addOptions(&parser);
+    MazeAnalyzer::addOptions(&parser);
+    MazeBenchmark::addOptions(&parser);
+    MazeSearch::addOptions(&parser);
+    Tournament::addOptions(&parser);
+    RunComparison::addOptions(&parser);
+    parser.process(app);
+
+    // Convert directories of maze files into a corpus
+    if (parser.isSet("build-corpus")) {
+        return MazeCorpus::runFromArguments(parser);
+    }
+
+    // Analyze directories of maze files
+    if (parser.isSet("analyze")) {
+        return MazeAnalyzer::runFromArguments(parser);
+    }
+
+    // Search for generated mazes that match the criteria
+    if (parser.isSet("search")) {
+        return MazeSearch::runFromArguments(parser);
+    }
+
+    // Run mouse algorithms against each other, or a batch of runs of one
+    if (parser.isSet("tournament") || parser.isSet("tournament-job")) {
+        return Tournament::runFromArguments(parser);
+    }
+
+    // Look for regressions between builds of the algorithms
+    if (parser.isSet("compare")) {
+        return RunComparison::runFromArguments(parser);
+    }
+
+    // Benchmark the maze pipeline on a large maze
+    if (parser.isSet("benchmark")) {
+        return MazeBenchmark::runFromArguments(parser);
+    }
+
     // Create the main window
     Window window;
     window.show();
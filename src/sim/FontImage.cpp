@@ -23,8 +23,13 @@ QString FontImage::imageFilePath() {
     return m_imageFilePath;
 }
 
-QMap<QChar, QPair<double, double>> FontImage::positions() {
-    return m_positions;
+bool FontImage::contains(QChar c) const {
+    return c.unicode() < NUM_CODES && m_contains[c.unicode()];
+}
+
+QPair<double, double> FontImage::position(QChar c) const {
+    ASSERT_TR(contains(c));
+    return m_positions[c.unicode()];
 }
 
 FontImage::FontImage() {
@@ -58,13 +63,20 @@ FontImage::FontImage() {
         "@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_"
         "`abcdefghijklmnopqrstuvwxyz{|}~";
 
-    // Create a map of the font image chars (allowable tile text chars) to
+    // Create a table of the font image chars (allowable tile text chars) to
     // their horizontal position in the png image (a fraction from 0.0 to 1.0)
+    for (int i = 0; i < NUM_CODES; i += 1) {
+        m_contains[i] = false;
+        m_positions[i] = {0.0, 0.0};
+    }
     int size = fontImageChars.size();
     for (int i = 0; i < size; i += 1) {
         double start = static_cast<double>(i + 0) / static_cast<double>(size);
         double end   = static_cast<double>(i + 1) / static_cast<double>(size);
-        m_positions.insert(fontImageChars.at(i), {start, end});
+        ushort code = fontImageChars.at(i).unicode();
+        ASSERT_LT(code, NUM_CODES);
+        m_contains[code] = true;
+        m_positions[code] = {start, end};
     }
 }
 
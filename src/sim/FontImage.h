@@ -1,8 +1,8 @@
 #pragma once
 
 #include <QChar>
-#include <QMap>
 #include <QPair>
+#include <QString>
 
 namespace mms {
 
@@ -12,13 +12,24 @@ public:
     static void init();
     static FontImage* get();
     QString imageFilePath();
-    QMap<QChar, QPair<double, double>> positions();
+
+    // Whether the character is in the font image, i.e., whether it's an
+    // allowable tile text character
+    bool contains(QChar c) const;
+
+    // The horizontal start and end of the character in the font image, as
+    // fractions from 0.0 to 1.0; the character must be in the font image
+    QPair<double, double> position(QChar c) const;
 
 private:
     FontImage();
     static FontImage* INSTANCE;
     QString m_imageFilePath;
-    QMap<QChar, QPair<double, double>> m_positions;
+
+    // Flat lookup tables, indexed by the character's code
+    static const int NUM_CODES = 128;
+    bool m_contains[NUM_CODES];
+    QPair<double, double> m_positions[NUM_CODES];
 
 };
 
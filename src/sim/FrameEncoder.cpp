@@ -0,0 +1,16 @@
+#include "FrameEncoder.h"
+
+#include <QDebug>
+
+namespace mms {
+
+void FrameEncoder::encode(QImage image, QString path) {
+    if (!image.save(path)) {
+        qWarning().noquote().nospace()
+            << "Unable to save frame to \"" << path << "\"";
+        return;
+    }
+    emit frameEncoded(path);
+}
+
+} // namespace mms
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QImage>
+#include <QObject>
+#include <QString>
+
+namespace mms {
+
+// Encodes rendered frames to disk. Lives on its own thread so that image
+// compression never blocks the GUI or the model.
+class FrameEncoder : public QObject {
+
+    Q_OBJECT
+
+public slots:
+
+    void encode(QImage image, QString path);
+
+signals:
+
+    void frameEncoded(QString path);
+
+};
+
+} // namespace mms
@@ -0,0 +1,95 @@
+#include "FrameRecorder.h"
+
+#include <QDir>
+
+#include <algorithm>
+
+#include "SimTime.h"
+
+namespace mms {
+
+FrameRecorder::FrameRecorder(int width, int height) :
+        m_width(width),
+        m_height(height),
+        m_hasScene(false),
+        m_encoder(new FrameEncoder()),
+        m_recording(false),
+        m_frameNumber(0) {
+
+    // Frames are handed off by value (QImage is implicitly shared)
+    m_encoder->moveToThread(&m_encoderThread);
+    connect(&m_encoderThread, &QThread::finished, m_encoder, &QObject::deleteLater);
+    connect(this, &FrameRecorder::frameReady, m_encoder, &FrameEncoder::encode);
+    m_encoderThread.start();
+}
+
+FrameRecorder::~FrameRecorder() {
+    // Let the encoder finish any frames that are still queued
+    m_encoderThread.quit();
+    m_encoderThread.wait();
+}
+
+void FrameRecorder::setSize(int width, int height) {
+    m_width = width;
+    m_height = height;
+}
+
+void FrameRecorder::setScene(
+        const Maze* maze,
+        const MazeView* view,
+        const MouseGraphic* mouseGraphic,
+        LayoutType layoutType) {
+    m_exporter.setScene(maze, view, mouseGraphic, layoutType);
+    m_hasScene = (maze != nullptr && view != nullptr);
+}
+
+void FrameRecorder::start(const QString& directory, const Duration& interval) {
+    QDir().mkpath(directory);
+    m_directory = directory;
+    m_interval = Duration::Milliseconds(std::max(1.0, interval.getMilliseconds()));
+    m_nextFrameTime = SimTime::get()->elapsedSimTime();
+    m_frameNumber = 0;
+    m_recording = true;
+}
+
+void FrameRecorder::stop() {
+    m_recording = false;
+}
+
+bool FrameRecorder::isRecording() const {
+    return m_recording;
+}
+
+void FrameRecorder::captureFrame() {
+    if (!m_recording || !m_hasScene) {
+        return;
+    }
+    // The sim time is reset whenever a new mouse starts
+    Duration now = SimTime::get()->elapsedSimTime();
+    if (now + m_interval < m_nextFrameTime) {
+        m_nextFrameTime = now;
+    }
+    if (now < m_nextFrameTime) {
+        return;
+    }
+    // If the sim is running faster than we can capture, skip ahead rather
+    // than falling further and further behind
+    while (!(now < m_nextFrameTime)) {
+        m_nextFrameTime += m_interval;
+    }
+    exportImage(QDir(m_directory).filePath(
+        QString("frame-%1.png").arg(m_frameNumber, 6, 10, QChar('0'))));
+    m_frameNumber += 1;
+}
+
+void FrameRecorder::exportImage(const QString& path) {
+    if (!m_hasScene) {
+        return;
+    }
+    QImage image = m_exporter.render(m_width, m_height);
+    if (!image.isNull()) {
+        emit frameReady(image, path);
+    }
+}
+
+} // namespace mms
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QImage>
+#include <QObject>
+#include <QString>
+#include <QThread>
+
+#include "FrameEncoder.h"
+#include "LayoutType.h"
+#include "MapExporter.h"
+#include "Maze.h"
+#include "MazeView.h"
+#include "MouseGraphic.h"
+#include "units/Duration.h"
+
+namespace mms {
+
+// Captures images of a scene, either one at a time or as a sequence of frames
+// spaced by an interval of sim time. Frames are rendered offscreen on the GUI
+// thread (which only reads the CPU-side buffers, just like the Map) and are
+// encoded on a worker thread, so neither the GUI nor the model waits on disk.
+class FrameRecorder : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    FrameRecorder(int width, int height);
+    ~FrameRecorder();
+
+    // Sets the resolution of the images captured from now on
+    void setSize(int width, int height);
+
+    void setScene(
+        const Maze* maze,
+        const MazeView* view,
+        const MouseGraphic* mouseGraphic,
+        LayoutType layoutType);
+
+    // Starts writing numbered frames into the given directory
+    void start(const QString& directory, const Duration& interval);
+    void stop();
+    bool isRecording() const;
+
+    // Captures a frame if at least one interval of sim time has passed since
+    // the previous frame; this should be called regularly while recording
+    void captureFrame();
+
+    // Renders a single image of the current scene to the given path
+    void exportImage(const QString& path);
+
+signals:
+
+    void frameReady(QImage image, QString path);
+
+private:
+
+    int m_width;
+    int m_height;
+
+    MapExporter m_exporter;
+    bool m_hasScene;
+
+    FrameEncoder* m_encoder;
+    QThread m_encoderThread;
+
+    bool m_recording;
+    QString m_directory;
+    Duration m_interval;
+    Duration m_nextFrameTime;
+    int m_frameNumber;
+
+};
+
+} // namespace mms
@@ -0,0 +1,100 @@
+#include "Instrumentation.h"
+
+#include <algorithm>
+
+#include "Assert.h"
+
+namespace mms {
+
+Instrumentation* Instrumentation::INSTANCE = nullptr;
+
+void Instrumentation::init() {
+    ASSERT_TR(INSTANCE == nullptr);
+    INSTANCE = new Instrumentation();
+}
+
+Instrumentation* Instrumentation::get() {
+    ASSERT_FA(INSTANCE == nullptr);
+    return INSTANCE;
+}
+
+QElapsedTimer Instrumentation::startTimer() {
+    QElapsedTimer timer;
+    timer.start();
+    return timer;
+}
+
+void Instrumentation::recordTiming(Timing timing, const QElapsedTimer& timer) {
+    recordTiming(timing, timer.nsecsElapsed() / 1000000.0);
+}
+
+void Instrumentation::recordTiming(Timing timing, double milliseconds) {
+    m_timings[static_cast<int>(timing)].push(milliseconds);
+}
+
+void Instrumentation::increment(Counter counter) {
+    m_counters[static_cast<int>(counter)].fetch_add(1, std::memory_order_relaxed);
+}
+
+QPair<QStringList, QStringList> Instrumentation::summarize() {
+
+    static const QStringList timingLabels = {
+        "Buffer Upload",
+        "Draw",
+        "Mouse Triangulation",
+        "Step Lateness",
+    };
+    static const QStringList counterLabels = {
+        "Frames/s",
+        "Model Steps/s",
+        "Commands/s",
+    };
+
+    QStringList labels;
+    QStringList values;
+
+    // For each timing, report the mean and the worst recent sample
+    for (int i = 0; i < NUM_TIMINGS; i += 1) {
+        QVector<double> samples = m_timings[i].snapshot();
+        QString value = "N/A";
+        if (!samples.isEmpty()) {
+            double total = 0.0;
+            double worst = 0.0;
+            for (double sample : samples) {
+                total += sample;
+                worst = std::max(worst, sample);
+            }
+            value = QString("%1 / %2")
+                .arg(total / samples.size(), 0, 'f', 3)
+                .arg(worst, 0, 'f', 3);
+        }
+        labels.append(timingLabels.at(i) + " (ms, avg / max)");
+        values.append(value);
+    }
+
+    // For each counter, report the rate since the previous summary
+    double seconds = m_summaryTimer.nsecsElapsed() / 1000000000.0;
+    m_summaryTimer.restart();
+    for (int i = 0; i < NUM_COUNTERS; i += 1) {
+        unsigned long long count = m_counters[i].load(std::memory_order_relaxed);
+        double rate = 0.0;
+        if (0.0 < seconds) {
+            rate = (count - m_previousCounts[i]) / seconds;
+        }
+        m_previousCounts[i] = count;
+        labels.append(counterLabels.at(i));
+        values.append(QString::number(rate, 'f', 1));
+    }
+
+    return {labels, values};
+}
+
+Instrumentation::Instrumentation() {
+    for (int i = 0; i < NUM_COUNTERS; i += 1) {
+        m_counters[i].store(0);
+        m_previousCounts[i] = 0;
+    }
+    m_summaryTimer.start();
+}
+
+} // namespace mms
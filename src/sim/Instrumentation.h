@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QPair>
+#include <QStringList>
+
+#include <atomic>
+
+#include "RingBuffer.h"
+
+namespace mms {
+
+// The timings recorded by the Instrumentation class, in milliseconds
+enum class Timing {
+    BUFFER_UPLOAD,
+    DRAW,
+    MOUSE_TRIANGULATION,
+    STEP_LATENESS,
+};
+
+// The events counted by the Instrumentation class
+enum class Counter {
+    FRAMES,
+    MODEL_STEPS,
+    COMMANDS,
+};
+
+// Cheap, lock-free recording of where time goes in the render loop, the
+// model loop and the algorithm interface. Each timing or counter should only
+// be written from a single thread; any thread may summarize.
+class Instrumentation {
+
+public:
+
+    static void init();
+    static Instrumentation* get();
+
+    // Returns a timer that can be passed to recordTiming()
+    static QElapsedTimer startTimer();
+
+    void recordTiming(Timing timing, const QElapsedTimer& timer);
+    void recordTiming(Timing timing, double milliseconds);
+    void increment(Counter counter);
+
+    // Returns labels and formatted values for display. Rates are computed
+    // over the time since the previous call, so this should only be called
+    // from one place.
+    QPair<QStringList, QStringList> summarize();
+
+private:
+
+    // A private constructor is used to ensure
+    // only one instance of this class exists
+    Instrumentation();
+
+    // A pointer to the actual instance of the class
+    static Instrumentation* INSTANCE;
+
+    static const int NUM_TIMINGS = 4;
+    static const int NUM_COUNTERS = 3;
+    static const int SAMPLES_PER_TIMING = 512;
+
+    RingBuffer<double, SAMPLES_PER_TIMING> m_timings[NUM_TIMINGS];
+    std::atomic<unsigned long long> m_counters[NUM_COUNTERS];
+
+    // Used to compute rates between summaries
+    QElapsedTimer m_summaryTimer;
+    unsigned long long m_previousCounts[NUM_COUNTERS];
+
+};
+
+} // namespace mms
@@ -1,19 +1,15 @@
 #pragma once
 
-#include <QOpenGLBuffer> 
 #include <QOpenGLDebugLogger>
 #include <QOpenGLFunctions>
-#include <QOpenGLShaderProgram> 
-#include <QOpenGLTexture> 
-#include <QOpenGLVertexArrayObject> 
 #include <QOpenGLWidget>
 #include <QVector>
 
 #include "LayoutType.h"
+#include "MapRenderer.h"
 #include "Maze.h"
 #include "MazeView.h"
 #include "MouseGraphic.h"
-#include "TriangleGraphic.h"
 
 namespace mms {
 
@@ -32,10 +28,17 @@ public:
     void setView(const MazeView* view);
     void setMouseGraphic(const MouseGraphic* mouseGraphic);
 
+    // Mice drawn alongside the followed one, e.g., a rival in a race
+    void setOtherMouseGraphics(const QVector<const MouseGraphic*>& mouseGraphics);
+
     void setLayoutType(LayoutType layoutType);
     void setZoomedMapScale(double zoomedMapScale);
     void setRotateZoomedMap(bool rotateZoomedMap);
 
+    // Forces the static layer (the corners, and the walls when the wall
+    // truth is visible) to be re-rendered on the next paint
+    void invalidateStaticLayers();
+
     // Retrieves OpenGL version info
     QVector<QString> getOpenGLVersionInfo();
 
@@ -53,46 +56,8 @@ private:
     QOpenGLDebugLogger m_openGLLogger;
     void initOpenGLLogger();
 
-    // No ownership here - only pointers
-    const Maze* m_maze;
-    const MazeView* m_view;
-    const MouseGraphic* m_mouseGraphic;
-
-    // The map's window size, in pixels
-    int m_windowWidth;
-    int m_windowHeight;
-
-    // Some display knobs
-    LayoutType m_layoutType;
-    double m_zoomedMapScale;
-    bool m_rotateZoomedMap;
-
-    // Polygon program variables
-    QOpenGLShaderProgram m_polygonProgram;
-    QOpenGLVertexArrayObject m_polygonVAO;
-    QOpenGLBuffer m_polygonVBO;
-
-    // Texture program variables
-    QOpenGLTexture* m_textureAtlas;
-    QOpenGLShaderProgram m_textureProgram;
-    QOpenGLVertexArrayObject m_textureVAO;
-    QOpenGLBuffer m_textureVBO;
-
-    // Initialize the graphics
-    void initPolygonProgram();
-    void initTextureProgram();
-
-    // Drawing helper methods
-    void repopulateVertexBufferObjects(
-        const QVector<TriangleGraphic>& mouseBuffer);
-    void drawMap(
-        LayoutType type,
-        const Coordinate& currentMouseTranslation,
-        const Angle& currentMouseRotation,
-        QOpenGLShaderProgram* program,
-        QOpenGLVertexArrayObject* vao,
-        int vboStartingIndex,
-        int count);
+    // Does the actual drawing, within this widget's context
+    MapRenderer m_renderer;
 };
 
 } // namespace mms
@@ -0,0 +1,83 @@
+#include "MapExporter.h"
+
+#include <QDebug>
+
+namespace mms {
+
+MapExporter::MapExporter() :
+        m_framebuffer(nullptr),
+        m_initialized(false),
+        m_maze(nullptr),
+        m_view(nullptr),
+        m_mouseGraphic(nullptr) {
+    m_surface.create();
+}
+
+MapExporter::~MapExporter() {
+    if (m_initialized && makeCurrent()) {
+        m_renderer.shutdown();
+        delete m_framebuffer;
+        m_context.doneCurrent();
+    }
+    m_surface.destroy();
+}
+
+void MapExporter::setScene(
+        const Maze* maze,
+        const MazeView* view,
+        const MouseGraphic* mouseGraphic,
+        LayoutType layoutType) {
+    if (maze != m_maze) {
+        m_renderer.setMouseGraphic(nullptr);
+        m_renderer.setMaze(maze);
+        m_maze = maze;
+        m_view = nullptr;
+        m_mouseGraphic = nullptr;
+    }
+    if (view != m_view) {
+        m_renderer.setMouseGraphic(nullptr);
+        m_renderer.setView(view);
+        m_view = view;
+        m_mouseGraphic = nullptr;
+    }
+    m_renderer.setMouseGraphic(mouseGraphic);
+    m_mouseGraphic = mouseGraphic;
+    m_renderer.setLayoutType(layoutType);
+}
+
+QImage MapExporter::render(int width, int height) {
+
+    if (!makeCurrent()) {
+        return QImage();
+    }
+
+    if (!m_initialized) {
+        m_renderer.initialize();
+        m_initialized = true;
+    }
+
+    if (m_framebuffer == nullptr || m_framebuffer->size() != QSize(width, height)) {
+        delete m_framebuffer;
+        m_framebuffer = new QOpenGLFramebufferObject(width, height);
+    }
+
+    m_framebuffer->bind();
+    m_context.functions()->glViewport(0, 0, width, height);
+    m_renderer.resize(width, height);
+    m_renderer.render();
+    QImage image = m_framebuffer->toImage();
+    m_framebuffer->release();
+
+    m_context.doneCurrent();
+    return image;
+}
+
+bool MapExporter::makeCurrent() {
+    if (!m_context.isValid() && !m_context.create()) {
+        qWarning() << "Unable to create an offscreen OpenGL context";
+        return false;
+    }
+    return m_context.makeCurrent(&m_surface);
+}
+
+} // namespace mms
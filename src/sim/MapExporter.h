@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QImage>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+
+#include "LayoutType.h"
+#include "MapRenderer.h"
+#include "Maze.h"
+#include "MazeView.h"
+#include "MouseGraphic.h"
+
+namespace mms {
+
+// Renders maze views into images without a window, using an offscreen
+// surface and a framebuffer object. It must be used from the GUI thread.
+class MapExporter {
+
+public:
+
+    MapExporter();
+    ~MapExporter();
+
+    // Sets what should be rendered; the mouse graphic may be null
+    void setScene(
+        const Maze* maze,
+        const MazeView* view,
+        const MouseGraphic* mouseGraphic,
+        LayoutType layoutType);
+
+    // Renders the current scene at the given resolution. Returns a null image
+    // if the offscreen context could not be created.
+    QImage render(int width, int height);
+
+private:
+
+    QOffscreenSurface m_surface;
+    QOpenGLContext m_context;
+    QOpenGLFramebufferObject* m_framebuffer;
+    MapRenderer m_renderer;
+    bool m_initialized;
+
+    // The current scene, used to avoid needlessly invalidating the
+    // renderer's static layer cache between frames
+    const Maze* m_maze;
+    const MazeView* m_view;
+    const MouseGraphic* m_mouseGraphic;
+
+    bool makeCurrent();
+
+};
+
+} // namespace mms
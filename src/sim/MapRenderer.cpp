@@ -0,0 +1,759 @@
+#include "MapRenderer.h"
+
+#include <QFile>
+#include <QPair>
+#include <QPointF>
+
+#include <algorithm>
+#include <cmath>
+
+#include "Assert.h"
+#include "FontImage.h"
+#include "Instrumentation.h"
+#include "Layout.h"
+#include "Param.h"
+#include "Screen.h"
+#include "TransformationMatrix.h"
+#include "TriangleTexture.h"
+
+namespace mms {
+
+const int MapRenderer::CHUNK_SIZE = 8;
+
+MapRenderer::MapRenderer() :
+    m_maze(nullptr),
+    m_view(nullptr),
+    m_mouseGraphic(nullptr),
+    m_windowWidth(0),
+    m_windowHeight(0),
+    m_layoutType(LayoutType::FULL),
+    m_zoomedMapScale(0.1),
+    m_rotateZoomedMap(false),
+    m_staticLayersDirty(true),
+    m_instrumented(false),
+    m_textureAtlas(nullptr) {
+}
+
+void MapRenderer::setMaze(const Maze* maze) {
+    ASSERT_TR(m_mouseGraphic == nullptr);
+    ASSERT_TR(m_otherMouseGraphics.isEmpty());
+    m_maze = maze;
+    m_view = nullptr;
+    invalidateStaticLayers();
+}
+
+void MapRenderer::setView(const MazeView* view) {
+    if (view != nullptr) {
+        ASSERT_FA(m_maze == nullptr);
+    }
+    if (view != m_view) {
+        invalidateStaticLayers();
+    }
+    m_view = view;
+}
+
+void MapRenderer::setMouseGraphic(const MouseGraphic* mouseGraphic) {
+    if (mouseGraphic != nullptr) {
+        ASSERT_FA(m_maze == nullptr);
+        ASSERT_FA(m_view == nullptr);
+    }
+    m_mouseGraphic = mouseGraphic;
+}
+
+void MapRenderer::setOtherMouseGraphics(const QVector<const MouseGraphic*>& mouseGraphics) {
+    if (!mouseGraphics.isEmpty()) {
+        ASSERT_FA(m_maze == nullptr);
+        ASSERT_FA(m_view == nullptr);
+    }
+    m_otherMouseGraphics = mouseGraphics;
+}
+
+void MapRenderer::setLayoutType(LayoutType layoutType) {
+    m_layoutType = layoutType;
+}
+
+void MapRenderer::setZoomedMapScale(double zoomedMapScale) {
+    if (zoomedMapScale != m_zoomedMapScale) {
+        invalidateStaticLayers();
+    }
+    m_zoomedMapScale = zoomedMapScale;
+}
+
+void MapRenderer::setRotateZoomedMap(bool rotateZoomedMap) {
+    m_rotateZoomedMap = rotateZoomedMap;
+}
+
+void MapRenderer::setInstrumented(bool instrumented) {
+    m_instrumented = instrumented;
+}
+
+void MapRenderer::invalidateStaticLayers() {
+    // The framebuffer objects can only be deleted while the context is
+    // current, so we simply mark them as stale and rebuild them lazily
+    m_staticLayersDirty = true;
+}
+
+void MapRenderer::shutdown() {
+    deleteStaticLayers();
+    delete m_textureAtlas;
+    m_textureAtlas = nullptr;
+}
+
+void MapRenderer::initialize() {
+
+    // Contains all initialization that requires an OpenGL context
+
+    // Make it possible to call gl functions directly
+    initializeOpenGLFunctions();
+
+    // Set some gl values
+    glClearColor(0.0, 0.0, 0.0, 1.0);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_BLEND);
+
+    // Initialize the polygon and texture programs
+    initPolygonProgram();
+    initTextureProgram();
+}
+
+void MapRenderer::render() {
+
+    // If the view hasn't been set yet, just draw black
+    if (m_view == nullptr) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        return;
+    }
+
+    Coordinate currentMouseTranslation;
+    Angle currentMouseRotation;
+    QVector<TriangleGraphic> mouseBuffer;
+    QElapsedTimer triangulationTimer = Instrumentation::startTimer();
+    for (const MouseGraphic* mouseGraphic : m_otherMouseGraphics) {
+        auto position = mouseGraphic->getCurrentMousePosition();
+        mouseBuffer += mouseGraphic->draw(position.first, position.second);
+    }
+    if (m_mouseGraphic != nullptr) {
+        auto currentPosition = m_mouseGraphic->getCurrentMousePosition();
+        currentMouseTranslation = currentPosition.first;
+        currentMouseRotation = currentPosition.second;
+        // Drawn last, so that it's on top
+        mouseBuffer += m_mouseGraphic->draw(
+            currentMouseTranslation,
+            currentMouseRotation);
+    }
+    if (m_instrumented && !mouseBuffer.isEmpty()) {
+        Instrumentation::get()->recordTiming(
+            Timing::MOUSE_TRIANGULATION, triangulationTimer);
+    }
+
+    // Re-populate both vertex buffer objects
+    QElapsedTimer uploadTimer = Instrumentation::startTimer();
+    repopulateVertexBufferObjects(mouseBuffer);
+    if (m_instrumented) {
+        Instrumentation::get()->recordTiming(Timing::BUFFER_UPLOAD, uploadTimer);
+    }
+
+    // Note that this is the CPU time spent issuing draw calls
+    QElapsedTimer drawTimer = Instrumentation::startTimer();
+
+    // Render the static layer before scissoring is enabled, if necessary
+    LayoutType type = getEffectiveLayoutType();
+    QOpenGLFramebufferObject* staticLayer = getStaticLayer(type);
+
+    // Clear the screen
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // Enable scissoring so that the maps are only draw in specified locations.
+    glEnable(GL_SCISSOR_TEST);
+
+    QPair<int, int> mapPosition = (
+        type == LayoutType::FULL
+        ? Layout::getFullMapPosition()
+        : Layout::getZoomedMapPosition()
+    );
+    QPair<int, int> mapSize = (
+        type == LayoutType::FULL
+        ? Layout::getFullMapSize(m_windowWidth, m_windowHeight)
+        : Layout::getZoomedMapSize(m_windowWidth, m_windowHeight)
+    );
+    QMatrix4x4 transformationMatrix = getTransformationMatrix(
+        type,
+        mapPosition,
+        mapSize,
+        currentMouseTranslation,
+        currentMouseRotation);
+    glScissor(mapPosition.first, mapPosition.second, mapSize.first, mapSize.second);
+
+    // Only the zoomed map can have tiles outside of the viewport
+    bool cullChunks = (type == LayoutType::ZOOMED);
+
+    // Draw the base of the tiles
+    drawLayer(TileGraphicLayer::BASE, transformationMatrix, mapPosition, mapSize, cullChunks);
+
+    // Draw the walls and corners, using the cached static layer if possible.
+    // Walls are only static if the true walls are being displayed.
+    if (staticLayer != nullptr) {
+        drawStaticLayer(staticLayer, transformationMatrix);
+        if (!m_view->getMazeGraphic()->isWallTruthVisible()) {
+            drawLayer(TileGraphicLayer::WALLS, transformationMatrix, mapPosition, mapSize, cullChunks);
+        }
+    }
+    else {
+        drawLayer(TileGraphicLayer::WALLS, transformationMatrix, mapPosition, mapSize, cullChunks);
+        drawLayer(TileGraphicLayer::CORNERS, transformationMatrix, mapPosition, mapSize, cullChunks);
+    }
+
+    // Draw the fog
+    drawLayer(TileGraphicLayer::FOG, transformationMatrix, mapPosition, mapSize, cullChunks);
+
+    // Overlay the tile text
+    if (m_textureAtlas != nullptr) {
+        drawMap(
+            &m_textureProgram,
+            &m_textureVAO,
+            transformationMatrix,
+            mapPosition,
+            mapSize,
+            0,
+            3 * m_view->getTextureCpuBuffer()->size(),
+            cullChunks
+        );
+    }
+
+    // Draw the mouse
+    drawMap(
+        &m_polygonProgram,
+        &m_polygonVAO,
+        transformationMatrix,
+        mapPosition,
+        mapSize,
+        3 * m_view->getGraphicCpuBuffer()->size(),
+        3 * mouseBuffer.size(),
+        false
+    );
+
+    // Disable scissoring so that the glClear can take effect, and so that
+    // drawn text isn't clipped at all
+    glDisable(GL_SCISSOR_TEST);
+
+    if (m_instrumented) {
+        Instrumentation::get()->recordTiming(Timing::DRAW, drawTimer);
+        Instrumentation::get()->increment(Counter::FRAMES);
+    }
+}
+
+void MapRenderer::resize(int width, int height) {
+    if (width != m_windowWidth || height != m_windowHeight) {
+        invalidateStaticLayers();
+    }
+    m_windowWidth = width;
+    m_windowHeight = height;
+}
+
+void MapRenderer::initPolygonProgram() {
+
+    m_polygonProgram.addShaderFromSourceCode(
+        QOpenGLShader::Vertex,
+        R"(
+            uniform mat4 transformationMatrix;
+            attribute vec2 coordinate;
+            attribute vec4 inColor;
+            varying vec4 outColor;
+            void main(void) {
+                gl_Position = transformationMatrix * vec4(coordinate, 0.0, 1.0);
+                outColor = inColor;
+            }
+        )"
+    );
+    m_polygonProgram.addShaderFromSourceCode(
+        QOpenGLShader::Fragment,
+        R"(
+            varying vec4 outColor;
+            void main(void) {
+               gl_FragColor = outColor;
+            }
+        )"
+    );
+    m_polygonProgram.link();
+    m_polygonProgram.bind();
+
+    m_polygonVAO.create();
+    m_polygonVAO.bind();
+
+    m_polygonVBO.create();
+    m_polygonVBO.bind();
+    m_polygonVBO.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+
+    m_polygonProgram.enableAttributeArray("coordinate");
+    m_polygonProgram.setAttributeBuffer(
+        "coordinate", // name
+        GL_DOUBLE, // type
+        0, // offset (bytes)
+        2, // tupleSize (number of elements in the attribute array)
+        6 * sizeof(double) // stride (bytes between vertices)
+    );
+
+    m_polygonProgram.enableAttributeArray("inColor");
+    m_polygonProgram.setAttributeBuffer(
+        "inColor", // name
+        GL_DOUBLE, // type
+        2 * sizeof(double), // offset (bytes)
+        4, // tupleSize (number of elements in the attribute array)
+        6 * sizeof(double) // stride (bytes between vertices)
+    );
+
+    m_polygonVBO.release();
+    m_polygonVAO.release();
+    m_polygonProgram.release();
+}
+
+void MapRenderer::initTextureProgram() {
+
+    m_textureProgram.addShaderFromSourceCode(
+        QOpenGLShader::Vertex,
+        R"(
+            uniform mat4 transformationMatrix;
+            attribute vec2 coordinate;
+            attribute vec2 inTextureCoordinate;
+            varying vec2 outTextureCoordinate;
+            void main() {
+                gl_Position = transformationMatrix * vec4(coordinate, 0.0, 1.0);
+                outTextureCoordinate = inTextureCoordinate;
+            }
+        )"
+    );
+    m_textureProgram.addShaderFromSourceCode(
+        QOpenGLShader::Fragment,
+        R"(
+            uniform sampler2D texture;
+            varying vec2 outTextureCoordinate;
+            void main() {
+                gl_FragColor = texture2D(texture, outTextureCoordinate);
+            }
+        )"
+    );
+    m_textureProgram.link();
+    m_textureProgram.bind();
+
+    m_textureVAO.create();
+    m_textureVAO.bind();
+
+    m_textureVBO.create();
+    m_textureVBO.bind();
+    m_textureVBO.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+
+    m_textureProgram.enableAttributeArray("coordinate");
+    m_textureProgram.setAttributeBuffer(
+        "coordinate", // name
+        GL_DOUBLE, // type
+        0, // offset (bytes)
+        2, // tupleSize (number of elements in the attribute array)
+        4 * sizeof(double) // stride (bytes between vertices)
+    );
+
+    m_textureProgram.enableAttributeArray("inTextureCoordinate");
+    m_textureProgram.setAttributeBuffer(
+        "inTextureCoordinate", // name
+        GL_DOUBLE, // type
+        2 * sizeof(double), // offset (bytes)
+        2, // tupleSize (number of elements in the attribute array)
+        4 * sizeof(double) // stride (bytes between vertices)
+    );
+
+    m_textureVBO.release();
+    m_textureVAO.release();
+
+    // The static layer is drawn as a single textured quad, so it needs its
+    // own vertex array object
+    m_staticLayerVAO.create();
+    m_staticLayerVAO.bind();
+
+    m_staticLayerVBO.create();
+    m_staticLayerVBO.bind();
+    m_staticLayerVBO.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+
+    m_textureProgram.enableAttributeArray("coordinate");
+    m_textureProgram.setAttributeBuffer(
+        "coordinate", // name
+        GL_DOUBLE, // type
+        0, // offset (bytes)
+        2, // tupleSize (number of elements in the attribute array)
+        4 * sizeof(double) // stride (bytes between vertices)
+    );
+
+    m_textureProgram.enableAttributeArray("inTextureCoordinate");
+    m_textureProgram.setAttributeBuffer(
+        "inTextureCoordinate", // name
+        GL_DOUBLE, // type
+        2 * sizeof(double), // offset (bytes)
+        2, // tupleSize (number of elements in the attribute array)
+        4 * sizeof(double) // stride (bytes between vertices)
+    );
+
+    m_staticLayerVBO.release();
+    m_staticLayerVAO.release();
+
+    // Load the bitmap texture into the texture atlas
+    if (QFile::exists(FontImage::get()->imageFilePath())) {
+        m_textureAtlas = new QOpenGLTexture(QImage(
+            FontImage::get()->imageFilePath()
+        ).mirrored());
+    }
+    else {
+        qWarning()
+            << "Font image file does not exist:"
+            << FontImage::get()->imageFilePath();
+    }
+
+    m_textureProgram.release();
+}
+
+void MapRenderer::repopulateVertexBufferObjects(const QVector<TriangleGraphic>& mouseBuffer) {
+
+    // Overwrite the polygon vertex buffer object data
+    m_polygonVBO.bind();
+    m_polygonVBO.allocate(sizeof(TriangleGraphic) * (
+        m_view->getGraphicCpuBuffer()->size() +
+        mouseBuffer.size()
+    ));
+    // Write the maze
+    m_polygonVBO.write(
+        0,
+        &(m_view->getGraphicCpuBuffer()->front()),
+        sizeof(TriangleGraphic) * m_view->getGraphicCpuBuffer()->size()
+    );
+    // Write the mouse
+    if (!mouseBuffer.isEmpty()) {
+        m_polygonVBO.write(
+            sizeof(TriangleGraphic) * m_view->getGraphicCpuBuffer()->size(),
+            &(mouseBuffer.front()),
+            sizeof(TriangleGraphic) * mouseBuffer.size()
+        );
+    }
+    m_polygonVBO.release();
+
+    // Overwrite the texture vertex buffer object data
+    m_textureVBO.bind();
+    m_textureVBO.allocate(
+        &(m_view->getTextureCpuBuffer()->front()),
+        sizeof(TriangleTexture) * m_view->getTextureCpuBuffer()->size()
+    );
+    m_textureVBO.release();
+}
+
+LayoutType MapRenderer::getEffectiveLayoutType() const {
+    // The zoomed map follows the mouse, so without one we show the full map
+    if (m_layoutType == LayoutType::FULL || m_mouseGraphic == nullptr) {
+        return LayoutType::FULL;
+    }
+    return LayoutType::ZOOMED;
+}
+
+QPair<double, double> MapRenderer::getPhysicalMazeSize() const {
+    // Get the physical size of the maze (in meters)
+    double physicalMazeWidth = P()->wallWidth() + m_maze->getWidth() * (P()->wallWidth() + P()->wallLength());
+    double physicalMazeHeight = P()->wallWidth() + m_maze->getHeight() * (P()->wallWidth() + P()->wallLength());
+    // TODO: MACK - these should be distances, not doubles
+    return {physicalMazeWidth, physicalMazeHeight};
+}
+
+QMatrix4x4 MapRenderer::getTransformationMatrix(
+        LayoutType type,
+        QPair<int, int> mapPosition,
+        QPair<int, int> mapSize,
+        const Coordinate& currentMouseTranslation,
+        const Angle& currentMouseRotation) const {
+
+    QVector<float> matrix;
+
+    // Render the full map
+    if (type == LayoutType::FULL) {
+        // TODO: MACK
+        matrix = TransformationMatrix::getFullMapTransformationMatrix(
+            Distance::Meters(P()->wallWidth()),
+            getPhysicalMazeSize(),
+            mapPosition,
+            mapSize,
+            {m_windowWidth, m_windowHeight}
+        );
+    }
+
+    // Render the zoomed map
+    else {
+        // TODO: MACK
+        matrix = TransformationMatrix::getZoomedMapTransformationMatrix(
+            getPhysicalMazeSize(),
+            mapPosition,
+            mapSize,
+            {m_windowWidth, m_windowHeight},
+            Screen::get()->pixelsPerMeter(),
+            m_zoomedMapScale,
+            m_rotateZoomedMap,
+            m_mouseGraphic->getInitialMouseTranslation(),
+            currentMouseTranslation,
+            currentMouseRotation
+        );
+    }
+
+    return QMatrix4x4(
+        matrix.at(0), matrix.at(1), matrix.at(2), matrix.at(3),
+        matrix.at(4), matrix.at(5), matrix.at(6), matrix.at(7),
+        matrix.at(8), matrix.at(9), matrix.at(10), matrix.at(11),
+        matrix.at(12), matrix.at(13), matrix.at(14), matrix.at(15)
+    );
+}
+
+void MapRenderer::drawLayer(
+        TileGraphicLayer layer,
+        const QMatrix4x4& transformationMatrix,
+        QPair<int, int> mapPosition,
+        QPair<int, int> mapSize,
+        bool cullChunks) {
+    QPair<int, int> range = m_view->getGraphicCpuBufferLayer(layer);
+    drawMap(
+        &m_polygonProgram,
+        &m_polygonVAO,
+        transformationMatrix,
+        mapPosition,
+        mapSize,
+        3 * range.first,
+        3 * range.second,
+        cullChunks
+    );
+}
+
+void MapRenderer::drawMap(
+        QOpenGLShaderProgram* program,
+        QOpenGLVertexArrayObject* vao,
+        const QMatrix4x4& transformationMatrix,
+        QPair<int, int> mapPosition,
+        QPair<int, int> mapSize,
+        int vboStartingIndex,
+        int count,
+        bool cullChunks) {
+
+    // Start using the program and vertex array object
+    program->bind();
+    vao->bind();
+
+    // If it's the texture program, bind the texture and set the uniform
+    if (program == &m_textureProgram) {
+        glActiveTexture(GL_TEXTURE0);
+        m_textureAtlas->bind();
+        program->setUniformValue("texture", 0);
+    }
+
+    program->setUniformValue("transformationMatrix", transformationMatrix);
+    if (cullChunks) {
+        drawVisibleChunks(
+            transformationMatrix,
+            mapPosition,
+            mapSize,
+            vboStartingIndex,
+            count);
+    }
+    else {
+        glDrawArrays(GL_TRIANGLES, vboStartingIndex, count);
+    }
+
+    // If it's the texture program, we should additionally unbind the texture
+    if (program == &m_textureProgram) {
+        m_textureAtlas->release();
+    }
+
+    // Stop using the program and vertex array object
+    vao->release();
+}
+
+double MapRenderer::getPixelsPerMeter(LayoutType type) const {
+    // Note that these must agree with the scaling in TransformationMatrix
+    if (type == LayoutType::FULL) {
+        QPair<double, double> physicalMazeSize = getPhysicalMazeSize();
+        QPair<int, int> fullMapSize = Layout::getFullMapSize(m_windowWidth, m_windowHeight);
+        return std::min(
+            fullMapSize.first / physicalMazeSize.first,
+            fullMapSize.second / physicalMazeSize.second);
+    }
+    return Screen::get()->pixelsPerMeter() * m_zoomedMapScale;
+}
+
+QOpenGLFramebufferObject* MapRenderer::getStaticLayer(LayoutType type) {
+
+    if (m_staticLayersDirty) {
+        deleteStaticLayers();
+        m_staticLayersDirty = false;
+    }
+
+    // A null entry means that the layer is too large to cache
+    if (m_staticLayers.contains(type)) {
+        return m_staticLayers.value(type);
+    }
+
+    // Render the layer at the same resolution at which it will be displayed
+    QPair<double, double> physicalMazeSize = getPhysicalMazeSize();
+    double pixelsPerMeter = getPixelsPerMeter(type);
+    int width = static_cast<int>(std::ceil(pixelsPerMeter * physicalMazeSize.first));
+    int height = static_cast<int>(std::ceil(pixelsPerMeter * physicalMazeSize.second));
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    if (width < 1 || height < 1 || maxTextureSize < width || maxTextureSize < height) {
+        m_staticLayers.insert(type, nullptr);
+        return nullptr;
+    }
+
+    // Note that we restore whichever framebuffer was bound beforehand, rather
+    // than the context's default framebuffer, since we may be rendering into
+    // an offscreen framebuffer object
+    GLint framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &framebuffer);
+    QOpenGLFramebufferObject* staticLayer = new QOpenGLFramebufferObject(width, height);
+    staticLayer->bind();
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glViewport(0, 0, width, height);
+    glClearColor(0.0, 0.0, 0.0, 0.0);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glClearColor(0.0, 0.0, 0.0, 1.0);
+
+    // Map the physical maze, whose origin is in the middle of the lower left
+    // corner, onto the entirety of the framebuffer
+    QMatrix4x4 transformationMatrix;
+    transformationMatrix.translate(-1.0, -1.0);
+    transformationMatrix.scale(2.0 / physicalMazeSize.first, 2.0 / physicalMazeSize.second);
+    transformationMatrix.translate(0.5 * P()->wallWidth(), 0.5 * P()->wallWidth());
+
+    // The corners never change, and neither do the true walls
+    if (m_view->getMazeGraphic()->isWallTruthVisible()) {
+        drawLayer(TileGraphicLayer::WALLS, transformationMatrix, {0, 0}, {width, height}, false);
+    }
+    drawLayer(TileGraphicLayer::CORNERS, transformationMatrix, {0, 0}, {width, height}, false);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+    m_staticLayers.insert(type, staticLayer);
+    return staticLayer;
+}
+
+void MapRenderer::drawStaticLayer(
+        QOpenGLFramebufferObject* staticLayer,
+        const QMatrix4x4& transformationMatrix) {
+
+    // The quad covers the entire physical maze
+    QPair<double, double> physicalMazeSize = getPhysicalMazeSize();
+    double left = -0.5 * P()->wallWidth();
+    double bottom = -0.5 * P()->wallWidth();
+    double right = left + physicalMazeSize.first;
+    double top = bottom + physicalMazeSize.second;
+    TriangleTexture quad[] = {
+        {{left, bottom, 0.0, 0.0}, {left, top, 0.0, 1.0}, {right, top, 1.0, 1.0}},
+        {{left, bottom, 0.0, 0.0}, {right, top, 1.0, 1.0}, {right, bottom, 1.0, 0.0}},
+    };
+    m_staticLayerVBO.bind();
+    m_staticLayerVBO.allocate(quad, sizeof(quad));
+    m_staticLayerVBO.release();
+
+    m_textureProgram.bind();
+    m_staticLayerVAO.bind();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, staticLayer->texture());
+    m_textureProgram.setUniformValue("texture", 0);
+    m_textureProgram.setUniformValue("transformationMatrix", transformationMatrix);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    m_staticLayerVAO.release();
+}
+
+void MapRenderer::deleteStaticLayers() {
+    for (QOpenGLFramebufferObject* staticLayer : m_staticLayers.values()) {
+        delete staticLayer;
+    }
+    m_staticLayers.clear();
+}
+
+void MapRenderer::drawVisibleChunks(
+        const QMatrix4x4& transformationMatrix,
+        QPair<int, int> mapPosition,
+        QPair<int, int> mapSize,
+        int vboStartingIndex,
+        int count) {
+
+    // The maze buffers contain the same number of vertices for every tile,
+    // and tiles are laid out column by column (see BufferInterface). Thus
+    // each column of a chunk is a contiguous run of vertices. If the buffer
+    // doesn't have that shape, fall back to drawing everything.
+    int mazeWidth = m_maze->getWidth();
+    int mazeHeight = m_maze->getHeight();
+    int numTiles = mazeWidth * mazeHeight;
+    if (count == 0 || numTiles == 0 || count % numTiles != 0) {
+        glDrawArrays(GL_TRIANGLES, vboStartingIndex, count);
+        return;
+    }
+    int verticesPerTile = count / numTiles;
+
+    // The region of the window, in OpenGL coordinates, that the map occupies
+    double viewportLeft = 2.0 * mapPosition.first / m_windowWidth - 1.0;
+    double viewportBottom = 2.0 * mapPosition.second / m_windowHeight - 1.0;
+    double viewportRight = 2.0 * (mapPosition.first + mapSize.first) / m_windowWidth - 1.0;
+    double viewportTop = 2.0 * (mapPosition.second + mapSize.second) / m_windowHeight - 1.0;
+
+    // Each chunk covers CHUNK_SIZE x CHUNK_SIZE tiles, padded by a wall width
+    // so that the posts and walls on the chunk boundary are accounted for
+    double tileLength = P()->wallWidth() + P()->wallLength();
+    double chunkLength = CHUNK_SIZE * tileLength;
+    double padding = P()->wallWidth();
+    int numChunksX = (mazeWidth + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    int numChunksY = (mazeHeight + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    for (int cx = 0; cx < numChunksX; cx += 1) {
+
+        // Since the visible region is convex, the visible chunks within a
+        // chunk column form a single contiguous range
+        int minChunkY = numChunksY;
+        int maxChunkY = -1;
+        for (int cy = 0; cy < numChunksY; cy += 1) {
+            double chunkLeft = cx * chunkLength - padding;
+            double chunkBottom = cy * chunkLength - padding;
+            double chunkRight = (cx + 1) * chunkLength + padding;
+            double chunkTop = (cy + 1) * chunkLength + padding;
+            QPointF corners[] = {
+                transformationMatrix.map(QPointF(chunkLeft, chunkBottom)),
+                transformationMatrix.map(QPointF(chunkRight, chunkBottom)),
+                transformationMatrix.map(QPointF(chunkLeft, chunkTop)),
+                transformationMatrix.map(QPointF(chunkRight, chunkTop)),
+            };
+            double left = corners[0].x();
+            double right = corners[0].x();
+            double bottom = corners[0].y();
+            double top = corners[0].y();
+            for (const QPointF& corner : corners) {
+                left = std::min(left, corner.x());
+                right = std::max(right, corner.x());
+                bottom = std::min(bottom, corner.y());
+                top = std::max(top, corner.y());
+            }
+            if (right < viewportLeft || viewportRight < left ||
+                top < viewportBottom || viewportTop < bottom) {
+                continue;
+            }
+            minChunkY = std::min(minChunkY, cy);
+            maxChunkY = std::max(maxChunkY, cy);
+        }
+        if (maxChunkY < minChunkY) {
+            continue;
+        }
+
+        // Draw one contiguous run of tiles for each column of the chunks
+        int minY = minChunkY * CHUNK_SIZE;
+        int maxY = std::min(mazeHeight, (maxChunkY + 1) * CHUNK_SIZE);
+        int maxX = std::min(mazeWidth, (cx + 1) * CHUNK_SIZE);
+        for (int x = cx * CHUNK_SIZE; x < maxX; x += 1) {
+            glDrawArrays(
+                GL_TRIANGLES,
+                vboStartingIndex + verticesPerTile * (mazeHeight * x + minY),
+                verticesPerTile * (maxY - minY));
+        }
+    }
+}
+
+} // namespace mms
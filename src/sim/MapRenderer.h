@@ -0,0 +1,142 @@
+#pragma once
+
+#include <QMap>
+#include <QMatrix4x4>
+#include <QOpenGLBuffer>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLTexture>
+#include <QOpenGLVertexArrayObject>
+#include <QPair>
+#include <QVector>
+
+#include "LayoutType.h"
+#include "Maze.h"
+#include "MazeView.h"
+#include "MouseGraphic.h"
+#include "TileGraphicLayer.h"
+#include "TriangleGraphic.h"
+
+namespace mms {
+
+// Draws a maze view (and optionally a mouse) into whichever framebuffer is
+// currently bound. It doesn't own an OpenGL context, so it can be used by
+// both the on-screen Map widget and offscreen exports. All methods other than
+// the setters require the context used for initialization to be current.
+class MapRenderer : protected QOpenGLFunctions {
+
+public:
+
+    MapRenderer();
+
+    void setMaze(const Maze* maze);
+    void setView(const MazeView* view);
+    void setMouseGraphic(const MouseGraphic* mouseGraphic);
+
+    // Mice drawn alongside the followed one, e.g., a rival in a race
+    void setOtherMouseGraphics(const QVector<const MouseGraphic*>& mouseGraphics);
+
+    void setLayoutType(LayoutType layoutType);
+    void setZoomedMapScale(double zoomedMapScale);
+    void setRotateZoomedMap(bool rotateZoomedMap);
+
+    // Whether frame timings are reported to Instrumentation
+    void setInstrumented(bool instrumented);
+
+    // Forces the static layer (the corners, and the walls when the wall
+    // truth is visible) to be re-rendered on the next render
+    void invalidateStaticLayers();
+
+    void initialize();
+    void resize(int width, int height);
+    void render();
+    void shutdown();
+
+private:
+
+    // No ownership here - only pointers
+    const Maze* m_maze;
+    const MazeView* m_view;
+    const MouseGraphic* m_mouseGraphic;
+    QVector<const MouseGraphic*> m_otherMouseGraphics;
+
+    // The size of the render target, in pixels
+    int m_windowWidth;
+    int m_windowHeight;
+
+    // The side length, in tiles, of the chunks that are culled against
+    // the zoomed map viewport
+    static const int CHUNK_SIZE;
+
+    // Some display knobs
+    LayoutType m_layoutType;
+    double m_zoomedMapScale;
+    bool m_rotateZoomedMap;
+
+    // Polygon program variables
+    QOpenGLShaderProgram m_polygonProgram;
+    QOpenGLVertexArrayObject m_polygonVAO;
+    QOpenGLBuffer m_polygonVBO;
+
+    // Cached renderings of the static parts of the maze, per layout type
+    QMap<LayoutType, QOpenGLFramebufferObject*> m_staticLayers;
+    bool m_staticLayersDirty;
+    QOpenGLVertexArrayObject m_staticLayerVAO;
+    QOpenGLBuffer m_staticLayerVBO;
+
+    bool m_instrumented;
+
+    // Texture program variables
+    QOpenGLTexture* m_textureAtlas;
+    QOpenGLShaderProgram m_textureProgram;
+    QOpenGLVertexArrayObject m_textureVAO;
+    QOpenGLBuffer m_textureVBO;
+
+    // Initialize the graphics
+    void initPolygonProgram();
+    void initTextureProgram();
+
+    // Drawing helper methods
+    void repopulateVertexBufferObjects(
+        const QVector<TriangleGraphic>& mouseBuffer);
+    LayoutType getEffectiveLayoutType() const;
+    QPair<double, double> getPhysicalMazeSize() const;
+    QMatrix4x4 getTransformationMatrix(
+        LayoutType type,
+        QPair<int, int> mapPosition,
+        QPair<int, int> mapSize,
+        const Coordinate& currentMouseTranslation,
+        const Angle& currentMouseRotation) const;
+    void drawLayer(
+        TileGraphicLayer layer,
+        const QMatrix4x4& transformationMatrix,
+        QPair<int, int> mapPosition,
+        QPair<int, int> mapSize,
+        bool cullChunks);
+    void drawMap(
+        QOpenGLShaderProgram* program,
+        QOpenGLVertexArrayObject* vao,
+        const QMatrix4x4& transformationMatrix,
+        QPair<int, int> mapPosition,
+        QPair<int, int> mapSize,
+        int vboStartingIndex,
+        int count,
+        bool cullChunks);
+    void drawVisibleChunks(
+        const QMatrix4x4& transformationMatrix,
+        QPair<int, int> mapPosition,
+        QPair<int, int> mapSize,
+        int vboStartingIndex,
+        int count);
+
+    // Static layer helper methods
+    double getPixelsPerMeter(LayoutType type) const;
+    QOpenGLFramebufferObject* getStaticLayer(LayoutType type);
+    void drawStaticLayer(
+        QOpenGLFramebufferObject* staticLayer,
+        const QMatrix4x4& transformationMatrix);
+    void deleteStaticLayers();
+};
+
+} // namespace mms
@@ -1,11 +1,15 @@
 #pragma once
 
 #include <QByteArray>
+#include <QPair>
 #include <QVector>
 
-#include "BasicMaze.h"
 #include "Direction.h"
+#include "DistanceField.h"
+#include "MazeChecker.h"
 #include "Tile.h"
+#include "WallGrid.h"
+#include "WallGridView.h"
 
 namespace mms {
 
@@ -15,15 +19,31 @@ public:
 
     static Maze* fromFile(const QString& path);
     static Maze* fromAlgo(const QByteArray& bytes);
+    static Maze* fromWallGrid(const WallGrid& walls);
+
+    // A rotated and/or mirrored copy of this maze (see MazeSymmetry) that
+    // shares this maze's wall storage
+    Maze* transformed(int symmetry) const;
     
     int getWidth() const;
     int getHeight() const;
     bool withinMaze(int x, int y) const;
-    const Tile* getTile(int x, int y) const;
+    Tile getTile(int x, int y) const;
+    bool isWall(int x, int y, Direction direction) const;
+    int getDistance(int x, int y) const;
+    const WallGridView& getWalls() const;
 
     int getMaximumDistance() const;
+
+    // A distance field over the walls of this maze, e.g., to goals other
+    // than the center, or with turn costs; getDistance() is the field to the
+    // center with unit costs
+    DistanceField getDistanceField(
+        const QVector<QPair<int, int>>& goals,
+        const DistanceFieldCosts& costs = DistanceFieldCosts()) const;
     bool isValidMaze() const;
     bool isOfficialMaze() const;
+    const QVector<MazeCheckIssue>& getCheckIssues() const;
     bool isCenterTile(int x, int y) const;
     Direction getOptimalStartingDirection() const;
 
@@ -31,24 +51,23 @@ private:
 
     // Private constructor forces clients to construct
     // a maze using one of the public static methods
-    explicit Maze(BasicMaze basicMaze);
+    explicit Maze(const WallGridView& walls);
+
+    // The orientation given by the maze-mirrored and maze-rotations params,
+    // applied to mazes loaded from files and algorithms
+    static WallGridView orient(const WallGrid& walls);
+
+    // The walls of all of the tiles, as seen in this maze's orientation
+    WallGridView m_walls;
 
-    // Vector to hold all of the tiles
-    QVector<QVector<Tile>> m_maze;
+    // The distance of each tile from the center, in the same row-major
+    // order as the wall view, or -1 if the tile is unreachable
+    QVector<int> m_distances;
 
     // Cache results to these functions
     bool m_isValidMaze;
     bool m_isOfficialMaze;
-
-    // Initializes all of the tiles of the basic maze
-    static QVector<QVector<Tile>> initializeFromBasicMaze(const BasicMaze& basicMaze);
-
-    // Basic maze geometric transformations
-    static BasicMaze mirrorAcrossVertical(const BasicMaze& basicMaze);
-    static BasicMaze rotateCounterClockwise(const BasicMaze& basicMaze);
-
-    // (Re)set the distance values for the tiles in maze that are reachable from the center
-    static QVector<QVector<Tile>> setTileDistances(QVector<QVector<Tile>> maze);
+    QVector<MazeCheckIssue> m_checkIssues;
 };
 
 } // namespace mms
@@ -0,0 +1,346 @@
+#include "MazeAnalyzer.h"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+#include "DistanceField.h"
+#include "MazeChecker.h"
+#include "MazeFileUtilities.h"
+#include "MazeUtilities.h"
+#include "Mouse.h"
+#include "ParallelUtilities.h"
+#include "Param.h"
+
+namespace mms {
+
+bool MazeAnalyzer::getMouseSpeeds(const QString& mouseFile, MouseSpeeds* speeds) {
+    // The mouse only needs a maze for its sensors, so any maze will do
+    Maze* maze = Maze::fromWallGrid(WallGrid(1, 1));
+    Mouse mouse(maze);
+    bool success = mouse.reload(mouseFile);
+    if (success) {
+        speeds->metersPerSecond = std::abs(mouse.getMaxForwardSpeed().getMetersPerSecond());
+        speeds->radiansPerSecond = std::abs(mouse.getMaxTurnRate().getRadiansPerSecond());
+    }
+    else {
+        qWarning().noquote().nospace()
+            << "Unable to load mouse file \"" << mouseFile << "\".";
+    }
+    delete maze;
+    return success;
+}
+
+MazeMetrics MazeAnalyzer::analyze(const Maze& maze, const MouseSpeeds* speeds) {
+
+    MazeMetrics metrics;
+    metrics.width = maze.getWidth();
+    metrics.height = maze.getHeight();
+    metrics.isValid = maze.isValidMaze();
+    metrics.isOfficial = maze.isOfficialMaze();
+    metrics.maxDistance = maze.getMaximumDistance();
+    metrics.shortestPath = -1;
+    metrics.diagonalPath = -1;
+    metrics.optimalTurns = -1;
+    metrics.deadEnds = 0;
+    metrics.branchFactor = 0.0;
+    metrics.longestStraightaway = 0;
+    metrics.solvableByWallFollower = false;
+    metrics.optimalRunTime = -1.0;
+    if (maze.getWidth() == 0 || maze.getHeight() == 0) {
+        return metrics;
+    }
+
+    metrics.shortestPath = maze.getDistance(0, 0);
+    DistanceFieldCosts diagonalCosts;
+    diagonalCosts.allowDiagonals = true;
+    metrics.diagonalPath = maze.getDistanceField(
+        MazeUtilities::getCenterPositions(maze.getWidth(), maze.getHeight()),
+        diagonalCosts).getDistance(0, 0);
+    metrics.optimalTurns = getOptimalTurns(maze);
+    for (const MazeCheckIssue& issue : maze.getCheckIssues()) {
+        if (issue.failure == MazeCheckFailure::SOLVABLE_BY_WALL_FOLLOWER) {
+            metrics.solvableByWallFollower = true;
+        }
+    }
+
+    // Everything that can be counted tile by tile
+    int numReachable = 0;
+    int numWaysOnward = 0;
+    for (int y = 0; y < maze.getHeight(); y += 1) {
+        int straightaway = 0;
+        for (int x = 0; x < maze.getWidth(); x += 1) {
+            int numWalls = 0;
+            for (Direction direction : DIRECTIONS()) {
+                if (maze.isWall(x, y, direction)) {
+                    numWalls += 1;
+                }
+            }
+            if (numWalls == 3) {
+                metrics.deadEnds += 1;
+            }
+            if (maze.getDistance(x, y) != -1) {
+                numReachable += 1;
+                numWaysOnward += std::max(4 - numWalls - 1, 0);
+            }
+            straightaway = 0 < x && !maze.isWall(x, y, Direction::WEST) ? straightaway + 1 : 1;
+            metrics.longestStraightaway = std::max(metrics.longestStraightaway, straightaway);
+        }
+    }
+    for (int x = 0; x < maze.getWidth(); x += 1) {
+        int straightaway = 0;
+        for (int y = 0; y < maze.getHeight(); y += 1) {
+            straightaway = 0 < y && !maze.isWall(x, y, Direction::SOUTH) ? straightaway + 1 : 1;
+            metrics.longestStraightaway = std::max(metrics.longestStraightaway, straightaway);
+        }
+    }
+    if (0 < numReachable) {
+        metrics.branchFactor = static_cast<double>(numWaysOnward) / numReachable;
+    }
+
+    if (speeds != nullptr && metrics.shortestPath != -1) {
+        metrics.optimalRunTime = getOptimalRunTime(maze, *speeds);
+    }
+
+    return metrics;
+}
+
+QVector<QPair<QString, MazeMetrics>> MazeAnalyzer::analyzeDirectories(
+        const QStringList& directories,
+        const MouseSpeeds* speeds) {
+
+    QStringList mazeFiles = MazeFileUtilities::findMazeFiles(directories);
+    QVector<MazeMetrics> metrics(mazeFiles.size());
+    QVector<bool> loaded(mazeFiles.size(), false);
+
+    // Each index is only ever written by the thread that claimed it
+    ParallelUtilities::forEachIndex(mazeFiles.size(), [&](int i){
+        WallGrid walls;
+        try {
+            walls = MazeFileUtilities::load(mazeFiles.at(i));
+        }
+        catch (const std::exception& e) {
+            qWarning().noquote().nospace()
+                << "Skipping maze file \"" << mazeFiles.at(i) << "\": "
+                << e.what() << ".";
+            return;
+        }
+        Maze* maze = Maze::fromWallGrid(walls);
+        metrics[i] = analyze(*maze, speeds);
+        loaded[i] = true;
+        delete maze;
+    });
+
+    QVector<QPair<QString, MazeMetrics>> results;
+    for (int i = 0; i < mazeFiles.size(); i += 1) {
+        if (loaded.at(i)) {
+            results.append({mazeFiles.at(i), metrics.at(i)});
+        }
+    }
+    return results;
+}
+
+QString MazeAnalyzer::toCsv(const QVector<QPair<QString, MazeMetrics>>& results) {
+    QStringList lines;
+    lines.append(
+        "file,width,height,valid,official,max_distance,shortest_path,"
+        "diagonal_path,optimal_turns,dead_ends,branch_factor,longest_straightaway,"
+        "wall_follower_solvable,optimal_run_time"
+    );
+    for (const auto& result : results) {
+        const MazeMetrics& metrics = result.second;
+        QString file = result.first;
+        file.replace("\"", "\"\"");
+        lines.append(QStringList({
+            "\"" + file + "\"",
+            QString::number(metrics.width),
+            QString::number(metrics.height),
+            metrics.isValid ? "true" : "false",
+            metrics.isOfficial ? "true" : "false",
+            QString::number(metrics.maxDistance),
+            QString::number(metrics.shortestPath),
+            QString::number(metrics.diagonalPath),
+            QString::number(metrics.optimalTurns),
+            QString::number(metrics.deadEnds),
+            QString::number(metrics.branchFactor, 'f', 4),
+            QString::number(metrics.longestStraightaway),
+            metrics.solvableByWallFollower ? "true" : "false",
+            QString::number(metrics.optimalRunTime, 'f', 3),
+        }).join(","));
+    }
+    return lines.join("\n") + "\n";
+}
+
+QString MazeAnalyzer::toJson(const QVector<QPair<QString, MazeMetrics>>& results) {
+    QJsonArray array;
+    for (const auto& result : results) {
+        const MazeMetrics& metrics = result.second;
+        QJsonObject object;
+        object.insert("file", result.first);
+        object.insert("width", metrics.width);
+        object.insert("height", metrics.height);
+        object.insert("valid", metrics.isValid);
+        object.insert("official", metrics.isOfficial);
+        object.insert("maxDistance", metrics.maxDistance);
+        object.insert("shortestPath", metrics.shortestPath);
+        object.insert("diagonalPath", metrics.diagonalPath);
+        object.insert("optimalTurns", metrics.optimalTurns);
+        object.insert("deadEnds", metrics.deadEnds);
+        object.insert("branchFactor", metrics.branchFactor);
+        object.insert("longestStraightaway", metrics.longestStraightaway);
+        object.insert("wallFollowerSolvable", metrics.solvableByWallFollower);
+        object.insert("optimalRunTime", metrics.optimalRunTime);
+        array.append(object);
+    }
+    return QString::fromUtf8(QJsonDocument(array).toJson());
+}
+
+int MazeAnalyzer::report(
+        const QStringList& directories,
+        const QString& mouseFile,
+        const QString& path) {
+
+    MouseSpeeds speeds;
+    bool hasSpeeds = !mouseFile.isEmpty();
+    if (hasSpeeds && !getMouseSpeeds(mouseFile, &speeds)) {
+        return -1;
+    }
+
+    QVector<QPair<QString, MazeMetrics>> results =
+        analyzeDirectories(directories, hasSpeeds ? &speeds : nullptr);
+    bool json = QFileInfo(path).suffix().compare("json", Qt::CaseInsensitive) == 0;
+    QByteArray output = (json ? toJson(results) : toCsv(results)).toUtf8();
+
+    if (path.isEmpty()) {
+        QTextStream(stdout) << output;
+        return results.size();
+    }
+    QSaveFile file(path);
+    if (
+        !file.open(QIODevice::WriteOnly) ||
+        file.write(output) != output.size() ||
+        !file.commit()
+    ) {
+        qWarning().noquote().nospace()
+            << "Unable to write maze analysis to \"" << path << "\".";
+        return -1;
+    }
+    qInfo().noquote().nospace()
+        << "Analyzed " << results.size() << " mazes into \"" << path << "\".";
+    return results.size();
+}
+
+void MazeAnalyzer::addOptions(QCommandLineParser* parser) {
+    parser->addOptions({
+        {
+            "analyze",
+            "Compute difficulty metrics of the maze files found in <directories>.",
+        },
+        {
+            "mouse-file",
+            "Estimate optimal run times for the mouse <file>, for --analyze.",
+            "file",
+        },
+    });
+}
+
+int MazeAnalyzer::runFromArguments(const QCommandLineParser& parser) {
+    int count = report(
+        parser.positionalArguments(),
+        parser.value("mouse-file"),
+        parser.value("output")
+    );
+    return count < 0 ? 1 : 0;
+}
+
+int MazeAnalyzer::getOptimalTurns(const Maze& maze) {
+
+    // Along a shortest path every move goes one tile closer to the center, so
+    // the fewest turns can be found by dynamic programming outward from the
+    // center, tracking the direction of the first move out of each tile
+    int width = maze.getWidth();
+    int height = maze.getHeight();
+    if (maze.getDistance(0, 0) == -1) {
+        return -1;
+    }
+    QVector<QVector<int>> tilesByDistance(maze.getMaximumDistance() + 1);
+    for (int y = 0; y < height; y += 1) {
+        for (int x = 0; x < width; x += 1) {
+            int distance = maze.getDistance(x, y);
+            if (distance != -1) {
+                tilesByDistance[distance].append(y * width + x);
+            }
+        }
+    }
+
+    const int infinity = std::numeric_limits<int>::max() / 2;
+    int numDirections = DIRECTIONS().size();
+    QVector<int> turns(width * height * numDirections, infinity);
+    for (int tile : tilesByDistance.at(0)) {
+        for (int i = 0; i < numDirections; i += 1) {
+            turns[tile * numDirections + i] = 0;
+        }
+    }
+    for (int distance = 1; distance < tilesByDistance.size(); distance += 1) {
+        for (int tile : tilesByDistance.at(distance)) {
+            int x = tile % width;
+            int y = tile / width;
+            for (int i = 0; i < numDirections; i += 1) {
+                Direction direction = DIRECTIONS().at(i);
+                QPair<int, int> next =
+                    MazeUtilities::positionAfterMovingForward({x, y}, direction);
+                if (
+                    maze.isWall(x, y, direction) ||
+                    !maze.withinMaze(next.first, next.second) ||
+                    maze.getDistance(next.first, next.second) != distance - 1
+                ) {
+                    continue;
+                }
+                int nextTile = next.second * width + next.first;
+                int best = infinity;
+                for (int j = 0; j < numDirections; j += 1) {
+                    int turn = (distance - 1 == 0 || i == j) ? 0 : 1;
+                    best = std::min(best, turns.at(nextTile * numDirections + j) + turn);
+                }
+                turns[tile * numDirections + i] = best;
+            }
+        }
+    }
+
+    int best = infinity;
+    for (int i = 0; i < numDirections; i += 1) {
+        best = std::min(best, turns.at(i));
+    }
+    return best;
+}
+
+double MazeAnalyzer::getOptimalRunTime(const Maze& maze, const MouseSpeeds& speeds) {
+    if (speeds.metersPerSecond <= 0.0 || speeds.radiansPerSecond <= 0.0) {
+        return -1.0;
+    }
+    // The distance field costs are integers, so times are in tenths of a
+    // millisecond; a turn cost is per 45 degrees of turning in place
+    const double unitsPerSecond = 10000.0;
+    double tileLength = P()->wallLength() + P()->wallWidth();
+    DistanceFieldCosts costs;
+    costs.straight = std::max(1, static_cast<int>(std::round(
+        tileLength / speeds.metersPerSecond * unitsPerSecond)));
+    costs.turn = static_cast<int>(std::round(
+        M_PI / 4.0 / speeds.radiansPerSecond * unitsPerSecond));
+    DistanceField field = maze.getDistanceField(
+        MazeUtilities::getCenterPositions(maze.getWidth(), maze.getHeight()),
+        costs);
+    int time = field.getDistance(0, 0);
+    return time == -1 ? -1.0 : time / unitsPerSecond;
+}
+
+} // namespace mms
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QCommandLineParser>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "Maze.h"
+
+namespace mms {
+
+// Metrics for judging how hard a maze is; distances are in tiles, and -1
+// means that the center can't be reached from the start
+struct MazeMetrics {
+    int width;
+    int height;
+    bool isValid;
+    bool isOfficial;
+    int maxDistance;
+    // Moves along the shortest path from the start to the center
+    int shortestPath;
+    // Moves along the shortest path when diagonal moves, between two posts,
+    // are allowed too; the fewer than shortestPath, the more diagonals
+    int diagonalPath;
+    // The fewest turns along any shortest path
+    int optimalTurns;
+    // Tiles with exactly three walls
+    int deadEnds;
+    // The mean number of ways onward (open sides, less the way in) of the
+    // tiles that are reachable from the center
+    double branchFactor;
+    // The most tiles in a single straight line without a wall in between
+    int longestStraightaway;
+    bool solvableByWallFollower;
+    // The least time, in seconds, for a mouse to drive from the start to the
+    // center at full speed, turning in place; -1 if there's no mouse
+    double optimalRunTime;
+};
+
+// How fast a mouse drives, for estimating run times
+struct MouseSpeeds {
+    double metersPerSecond;
+    double radiansPerSecond;
+};
+
+class MazeAnalyzer {
+
+public:
+
+    MazeAnalyzer() = delete;
+
+    // Reads the top forward speed and turn rate of a mouse file; returns
+    // false if the mouse couldn't be loaded
+    static bool getMouseSpeeds(const QString& mouseFile, MouseSpeeds* speeds);
+
+    // Computes the metrics of a maze; the run time is only estimated if the
+    // speeds are given
+    static MazeMetrics analyze(const Maze& maze, const MouseSpeeds* speeds = nullptr);
+
+    // Analyzes every maze file in the directories, recursively, on all cores.
+    // Files that can't be loaded are skipped; the rest are in path order.
+    static QVector<QPair<QString, MazeMetrics>> analyzeDirectories(
+        const QStringList& directories,
+        const MouseSpeeds* speeds = nullptr);
+
+    static QString toCsv(const QVector<QPair<QString, MazeMetrics>>& results);
+    static QString toJson(const QVector<QPair<QString, MazeMetrics>>& results);
+
+    // Analyzes the directories and writes the results to the file, as JSON if
+    // its suffix is "json" and as CSV otherwise, or to stdout if the path is
+    // empty. Returns the number of mazes analyzed, or -1 on failure.
+    static int report(
+        const QStringList& directories,
+        const QString& mouseFile,
+        const QString& path);
+
+    // The options of --analyze, and running it with them as parsed, which
+    // returns the exit code
+    static void addOptions(QCommandLineParser* parser);
+    static int runFromArguments(const QCommandLineParser& parser);
+
+private:
+
+    static int getOptimalTurns(const Maze& maze);
+    static double getOptimalRunTime(const Maze& maze, const MouseSpeeds& speeds);
+};
+
+} // namespace mms
@@ -0,0 +1,216 @@
+#include "MazeBenchmark.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPair>
+#include <QString>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QVector>
+
+#include <random>
+
+#include "Direction.h"
+#include "LayoutType.h"
+#include "MapExporter.h"
+#include "Maze.h"
+#include "MazeFileType.h"
+#include "MazeFileUtilities.h"
+#include "MazeView.h"
+
+namespace mms {
+
+int MazeBenchmark::run(int size, double timeBudget, bool skipRender) {
+
+    QTextStream out(stdout);
+    QVector<QPair<QString, double>> phases;
+    bool success = true;
+    QElapsedTimer timer;
+
+    timer.start();
+    WallGrid walls = generate(size, SEED);
+    phases.append({"generate", timer.nsecsElapsed() / 1e9});
+
+    // Round-trip the maze through each file type that can hold it
+    QTemporaryDir directory;
+    if (!directory.isValid()) {
+        qWarning().noquote().nospace()
+            << "Unable to create a temporary directory for the benchmark.";
+        return 1;
+    }
+    for (MazeFileType type : MAZE_FILE_TYPE_TO_SUFFIX().keys()) {
+        if (type == MazeFileType::MAZ && size != 16) {
+            continue;
+        }
+        QString suffix = MAZE_FILE_TYPE_TO_SUFFIX().value(type);
+        QString path = directory.filePath("maze." + suffix);
+        try {
+            timer.restart();
+            MazeFileUtilities::save(walls, path, type);
+            phases.append({"save " + suffix, timer.nsecsElapsed() / 1e9});
+            timer.restart();
+            WallGrid loaded = MazeFileUtilities::load(path);
+            phases.append({"load " + suffix, timer.nsecsElapsed() / 1e9});
+            if (loaded != walls) {
+                qWarning().noquote().nospace()
+                    << "The " << suffix << " round trip changed the maze.";
+                success = false;
+            }
+        }
+        catch (const std::exception& e) {
+            qWarning().noquote().nospace()
+                << "Unable to round-trip the maze through a " << suffix
+                << " file: " << QString(e.what()) << ".";
+            success = false;
+        }
+    }
+
+    // Validate the maze, which includes computing its distances
+    timer.restart();
+    Maze* maze = Maze::fromWallGrid(walls);
+    phases.append({"validate", timer.nsecsElapsed() / 1e9});
+    if (!maze->isValidMaze()) {
+        qWarning().noquote().nospace() << "The benchmark maze is invalid.";
+        success = false;
+    }
+
+    // Fill the vertex buffers, with the same options as the truth view
+    timer.restart();
+    MazeView* view = new MazeView(maze, true, false, false, true, true);
+    phases.append({"build view", timer.nsecsElapsed() / 1e9});
+
+    // Render it, unless asked not to; a render that can't happen is a failure,
+    // lest a machine without OpenGL pass the benchmark without rendering
+    if (!skipRender) {
+        MapExporter exporter;
+        exporter.setScene(maze, view, nullptr, LayoutType::FULL);
+        timer.restart();
+        QImage image = exporter.render(RENDER_SIZE, RENDER_SIZE);
+        if (image.isNull()) {
+            qWarning().noquote().nospace()
+                << "Unable to render offscreen; pass --skip-render to "
+                << "benchmark without rendering.";
+            success = false;
+        }
+        else {
+            phases.append({"render", timer.nsecsElapsed() / 1e9});
+        }
+    }
+    delete view;
+    delete maze;
+
+    double total = 0.0;
+    out << "Benchmark of a " << size << "x" << size << " maze:\n";
+    for (const QPair<QString, double>& phase : phases) {
+        out << "    " << phase.first.leftJustified(12) << " "
+            << QString::number(phase.second, 'f', 3) << " s\n";
+        total += phase.second;
+    }
+    out << "    " << QString("total").leftJustified(12) << " "
+        << QString::number(total, 'f', 3) << " s (budget "
+        << QString::number(timeBudget, 'f', 3) << " s)\n";
+    out.flush();
+
+    if (timeBudget < total) {
+        qWarning().noquote().nospace()
+            << "The benchmark exceeded its time budget.";
+        success = false;
+    }
+    return success ? 0 : 1;
+}
+
+void MazeBenchmark::addOptions(QCommandLineParser* parser) {
+    parser->addOptions({
+        {
+            "benchmark",
+            "Time saving, loading, validating and rendering a 512x512 maze.",
+        },
+        {
+            "time-budget",
+            "Fail the --benchmark if it takes longer than <seconds> (default 10).",
+            "seconds",
+            "10",
+        },
+        {
+            "skip-render",
+            "Leave out the render phase of the --benchmark, e.g., without OpenGL.",
+        },
+    });
+}
+
+int MazeBenchmark::runFromArguments(const QCommandLineParser& parser) {
+    bool ok = false;
+    double timeBudget = parser.value("time-budget").toDouble(&ok);
+    if (!ok || timeBudget <= 0.0) {
+        qWarning().noquote().nospace()
+            << "Invalid time budget \"" << parser.value("time-budget") << "\".";
+        return 1;
+    }
+    return run(MAZE_SIZE, timeBudget, parser.isSet("skip-render"));
+}
+
+WallGrid MazeBenchmark::generate(int size, unsigned int seed) {
+
+    // Start with every wall, and then carve passages with an explicit stack,
+    // since the recursion would be hundreds of thousands of frames deep
+    WallGrid walls(size, size);
+    for (int x = 0; x < size; x += 1) {
+        for (int y = 0; y < size; y += 1) {
+            walls.setWalls(x, y, 0x0f);
+        }
+    }
+    std::mt19937 generator(seed);
+    QVector<bool> visited(size * size, false);
+    QVector<int> stack;
+    stack.reserve(size * size);
+    stack.append(0);
+    visited[0] = true;
+    while (!stack.isEmpty()) {
+        int x = stack.last() % size;
+        int y = stack.last() / size;
+        Direction directions[4];
+        int count = 0;
+        for (Direction direction : DIRECTIONS()) {
+            QPair<int, int> next = getNeighbor(x, y, direction);
+            if (
+                walls.withinGrid(next.first, next.second) &&
+                !visited.at(next.second * size + next.first)
+            ) {
+                directions[count] = direction;
+                count += 1;
+            }
+        }
+        if (count == 0) {
+            stack.removeLast();
+            continue;
+        }
+        Direction direction = directions[generator() % count];
+        QPair<int, int> next = getNeighbor(x, y, direction);
+        walls.setWall(x, y, direction, false);
+        walls.setWall(
+            next.first,
+            next.second,
+            DIRECTION_OPPOSITE().value(direction),
+            false);
+        visited[next.second * size + next.first] = true;
+        stack.append(next.second * size + next.first);
+    }
+    return walls;
+}
+
+QPair<int, int> MazeBenchmark::getNeighbor(int x, int y, Direction direction) {
+    switch (direction) {
+        case Direction::NORTH:
+            return {x, y + 1};
+        case Direction::EAST:
+            return {x + 1, y};
+        case Direction::SOUTH:
+            return {x, y - 1};
+        case Direction::WEST:
+            return {x - 1, y};
+    }
+    return {x, y};
+}
+
+} // namespace mms
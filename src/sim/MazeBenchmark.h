@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QCommandLineParser>
+#include <QPair>
+
+#include "Direction.h"
+#include "WallGrid.h"
+
+namespace mms {
+
+// Times the full pipeline for a large maze: saving it to and loading it back
+// from each file type that supports its size, validating it, building its
+// view, and rendering it offscreen
+class MazeBenchmark {
+
+public:
+
+    MazeBenchmark() = delete;
+
+    // Runs the benchmark on a generated size x size maze and prints the time
+    // of each phase. Returns 0 if every phase succeeded and the total time
+    // was within the budget (in seconds), and 1 otherwise. Rendering needs an
+    // OpenGL context, so it can be skipped, e.g., on a machine without one.
+    static int run(int size, double timeBudget, bool skipRender);
+
+    // The options of --benchmark, and running it with them as parsed, which
+    // returns the exit code
+    static void addOptions(QCommandLineParser* parser);
+    static int runFromArguments(const QCommandLineParser& parser);
+
+private:
+
+    // A perfect maze, generated by a seeded depth-first search, so that every
+    // run benchmarks the same walls
+    static WallGrid generate(int size, unsigned int seed);
+    static QPair<int, int> getNeighbor(int x, int y, Direction direction);
+
+    static const unsigned int SEED = 0;
+    // The width and height of the maze used by --benchmark
+    static const int MAZE_SIZE = 512;
+    static const int RENDER_SIZE = 2048;
+
+};
+
+} // namespace mms
@@ -1,239 +1,244 @@
 #include "MazeChecker.h"
 
-#include <QPair>
-#include <QQueue>
-
 #include "Direction.h"
+#include "DistanceField.h"
 #include "MazeUtilities.h"
 
 namespace mms {
 
-MazeValidity MazeChecker::checkMaze(const BasicMaze& maze) {
-    bool drawable =  (
-        isNonempty(maze) &&
-        isRectangular(maze)
-    );
-    if (!drawable) {
-        return MazeValidity::INVALID;
+const QMap<MazeCheckFailure, QString>& MAZE_CHECK_FAILURE_TO_STRING() {
+    static const QMap<MazeCheckFailure, QString> map = {
+        {MazeCheckFailure::EMPTY,
+            "The maze is empty"},
+        {MazeCheckFailure::NOT_ENCLOSED,
+            "The maze is not enclosed by walls"},
+        {MazeCheckFailure::INCONSISTENT_WALLS,
+            "A wall is present on only one side of an edge"},
+        {MazeCheckFailure::INACCESSIBLE_LOCATION,
+            "A tile can't be reached"},
+        {MazeCheckFailure::NOT_THREE_STARTING_WALLS,
+            "The starting tile doesn't have exactly three walls"},
+        {MazeCheckFailure::NOT_ONE_ENTRANCE_TO_CENTER,
+            "The center doesn't have exactly one entrance"},
+        {MazeCheckFailure::CENTER_NOT_HOLLOW,
+            "The center has a wall inside of it"},
+        {MazeCheckFailure::UNATTACHED_POST,
+            "A post other than the center post has no walls attached"},
+        {MazeCheckFailure::SOLVABLE_BY_WALL_FOLLOWER,
+            "The maze can be solved by a wall follower"},
+    };
+    return map;
+}
+
+MazeCheckResult MazeChecker::checkMaze(const WallGridView& walls) {
+
+    if (walls.getWidth() == 0 || walls.getHeight() == 0) {
+        return {MazeValidity::INVALID, {{MazeCheckFailure::EMPTY, {-1, -1}}}, {}};
     }
-    bool explorable = (
-        isEnclosed(maze) &&
-        hasConsistentWalls(maze)
-    );
-    if (!explorable) {
-        return MazeValidity::DRAWABLE;
+
+    // The first offending location of each kind of failure; the map keeps
+    // the failures in the order in which they're declared
+    QMap<MazeCheckFailure, QPair<int, int>> failures;
+
+    // Everything that can be checked tile by tile
+    checkTilesAndPosts(walls, &failures);
+
+    // The flood fill from the center, shared by the reachability check, the
+    // wall follower check, and the maze itself (for the tile distances)
+    QVector<int> distances = getDistancesFromCenter(walls);
+    for (int i = 0; i < distances.size(); i += 1) {
+        if (distances.at(i) == -1) {
+            failures.insert(
+                MazeCheckFailure::INACCESSIBLE_LOCATION,
+                {i % walls.getWidth(), i / walls.getWidth()}
+            );
+            break;
+        }
     }
-    bool official = (
-        hasNoInaccessibleLocations(maze) &&
-        hasThreeStartingWalls(maze) &&
-        hasOneEntranceToCenter(maze) &&
-        hasHollowCenter(maze) &&
-        hasWallAttachedToEachNonCenterPost(maze) &&
-        isUnsolvableByWallFollower(maze)
-    );
-    if (!official) {
-        return MazeValidity::EXPLORABLE;
+
+    int startingWalls = 0;
+    for (Direction direction : DIRECTIONS()) {
+        if (walls.isWall(0, 0, direction)) {
+            startingWalls += 1;
+        }
+    }
+    if (startingWalls != 3) {
+        failures.insert(MazeCheckFailure::NOT_THREE_STARTING_WALLS, {0, 0});
     }
-    return MazeValidity::OFFICIAL;
-}
 
-bool MazeChecker::isNonempty(const BasicMaze& maze) {
-    return (
-        0 < maze.size() &&
-        0 < maze.at(0).size()
-    );
-}
+    checkCenter(walls, &failures);
 
-bool MazeChecker::isRectangular(const BasicMaze& maze) {
-    for (int i = 0; i < maze.size() - 1; i += 1) {
-        if (maze.at(i).size() != maze.at(i + 1).size()) {
-            return false;
+    if (!isUnsolvableByWallFollower(walls, distances)) {
+        failures.insert(MazeCheckFailure::SOLVABLE_BY_WALL_FOLLOWER, {-1, -1});
+    }
+
+    // The validity is determined by the most severe failure
+    MazeValidity validity = MazeValidity::OFFICIAL;
+    QVector<MazeCheckIssue> issues;
+    for (auto it = failures.constBegin(); it != failures.constEnd(); ++it) {
+        issues.append({it.key(), it.value()});
+        if (
+            it.key() == MazeCheckFailure::NOT_ENCLOSED ||
+            it.key() == MazeCheckFailure::INCONSISTENT_WALLS
+        ) {
+            validity = MazeValidity::DRAWABLE;
+        }
+        else if (validity == MazeValidity::OFFICIAL) {
+            validity = MazeValidity::EXPLORABLE;
         }
     }
-    return true;
+
+    return {validity, issues, distances};
 }
 
-bool MazeChecker::isEnclosed(const BasicMaze& maze) {
-    for (int x = 0; x < maze.size(); x += 1) {
-        for (int y = 0; y < maze.at(x).size(); y += 1) {
-            BasicTile walls = maze.at(x).at(y);
-            if (x == 0 && !walls.value(Direction::WEST)) {
-                return false;
-            }
-            if (y == 0 && !walls.value(Direction::SOUTH)) {
-                return false;
-            }
-            if (x == maze.size() - 1 && !walls.value(Direction::EAST)) {
-                return false;
-            }
-            if (y == maze.at(x).size() - 1 && !walls.value(Direction::NORTH)) {
-                return false;
-            }
-        }
+QVector<int> MazeChecker::getDistancesFromCenter(const WallGridView& walls) {
+    if (walls.getWidth() == 0 || walls.getHeight() == 0) {
+        return {};
     }
-    return true;
+    DistanceField field(
+        walls,
+        MazeUtilities::getCenterPositions(walls.getWidth(), walls.getHeight()));
+    return field.getDistances();
 }
 
-bool MazeChecker::hasConsistentWalls(const BasicMaze& maze) {
-    for (int x = 0; x < maze.size(); x += 1) {
-        for (int y = 0; y < maze.at(x).size(); y += 1) {
-            BasicTile walls = maze.at(x).at(y);
-            if (
-                0 < x &&
-                walls.value(Direction::WEST) &&
-                !maze.at(x - 1).at(y).value(Direction::EAST)
-            ) {
-                return false;
-            }
-            if (
-                0 < y &&
-                walls.value(Direction::SOUTH) &&
-                !maze.at(x).at(y - 1).value(Direction::NORTH)
-            ) {
-                return false;
-            }
+QString MazeChecker::describe(const MazeCheckIssue& issue) {
+    QString description = MAZE_CHECK_FAILURE_TO_STRING().value(issue.failure);
+    if (0 <= issue.location.first && 0 <= issue.location.second) {
+        description += QString(" (%1, %2)")
+            .arg(issue.location.first)
+            .arg(issue.location.second);
+    }
+    return description;
+}
+
+void MazeChecker::checkTilesAndPosts(
+        const WallGridView& walls,
+        QMap<MazeCheckFailure, QPair<int, int>>* failures) {
+
+    int width = walls.getWidth();
+    int height = walls.getHeight();
+
+    quint8 north = WallGrid::directionBit(Direction::NORTH);
+    quint8 east = WallGrid::directionBit(Direction::EAST);
+    quint8 south = WallGrid::directionBit(Direction::SOUTH);
+    quint8 west = WallGrid::directionBit(Direction::WEST);
+
+    // Only the center post is allowed to be bare, and only if there are four
+    // center tiles; the post is identified by the tile to its lower left
+    auto centerPositions = MazeUtilities::getCenterPositions(width, height);
+    QPair<int, int> centerPost = {-1, -1};
+    if (centerPositions.size() == 4) {
+        centerPost = MazeUtilities::getMinPosition(centerPositions);
+    }
+
+    // Row-major, to match the layout of the wall grid
+    for (int y = 0; y < height; y += 1) {
+        for (int x = 0; x < width; x += 1) {
+
+            quint8 tile = walls.getWalls(x, y);
+
+            // The outer walls must all be present
             if (
-                x < maze.size() - 1 &&
-                walls.value(Direction::EAST) &&
-                !maze.at(x + 1).at(y).value(Direction::WEST)
+                (x == 0 && !(tile & west)) ||
+                (y == 0 && !(tile & south)) ||
+                (x == width - 1 && !(tile & east)) ||
+                (y == height - 1 && !(tile & north))
             ) {
-                return false;
+                if (!failures->contains(MazeCheckFailure::NOT_ENCLOSED)) {
+                    failures->insert(MazeCheckFailure::NOT_ENCLOSED, {x, y});
+                }
             }
+
+            // Each interior edge is shared by two tiles, and those tiles must
+            // agree; checking the east and north edges covers every edge once
+            quint8 eastNeighbor = x < width - 1 ? walls.getWalls(x + 1, y) : 0;
+            quint8 northNeighbor = y < height - 1 ? walls.getWalls(x, y + 1) : 0;
             if (
-                y < maze.at(x).size() - 1 &&
-                walls.value(Direction::NORTH) &&
-                !maze.at(x).at(y + 1).value(Direction::SOUTH)
+                (x < width - 1 && !(tile & east) != !(eastNeighbor & west)) ||
+                (y < height - 1 && !(tile & north) != !(northNeighbor & south))
             ) {
-                return false;
+                if (!failures->contains(MazeCheckFailure::INCONSISTENT_WALLS)) {
+                    failures->insert(MazeCheckFailure::INCONSISTENT_WALLS, {x, y});
+                }
             }
-        }
-    }
-    return true;
-}
 
-bool MazeChecker::hasNoInaccessibleLocations(const BasicMaze& maze) {
-    QSet<QPair<int, int>> discovered;
-    QQueue<QPair<int, int>> queue;
-    QPair<int, int> start = {0, 0};
-    discovered.insert(start);
-    queue.enqueue(start);
-    while (!queue.isEmpty()) {
-        QPair<int, int> tile = queue.dequeue();
-        for (Direction direction : DIRECTIONS()) {
-            if (maze.at(tile.first).at(tile.second).value(direction)) {
-                continue;
-            }
-            QPair<int, int> neighbor =
-                MazeUtilities::positionAfterMovingForward(tile, direction);
-            if (!discovered.contains(neighbor)) {
-                discovered.insert(neighbor);
-                queue.enqueue(neighbor);
-            }
-        }
-    }
-    for (int x = 0; x < maze.size(); x += 1) {
-        for (int y = 0; y < maze.at(x).size(); y += 1) {
-            if (!discovered.contains({x, y})) {
-                return false;
+            // Each interior post (at the upper right of this tile) must have
+            // at least one wall attached to it
+            if (x < width - 1 && y < height - 1) {
+                quint8 diagonal = walls.getWalls(x + 1, y + 1);
+                bool attached = (
+                    (tile & north) ||
+                    (tile & east) ||
+                    (diagonal & south) ||
+                    (diagonal & west)
+                );
+                if (!attached && QPair<int, int>(x, y) != centerPost) {
+                    if (!failures->contains(MazeCheckFailure::UNATTACHED_POST)) {
+                        failures->insert(MazeCheckFailure::UNATTACHED_POST, {x, y});
+                    }
+                }
             }
         }
     }
-    return true;
 }
 
-bool MazeChecker::hasThreeStartingWalls(const BasicMaze& maze) {
-    int count = 0;
-    for (Direction direction : DIRECTIONS()) {
-        if (maze.at(0).at(0).value(direction)) {
-            count += 1;
-        }
-    }
-    return count == 3;
-}
-
-bool MazeChecker::hasOneEntranceToCenter(const BasicMaze& maze) {
-    const auto& centerPositions =
-        MazeUtilities::getCenterPositions(maze.size(), maze.at(0).size()); 
+void MazeChecker::checkCenter(
+        const WallGridView& walls,
+        QMap<MazeCheckFailure, QPair<int, int>>* failures) {
+    auto centerPositions = MazeUtilities::getCenterPositions(
+        walls.getWidth(),
+        walls.getHeight());
     int numberOfEntrances = 0;
     for (QPair<int, int> tile : centerPositions) {
         for (Direction direction : DIRECTIONS()) {
-            if (centerPositions.contains(
-                MazeUtilities::positionAfterMovingForward(tile, direction)
-            )) {
-                continue;
+            bool isWall = walls.isWall(tile.first, tile.second, direction);
+            QPair<int, int> neighbor =
+                MazeUtilities::positionAfterMovingForward(tile, direction);
+            if (centerPositions.contains(neighbor)) {
+                if (isWall && !failures->contains(MazeCheckFailure::CENTER_NOT_HOLLOW)) {
+                    failures->insert(MazeCheckFailure::CENTER_NOT_HOLLOW, tile);
+                }
             }
-            if (!maze.at(tile.first).at(tile.second).value(direction)) {
+            else if (!isWall) {
                 numberOfEntrances += 1;
             }
         }
     }
-    return numberOfEntrances == 1;
-}
-
-bool MazeChecker::hasHollowCenter(const BasicMaze& maze) {
-    const auto& centerPositions =
-        MazeUtilities::getCenterPositions(maze.size(), maze.at(0).size()); 
-    for (const auto& tile : centerPositions) {
-        for (const auto& other : centerPositions) {
-            for (const auto& direction : DIRECTIONS()) {
-                if (
-                    MazeUtilities::positionAfterMovingForward(tile, direction)
-                    != other
-                ) {
-                    continue;
-                }
-                if (maze.at(tile.first).at(tile.second).value(direction)) {
-                    return false;
-                }
-            }
-        }
+    if (numberOfEntrances != 1) {
+        failures->insert(MazeCheckFailure::NOT_ONE_ENTRANCE_TO_CENTER, {-1, -1});
     }
-    return true;
 }
 
-bool MazeChecker::hasWallAttachedToEachNonCenterPost(const BasicMaze& maze) {
-    const auto& centerPositions =
-        MazeUtilities::getCenterPositions(maze.size(), maze.at(0).size());
-    for (int x = 0; x < maze.size() - 1; x += 1) {
-        for (int y = 0; y < maze.at(x).size() - 1; y += 1) {
-            // There is a wall attached
-            if (
-                maze.at(x).at(y).value(Direction::NORTH) ||
-                maze.at(x).at(y).value(Direction::EAST) ||
-                maze.at(x + 1).at(y + 1).value(Direction::SOUTH) ||
-                maze.at(x + 1).at(y + 1).value(Direction::WEST)
-            ) {
-                continue;
-            }
-            // It is the center post
-            QPair<int, int> position = {x, y};
-            if (
-                centerPositions.size() == 4 &&
-                position == MazeUtilities::getMinPosition(centerPositions)
-            ) {
-                continue;
-            }
-            return false; 
-        }
+bool MazeChecker::isUnsolvableByWallFollower(
+        const WallGridView& walls,
+        const QVector<int>& distances) {
+
+    // If the start can't be reached from the center, a wall follower
+    // certainly can't reach the center from the start
+    if (distances.at(0) == -1) {
+        return true;
     }
-    return true;
-}
 
-bool MazeChecker::isUnsolvableByWallFollower(const BasicMaze& maze) {
-    const auto& centerPositions =
-        MazeUtilities::getCenterPositions(maze.size(), maze.at(0).size());
-    QSet<QPair<int, int>> reachable;
+    int width = walls.getWidth();
+    int height = walls.getHeight();
+    auto centerPositions = MazeUtilities::getCenterPositions(width, height);
+
+    // Walk the right-hand wall until we return to the start. A walk can visit
+    // each (tile, direction) state at most once before it repeats, which
+    // bounds the walk even if the maze isn't enclosed or consistent.
+    QVector<bool> reachable(width * height, false);
     QPair<int, int> start = {0, 0};
     QPair<int, int> position = start;
     Direction direction = Direction::NORTH;
+    int remainingSteps = 4 * width * height;
     do {
-        reachable.insert(position);
+        reachable[position.second * width + position.first] = true;
         Direction oldDirection = direction;
         Direction newDirection = DIRECTION_ROTATE_RIGHT().value(direction);
-        if (!maze.at(position.first).at(position.second).value(newDirection)) {
+        if (!walls.isWall(position.first, position.second, newDirection)) {
             direction = newDirection;
         }
-        while (maze.at(position.first).at(position.second).value(direction)) {
+        while (walls.isWall(position.first, position.second, direction)) {
             direction = DIRECTION_ROTATE_LEFT().value(direction);
             if (direction == oldDirection) {
                 // We're surrounded by walls
@@ -242,10 +247,16 @@ bool MazeChecker::isUnsolvableByWallFollower(const BasicMaze& maze) {
         }
         position =
             MazeUtilities::positionAfterMovingForward(position, direction);
+        remainingSteps -= 1;
     }
-    while (position != start);
+    while (
+        position != start &&
+        walls.withinGrid(position.first, position.second) &&
+        0 < remainingSteps
+    );
+
     for (const auto& tile : centerPositions) {
-        if (reachable.contains(tile)) {
+        if (reachable.at(tile.second * width + tile.first)) {
             return false;
         }
     }
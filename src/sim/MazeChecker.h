@@ -1,6 +1,12 @@
 #pragma once
 
-#include "BasicMaze.h"
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+#include "WallGrid.h"
+#include "WallGridView.h"
 
 namespace mms {
 
@@ -14,25 +20,74 @@ enum class MazeValidity {
     OFFICIAL,
 };
 
+// The reasons that a maze might fail to be drawable, explorable, or official
+enum class MazeCheckFailure {
+    // Not drawable
+    EMPTY,
+    // Not explorable
+    NOT_ENCLOSED,
+    INCONSISTENT_WALLS,
+    // Not official
+    INACCESSIBLE_LOCATION,
+    NOT_THREE_STARTING_WALLS,
+    NOT_ONE_ENTRANCE_TO_CENTER,
+    CENTER_NOT_HOLLOW,
+    UNATTACHED_POST,
+    SOLVABLE_BY_WALL_FOLLOWER,
+};
+
+const QMap<MazeCheckFailure, QString>& MAZE_CHECK_FAILURE_TO_STRING();
+
+struct MazeCheckIssue {
+    MazeCheckFailure failure;
+    // The first offending tile (or, for posts, the tile to the lower left of
+    // the post), or (-1, -1) if the failure isn't about a particular location
+    QPair<int, int> location;
+};
+
+struct MazeCheckResult {
+    MazeValidity validity;
+    // Every check that failed, not just the first
+    QVector<MazeCheckIssue> issues;
+    // The flood fill from the center that the checks share, in row-major
+    // order (of the checked view), with -1 for unreachable tiles; empty if the maze
+    // isn't drawable
+    QVector<int> distances;
+};
+
 class MazeChecker {
 
 public:
 
     MazeChecker() = delete;
-    static MazeValidity checkMaze(const BasicMaze& maze);
+
+    // Checks the walls of the maze, which is always rectangular, as seen
+    // through the view; each orientation of a maze can be checked in place
+    static MazeCheckResult checkMaze(const WallGridView& walls);
+
+    // Returns the BFS distance of each tile from the center tiles, in the
+    // row-major order of the view, or -1 for unreachable tiles
+    static QVector<int> getDistancesFromCenter(const WallGridView& walls);
+
+    // Returns a human readable description of a single issue
+    static QString describe(const MazeCheckIssue& issue);
 
 private:
 
-    static bool isNonempty(const BasicMaze& maze);
-    static bool isRectangular(const BasicMaze& maze);
-    static bool isEnclosed(const BasicMaze& maze);
-    static bool hasConsistentWalls(const BasicMaze& maze);
-    static bool hasNoInaccessibleLocations(const BasicMaze& maze);
-    static bool hasThreeStartingWalls(const BasicMaze& maze);
-    static bool hasOneEntranceToCenter(const BasicMaze& maze);
-    static bool hasHollowCenter(const BasicMaze& maze);
-    static bool hasWallAttachedToEachNonCenterPost(const BasicMaze& maze);
-    static bool isUnsolvableByWallFollower(const BasicMaze& maze);
+    // Single pass over all tiles and posts: enclosure, wall consistency, and
+    // posts with no walls attached
+    static void checkTilesAndPosts(
+        const WallGridView& walls,
+        QMap<MazeCheckFailure, QPair<int, int>>* failures);
+
+    // The center must have one entrance and no walls inside of it
+    static void checkCenter(
+        const WallGridView& walls,
+        QMap<MazeCheckFailure, QPair<int, int>>* failures);
+
+    static bool isUnsolvableByWallFollower(
+        const WallGridView& walls,
+        const QVector<int>& distances);
 
 };
 
@@ -0,0 +1,358 @@
+#include "MazeCorpus.h"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <QVector>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+#include "Assert.h"
+#include "MazeChecker.h"
+#include "MazeFileUtilities.h"
+#include "MazeSymmetry.h"
+
+namespace mms {
+
+// The layout of a corpus file, with all integers little-endian:
+//
+//   header (32 bytes)
+//     0    char[4]     magic, "MMSC"
+//     4    quint32     version
+//     8    quint32     number of entries
+//     12   quint32     size of each entry
+//     16   quint64     offset of the first entry
+//     24   quint64     reserved
+//
+//   entry (128 bytes)
+//     0    char[64]    name, UTF-8, NUL padded
+//     64   quint16     width
+//     66   quint16     height
+//     68   quint32     flags
+//     72   quint64     canonical hash, see MazeSymmetry
+//     80   quint64     offset of the packed walls
+//     88   quint32     number of packed words
+//     92   qint32      max distance from the center
+//     96   qint32      distance from the start to the center
+//     100  qint32      number of dead ends
+//     104  char[24]    reserved
+//
+//   packed walls (8 bytes per word, as in WallGrid)
+
+const QString MazeCorpus::SUFFIX = "mmsc";
+const char MazeCorpus::MAGIC[4] = {'M', 'M', 'S', 'C'};
+
+MazeCorpus* MazeCorpus::open(const QString& path) {
+
+    MazeCorpus* corpus = new MazeCorpus(path);
+    auto fail = [&](const QString& reason) -> MazeCorpus* {
+        qWarning().noquote().nospace()
+            << "Unable to open maze corpus \"" << path << "\": "
+            << reason << ".";
+        delete corpus;
+        return nullptr;
+    };
+
+    if (!corpus->m_file.open(QIODevice::ReadOnly)) {
+        return fail("file can't be read");
+    }
+    corpus->m_size = corpus->m_file.size();
+    if (corpus->m_size < HEADER_SIZE) {
+        return fail("file is too small");
+    }
+    corpus->m_data = corpus->m_file.map(0, corpus->m_size);
+    if (corpus->m_data == nullptr) {
+        return fail("file can't be mapped");
+    }
+
+    // Validate the header
+    const uchar* header = corpus->m_data;
+    if (std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0) {
+        return fail("bad magic");
+    }
+    if (qFromLittleEndian<quint32>(header + 4) != VERSION) {
+        return fail("unsupported version");
+    }
+    if (qFromLittleEndian<quint32>(header + 12) != ENTRY_SIZE) {
+        return fail("unexpected entry size");
+    }
+    quint32 numEntries = qFromLittleEndian<quint32>(header + 8);
+    quint64 indexOffset = qFromLittleEndian<quint64>(header + 16);
+    if (
+        indexOffset != HEADER_SIZE ||
+        static_cast<quint64>(corpus->m_size) <
+            indexOffset + static_cast<quint64>(numEntries) * ENTRY_SIZE
+    ) {
+        return fail("truncated index");
+    }
+    corpus->m_numEntries = numEntries;
+
+    // Validate every entry up front, so that lookups can't go out of bounds
+    for (int i = 0; i < corpus->m_numEntries; i += 1) {
+        const uchar* entry = corpus->getEntryData(i);
+        int width = qFromLittleEndian<quint16>(entry + 64);
+        int height = qFromLittleEndian<quint16>(entry + 66);
+        quint64 offset = qFromLittleEndian<quint64>(entry + 80);
+        quint32 numWords = qFromLittleEndian<quint32>(entry + 88);
+        if (
+            static_cast<int>(numWords) != WallGrid(width, height).getNumWords() ||
+            static_cast<quint64>(corpus->m_size) < offset + 8ULL * numWords
+        ) {
+            return fail(QString("bad entry %1").arg(i));
+        }
+        corpus->m_indexByHash.insert(qFromLittleEndian<quint64>(entry + 72), i);
+    }
+
+    return corpus;
+}
+
+MazeCorpus::~MazeCorpus() {
+    if (m_data != nullptr) {
+        m_file.unmap(const_cast<uchar*>(m_data));
+    }
+}
+
+QString MazeCorpus::getPath() const {
+    return m_file.fileName();
+}
+
+int MazeCorpus::size() const {
+    return m_numEntries;
+}
+
+MazeCorpus::Entry MazeCorpus::getEntry(int index) const {
+    const uchar* entry = getEntryData(index);
+    const char* name = reinterpret_cast<const char*>(entry);
+    quint32 flags = qFromLittleEndian<quint32>(entry + 68);
+    return {
+        QString::fromUtf8(name, qstrnlen(name, NAME_SIZE)),
+        qFromLittleEndian<quint16>(entry + 64),
+        qFromLittleEndian<quint16>(entry + 66),
+        (flags & FLAG_VALID) != 0,
+        (flags & FLAG_OFFICIAL) != 0,
+        qFromLittleEndian<quint64>(entry + 72),
+        qFromLittleEndian<qint32>(entry + 92),
+        qFromLittleEndian<qint32>(entry + 96),
+        qFromLittleEndian<qint32>(entry + 100),
+    };
+}
+
+WallGrid MazeCorpus::getWallGrid(int index) const {
+    const uchar* entry = getEntryData(index);
+    int width = qFromLittleEndian<quint16>(entry + 64);
+    int height = qFromLittleEndian<quint16>(entry + 66);
+    quint64 offset = qFromLittleEndian<quint64>(entry + 80);
+    quint32 numWords = qFromLittleEndian<quint32>(entry + 88);
+    QVector<quint64> words(numWords);
+    qFromLittleEndian<quint64>(m_data + offset, numWords, words.data());
+    return WallGrid::fromWords(width, height, words.constData());
+}
+
+int MazeCorpus::find(const WallGrid& walls) const {
+    quint64 hash = MazeSymmetry::canonicalHash(walls);
+    int index = m_indexByHash.value(hash, -1);
+    if (index == -1) {
+        return -1;
+    }
+    // Guard against hash collisions
+    if (MazeSymmetry::canonicalForm(getWallGrid(index)) != MazeSymmetry::canonicalForm(walls)) {
+        return -1;
+    }
+    return index;
+}
+
+int MazeCorpus::build(const QStringList& directories, const QString& path) {
+
+    QStringList mazeFiles = MazeFileUtilities::findMazeFiles(directories);
+
+    // Load and check each maze, building up the index and the packed walls
+    QByteArray index;
+    QByteArray walls;
+    int numEntries = 0;
+    int numMazes = 0;
+    QHash<quint64, QString> written;
+    for (const QString& mazeFile : mazeFiles) {
+        QVector<QPair<QString, WallGrid>> mazes;
+        try {
+            mazes = loadMazes(mazeFile);
+        }
+        catch (const std::exception& e) {
+            qWarning().noquote().nospace()
+                << "Skipping maze file \"" << mazeFile << "\": " << e.what() << ".";
+            continue;
+        }
+        numMazes += mazes.size();
+        for (const QPair<QString, WallGrid>& maze : mazes) {
+            const WallGrid& grid = maze.second;
+            if (0xffff < grid.getWidth() || 0xffff < grid.getHeight()) {
+                qWarning().noquote().nospace()
+                    << "Skipping maze \"" << maze.first << "\": too large.";
+                continue;
+            }
+
+            // Skip rotations and mirror images of mazes that were already
+            // written
+            quint64 hash = MazeSymmetry::canonicalHash(grid);
+            if (written.contains(hash)) {
+                qInfo().noquote().nospace()
+                    << "Skipping maze \"" << maze.first
+                    << "\": symmetric duplicate of \"" << written.value(hash)
+                    << "\".";
+                continue;
+            }
+            written.insert(hash, maze.first);
+
+            MazeCheckResult result = MazeChecker::checkMaze(grid);
+            quint32 flags = 0;
+            if (
+                result.validity == MazeValidity::EXPLORABLE ||
+                result.validity == MazeValidity::OFFICIAL
+            ) {
+                flags |= FLAG_VALID;
+            }
+            if (result.validity == MazeValidity::OFFICIAL) {
+                flags |= FLAG_OFFICIAL;
+            }
+            qint32 maxDistance = 0;
+            for (int distance : result.distances) {
+                maxDistance = std::max(maxDistance, distance);
+            }
+            qint32 startDistance = result.distances.isEmpty() ? -1 : result.distances.at(0);
+            qint32 deadEnds = 0;
+            for (int x = 0; x < grid.getWidth(); x += 1) {
+                for (int y = 0; y < grid.getHeight(); y += 1) {
+                    quint8 tile = grid.getWalls(x, y);
+                    int numWalls = 0;
+                    for (Direction direction : DIRECTIONS()) {
+                        if (tile & WallGrid::directionBit(direction)) {
+                            numWalls += 1;
+                        }
+                    }
+                    if (numWalls == 3) {
+                        deadEnds += 1;
+                    }
+                }
+            }
+
+            // The name is truncated (on a character boundary) to fit
+            QString name = maze.first;
+            QByteArray nameBytes = name.toUtf8();
+            while (NAME_SIZE <= nameBytes.size()) {
+                name.chop(1);
+                nameBytes = name.toUtf8();
+            }
+
+            // The offsets of the walls are relative to the start of the
+            // walls section for now, and fixed up once the size of the index
+            // is known
+            uchar entry[ENTRY_SIZE] = {};
+            std::memcpy(entry, nameBytes.constData(), nameBytes.size());
+            qToLittleEndian<quint16>(grid.getWidth(), entry + 64);
+            qToLittleEndian<quint16>(grid.getHeight(), entry + 66);
+            qToLittleEndian<quint32>(flags, entry + 68);
+            qToLittleEndian<quint64>(hash, entry + 72);
+            qToLittleEndian<quint64>(walls.size(), entry + 80);
+            qToLittleEndian<quint32>(grid.getNumWords(), entry + 88);
+            qToLittleEndian<qint32>(maxDistance, entry + 92);
+            qToLittleEndian<qint32>(startDistance, entry + 96);
+            qToLittleEndian<qint32>(deadEnds, entry + 100);
+            index.append(reinterpret_cast<const char*>(entry), ENTRY_SIZE);
+
+            QByteArray words(8 * grid.getNumWords(), '\0');
+            qToLittleEndian<quint64>(grid.getWords(), grid.getNumWords(), words.data());
+            walls.append(words);
+            numEntries += 1;
+        }
+    }
+
+    // Fix up the offsets of the walls
+    quint64 wallsOffset = HEADER_SIZE + index.size();
+    for (int i = 0; i < numEntries; i += 1) {
+        uchar* entry = reinterpret_cast<uchar*>(index.data()) + i * ENTRY_SIZE;
+        quint64 offset = qFromLittleEndian<quint64>(entry + 80);
+        qToLittleEndian<quint64>(wallsOffset + offset, entry + 80);
+    }
+
+    uchar header[HEADER_SIZE] = {};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    qToLittleEndian<quint32>(VERSION, header + 4);
+    qToLittleEndian<quint32>(numEntries, header + 8);
+    qToLittleEndian<quint32>(ENTRY_SIZE, header + 12);
+    qToLittleEndian<quint64>(HEADER_SIZE, header + 16);
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning().noquote().nospace()
+            << "Unable to write maze corpus \"" << path << "\".";
+        return -1;
+    }
+    file.write(reinterpret_cast<const char*>(header), HEADER_SIZE);
+    file.write(index);
+    file.write(walls);
+    if (!file.commit()) {
+        qWarning().noquote().nospace()
+            << "Unable to write maze corpus \"" << path << "\".";
+        return -1;
+    }
+
+    qInfo().noquote().nospace()
+        << "Wrote " << numEntries << " of " << numMazes
+        << " mazes to \"" << path << "\".";
+    return numEntries;
+}
+
+void MazeCorpus::addOptions(QCommandLineParser* parser) {
+    parser->addOption({
+        "build-corpus",
+        "Write the maze files found in <directories> to the corpus <file>.",
+        "file",
+    });
+}
+
+int MazeCorpus::runFromArguments(const QCommandLineParser& parser) {
+    int count = build(parser.positionalArguments(), parser.value("build-corpus"));
+    return count < 0 ? 1 : 0;
+}
+
+QVector<QPair<QString, WallGrid>> MazeCorpus::loadMazes(const QString& mazeFile) {
+
+    // Every maze file holds a single maze, except for a stream of binary
+    // records from a maze algorithm, whose mazes are named by their seeds
+    QFileInfo info(mazeFile);
+    if (info.suffix().compare(
+            MAZE_FILE_TYPE_TO_SUFFIX().value(MazeFileType::MMSW),
+            Qt::CaseInsensitive) != 0) {
+        return {{info.fileName(), MazeFileUtilities::load(mazeFile)}};
+    }
+    QFile file(mazeFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw std::runtime_error("file doesn't exist");
+    }
+    QByteArray bytes = file.readAll();
+    QVector<QPair<QString, WallGrid>> mazes;
+    int offset = 0;
+    while (offset < bytes.size()) {
+        quint32 seed = 0;
+        WallGrid grid = MazeFileUtilities::readMmswRecord(bytes, &offset, &seed);
+        mazes.append({info.fileName() + "#" + QString::number(seed), grid});
+    }
+    return mazes;
+}
+
+MazeCorpus::MazeCorpus(const QString& path) :
+    m_file(path),
+    m_data(nullptr),
+    m_size(0),
+    m_numEntries(0) {
+}
+
+const uchar* MazeCorpus::getEntryData(int index) const {
+    ASSERT_LE(0, index);
+    ASSERT_LT(index, m_numEntries);
+    return m_data + HEADER_SIZE + index * ENTRY_SIZE;
+}
+
+} // namespace mms
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <QCommandLineParser>
+#include <QFile>
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtGlobal>
+
+#include "WallGrid.h"
+
+namespace mms {
+
+// A single, memory-mapped file containing many mazes. The file starts with an
+// index of fixed-size entries (name, dimensions, validity, hash, and some
+// precomputed stats), followed by the packed WallGrid words of each maze, so
+// that mazes can be enumerated and loaded without any parsing. Mazes that are
+// rotations or mirror images of one another are only stored once.
+class MazeCorpus {
+
+public:
+
+    // The suffix of corpus files
+    static const QString SUFFIX;
+
+    struct Entry {
+        QString name;
+        int width;
+        int height;
+        bool isValid;
+        bool isOfficial;
+        // Invariant under rotation and mirroring, see MazeSymmetry
+        quint64 hash;
+        int maxDistance;
+        int startDistance;
+        int deadEnds;
+    };
+
+    // Maps the corpus file, or returns nullptr if it's missing or malformed
+    static MazeCorpus* open(const QString& path);
+    ~MazeCorpus();
+
+    QString getPath() const;
+    int size() const;
+    Entry getEntry(int index) const;
+    WallGrid getWallGrid(int index) const;
+
+    // Returns the index of the entry that is equal to the walls, up to
+    // rotation and mirroring, or -1 if there isn't one. The max distance and
+    // dead end count of that entry also hold for the walls, so they needn't
+    // be recomputed.
+    int find(const WallGrid& walls) const;
+
+    // Writes every maze file (of any MazeFileType) found in the directories,
+    // recursively, into a new corpus file, skipping any maze that is a
+    // rotation or mirror image of one that was already written. Returns the
+    // number of mazes written, or -1 if the corpus couldn't be written.
+    static int build(const QStringList& directories, const QString& path);
+
+    // The options of --build-corpus, and running it with them as parsed,
+    // which returns the exit code
+    static void addOptions(QCommandLineParser* parser);
+    static int runFromArguments(const QCommandLineParser& parser);
+
+private:
+
+    explicit MazeCorpus(const QString& path);
+
+    // Loads the named mazes in a maze file; a .mmsw stream may hold many
+    static QVector<QPair<QString, WallGrid>> loadMazes(const QString& mazeFile);
+
+    // See MazeCorpus.cpp for the layout of the file
+    static const char MAGIC[4];
+    static const quint32 VERSION = 2;
+    static const int HEADER_SIZE = 32;
+    static const int ENTRY_SIZE = 128;
+    static const int NAME_SIZE = 64;
+    static const quint32 FLAG_VALID = 1 << 0;
+    static const quint32 FLAG_OFFICIAL = 1 << 1;
+
+    QFile m_file;
+    const uchar* m_data;
+    qint64 m_size;
+    int m_numEntries;
+    QHash<quint64, int> m_indexByHash;
+
+    const uchar* getEntryData(int index) const;
+};
+
+} // namespace mms
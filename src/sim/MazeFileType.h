@@ -13,6 +13,7 @@ enum class MazeFileType {
     MAZ,
     MZ2,
     NUM,
+    MMSW,
 };
 
 const QMap<MazeFileType, QString>& MAZE_FILE_TYPE_TO_STRING();
@@ -1,321 +1,384 @@
 #include "MazeFileUtilities.h"
 
-#include <QChar>
+#include <QDirIterator>
 #include <QFile>
-#include <QString>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtEndian>
 
-#include "Logging.h"
-#include "MazeChecker.h"
-#include "SimUtilities.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 
 namespace mms {
 
-BasicMaze MazeFileUtilities::load(const QString& path) {
+const char MazeFileUtilities::MMSW_MAGIC[4] = {'M', 'M', 'S', 'W'};
+
+WallGrid MazeFileUtilities::load(const QString& path) {
     QFile file(path);
     // TODO: MACK - replace with QFile::exists
     if (!file.open(QIODevice::ReadOnly)) {
         throw std::runtime_error("file doesn't exist");
     }
-    return loadBytes(file.readAll());
+    QString suffix = QFileInfo(path).suffix();
+
+    // Parse the file straight out of a memory mapping, if possible, rather
+    // than copying it into memory first. The deserializers don't hold on to
+    // the bytes, and the mapping is released when the file is destroyed.
+    qint64 size = file.size();
+    if (0 < size && size <= std::numeric_limits<int>::max()) {
+        uchar* data = file.map(0, size);
+        if (data != nullptr) {
+            return loadBytes(
+                QByteArray::fromRawData(
+                    reinterpret_cast<const char*>(data),
+                    static_cast<int>(size)),
+                suffix);
+        }
+    }
+    return loadBytes(file.readAll(), suffix);
 }
 
-BasicMaze MazeFileUtilities::loadBytes(const QByteArray& bytes) {
-
-    // Since we don't know anything about the file type ahead of time, we
-    // simply brute force try each of the file types until either one succeeds
-    // or they all fail
-
-    #define TRY(expression, validate)\
-    try {\
-        BasicMaze maze = expression;\
-        MazeValidity validity = MazeChecker::checkMaze(maze);\
-        if (validity != MazeValidity::INVALID) {\
-            if (\
-                !validate ||\
-                validity == MazeValidity::EXPLORABLE ||\
-                validity == MazeValidity::OFFICIAL\
-            ) {\
-                return maze;\
-            }\
-        }\
-    }\
-    catch (...) { }
-
-    TRY(deserializeMazType(bytes), true);
-    TRY(deserializeMz2Type(bytes), true);
-    TRY(deserializeNumType(bytes), true);
-    TRY(deserializeMapType(bytes), false);
+WallGrid MazeFileUtilities::loadBytes(const QByteArray& bytes, const QString& suffix) {
+    switch (detectType(bytes, suffix)) {
+        case MazeFileType::MAP:
+            return deserializeMapType(bytes);
+        case MazeFileType::MAZ:
+            return deserializeMazType(bytes);
+        case MazeFileType::MZ2:
+            return deserializeMz2Type(bytes);
+        case MazeFileType::NUM:
+            return deserializeNumType(bytes);
+        case MazeFileType::MMSW: {
+            int offset = 0;
+            return readMmswRecord(bytes, &offset);
+        }
+    }
     throw std::runtime_error("invalid format");
 }
 
+QStringList MazeFileUtilities::findMazeFiles(const QStringList& directories) {
+    QStringList mazeFiles;
+    for (const QString& directory : directories) {
+        QDirIterator it(directory, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            QString file = it.next();
+            QString suffix = QFileInfo(file).suffix();
+            for (const QString& mazeSuffix : MAZE_FILE_TYPE_TO_SUFFIX()) {
+                if (suffix.compare(mazeSuffix, Qt::CaseInsensitive) == 0) {
+                    mazeFiles.append(file);
+                    break;
+                }
+            }
+        }
+    }
+    mazeFiles.sort();
+    return mazeFiles;
+}
+
+MazeFileType MazeFileUtilities::detectType(
+        const QByteArray& bytes,
+        const QString& suffix) {
+
+    // A recognized suffix is authoritative
+    for (MazeFileType type : MAZE_FILE_TYPE_TO_SUFFIX().keys()) {
+        if (
+            !suffix.isEmpty() &&
+            suffix.compare(
+                MAZE_FILE_TYPE_TO_SUFFIX().value(type),
+                Qt::CaseInsensitive
+            ) == 0
+        ) {
+            return type;
+        }
+    }
+
+    // Otherwise, sniff the contents, starting with the magic of a binary
+    // record from a maze algorithm (see readMmswRecord). The other binary
+    // formats are full of small byte values (a MAZ file is exactly one byte
+    // per tile of a 16x16 maze), whereas the text formats are printable ASCII.
+    const char* data = bytes.constData();
+    int size = bytes.size();
+    if (
+        sizeof(MMSW_MAGIC) <= static_cast<size_t>(size) &&
+        std::memcmp(data, MMSW_MAGIC, sizeof(MMSW_MAGIC)) == 0
+    ) {
+        return MazeFileType::MMSW;
+    }
+    for (int i = 0; i < size; i += 1) {
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        if ((c < 0x20 && c != '\t' && c != '\n' && c != '\r') || 0x7e < c) {
+            return size == 256 ? MazeFileType::MAZ : MazeFileType::MZ2;
+        }
+    }
+
+    // A NUM file starts with a tile's x coordinate, a MAP file with a post
+    for (int i = 0; i < size; i += 1) {
+        if (!isWhitespace(data[i])) {
+            return '0' <= data[i] && data[i] <= '9'
+                ? MazeFileType::NUM
+                : MazeFileType::MAP;
+        }
+    }
+    throw std::runtime_error("empty maze file");
+}
+
 void MazeFileUtilities::save(
-    const BasicMaze& maze,
-    const QString& path,
-    MazeFileType type) {
+        const WallGrid& maze,
+        const QString& path,
+        MazeFileType type) {
 
-    // TODO: MACK - should throw exception
-    QByteArray bytes;
+    // The maze is streamed to the file a line at a time, so that large mazes
+    // never need a second, serialized copy in memory. The file is only
+    // replaced once everything has been written successfully.
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        throw std::runtime_error("unable to open file");
+    }
     switch (type) {
         case MazeFileType::MAP:
-            bytes = serializeMapType(maze);
+            writeMapType(maze, &file);
+            break;
         case MazeFileType::MAZ:
-            bytes = serializeMazType(maze);
+            writeMazType(maze, &file);
+            break;
         case MazeFileType::MZ2:
-            bytes = serializeMz2Type(maze);
+            writeMz2Type(maze, &file);
+            break;
         case MazeFileType::NUM:
-            bytes = serializeNumType(maze);
-        default:
-            // TODO: MACK
-            SimUtilities::quit();
+            writeNumType(maze, &file);
+            break;
+        case MazeFileType::MMSW:
+            writeMmswRecord(maze, 0, &file);
+            break;
+    }
+    if (!file.commit()) {
+        throw std::runtime_error("unable to write file");
     }
-    // TODO: MACK - write to file
 }
 
-BasicMaze MazeFileUtilities::deserializeMapType(const QByteArray& bytes) {
-
-    // First, convert the bytes to lines
-    QStringList lines = SimUtilities::splitLines(QString(bytes).trimmed());
+WallGrid MazeFileUtilities::deserializeMapType(const QByteArray& bytes) {
 
-    // The maze to be returned
-    BasicMaze upsideDownMaze;
+    // The lines are offsets into the bytes, so nothing is copied
+    const char* data = bytes.constData();
+    QVector<QPair<int, int>> lines = getLines(bytes);
+    if (lines.isEmpty() || lines.at(0).second == 0) {
+        throw std::runtime_error("Invalid first line");
+    }
+    auto lineSize = [&lines](int i) {
+        return lines.at(i).second;
+    };
+    auto charAt = [&data, &lines](int i, int position) {
+        return data[lines.at(i).first + position];
+    };
 
     // The character representing a maze post
-    QChar delimiter('\0');
+    char delimiter = charAt(0, 0);
 
-    // The number of horizontal spaces between columns
+    // The number of horizontal spaces between columns, i.e., the sizes of the
+    // nonempty runs of characters between posts on the first line
     QVector<int> spaces;
+    int run = 0;
+    for (int position = 0; position < lineSize(0); position += 1) {
+        if (charAt(0, position) == delimiter) {
+            if (0 < run) {
+                spaces.push_back(run);
+            }
+            run = 0;
+        }
+        else {
+            run += 1;
+        }
+    }
+    if (0 < run) {
+        spaces.push_back(run);
+    }
+    if (spaces.isEmpty()) {
+        throw std::runtime_error("No columns");
+    }
+
+    // Each row of tiles is bounded above and below by lines of posts
+    auto isPostLine = [&](int i) {
+        return 0 < lineSize(i) && charAt(i, 0) == delimiter;
+    };
+    int width = spaces.size();
+    int height = -1;
+    for (int i = 0; i < lines.size(); i += 1) {
+        if (isPostLine(i)) {
+            height += 1;
+        }
+    }
+    WallGrid maze(width, height);
 
     // Keep track of what row of the maze we're reading
     int rowsFromTopOfMaze = -1;
 
     // Iterate over all of the lines
     for (int i = 0; i < lines.size(); i += 1) {
-        QString line = lines.at(i);
-
-        // Special case for the first line of the file
-        if (i == 0) {
-            if (line.size() == 0) {
-                // TODO: MACK - clean this up
-                throw std::runtime_error("Invalid first line");
-            }
-            delimiter = line.at(0);
-            QStringList tokens = line.split(delimiter, QString::SkipEmptyParts);
-            for (int j = 0; j < tokens.size(); j += 1) {
-                QVector<BasicTile> column;
-                upsideDownMaze.push_back(column);
-                spaces.push_back(tokens.at(j).size());
-            }
-        }
 
-        // Extract horizontal wall info, tiles structs don't already exist
-        if (line.at(0) == delimiter) {
+        // Extract horizontal wall info, which is the north wall of the row
+        // below the line and the south wall of the row above it
+        if (isPostLine(i)) {
             rowsFromTopOfMaze += 1;
             int position = (spaces.at(0) + 1) / 2; // Center of the wall
-            for (int j = 0; j < spaces.size(); j += 1) {
-                if (line.size() <= position) {
-                    break;
+            for (int j = 0; j < width; j += 1) {
+                if (lineSize(i) <= position) {
+                    throw std::runtime_error("Incomplete row of posts");
                 }
-                BasicTile tile;
-                for (Direction direction : DIRECTIONS()) {
-                    tile.insert(direction, false);
+                bool isWall = charAt(i, position) != ' ';
+                if (rowsFromTopOfMaze < height) {
+                    maze.setWall(j, height - 1 - rowsFromTopOfMaze, Direction::NORTH, isWall);
                 }
-                upsideDownMaze[j].push_back(tile);
-                if (0 < spaces.at(j)) {
-                    bool isWall = line.at(position) != ' ';
-                    upsideDownMaze[j][rowsFromTopOfMaze][Direction::NORTH] = isWall;
-                    if (0 < rowsFromTopOfMaze) {
-                        upsideDownMaze[j][rowsFromTopOfMaze - 1][Direction::SOUTH] = isWall;
-                    }
+                if (0 < rowsFromTopOfMaze) {
+                    maze.setWall(j, height - rowsFromTopOfMaze, Direction::SOUTH, isWall);
                 }
-                if (j < spaces.size() - 1) {
+                if (j < width - 1) {
                     position += 1 + spaces.at(j) / 2; // Position of the next corner
                     position += (spaces.at(j + 1) + 1) / 2; // Center of the wall
                 }
             }
         }
 
-        // Extract vertical wall info, tiles structs already exist
-        else if (lines.at(i - 1).at(0) == delimiter) {
+        // Extract vertical wall info, from the line just below the posts
+        else if (0 < i && isPostLine(i - 1) && rowsFromTopOfMaze < height) {
+            int y = height - 1 - rowsFromTopOfMaze;
             int position = 0;
-            for (int j = 0; j <= spaces.size(); j += 1) {
-                if (line.size() <= position) {
+            for (int j = 0; j <= width; j += 1) {
+                if (lineSize(i) <= position) {
                     break;
                 }
-                bool isWall = line.at(position) != ' ';
+                bool isWall = charAt(i, position) != ' ';
                 if (0 < j) {
-                    upsideDownMaze[j - 1][rowsFromTopOfMaze][Direction::EAST] = isWall;
+                    maze.setWall(j - 1, y, Direction::EAST, isWall);
                 }
-                if (j < spaces.size()) {
-                    upsideDownMaze[j][rowsFromTopOfMaze][Direction::WEST] = isWall;
+                if (j < width) {
+                    maze.setWall(j, y, Direction::WEST, isWall);
                     position += spaces.at(j) + 1;
                 }
             }
         }
     }
 
-    // Strip off of the last extraneous row
-    for (int i = 0; i < upsideDownMaze.size(); i += 1) {
-        upsideDownMaze[i].pop_back();
-    }
-
-    // Flip the maze so that it's right side up
-    BasicMaze rightSideUpMaze;
-    for (int i = 0; i < upsideDownMaze.size(); i += 1) {
-        QVector<BasicTile> column;
-        for (int j = upsideDownMaze.at(i).size() - 1; j >= 0; j -= 1) {
-            column.push_back(upsideDownMaze.at(i).at(j));
-        }
-        rightSideUpMaze.push_back(column);
-    }
-
-    return rightSideUpMaze;
+    return maze;
 }
 
-BasicMaze MazeFileUtilities::deserializeMazType(const QByteArray& bytes) {
+WallGrid MazeFileUtilities::deserializeMazType(const QByteArray& bytes) {
 
-    // TODO: MACK - QVector aborts the application without this
-    throw std::runtime_error("MACK");
-
-    // TODO: MACK Convert this to use Qt
-    QVector<char> characters;
-    for (int i = 0; i < bytes.size(); i += 1) {
-        characters.push_back(bytes.at(i));
+    // This maze file format is written to only accomodate 16x16 mazes
+    if (bytes.size() != 256) {
+        throw std::runtime_error("MAZ files must be exactly 256 bytes");
     }
-    
-    // The maze to be returned
-    BasicMaze maze;
 
-    // This maze file format is written to only accomodate 16x16 mazes
-    // We can hardcode this becuase all the load functions run in try blocks
+    // Each byte represents the walls like this: 'X X X X W S E N', which
+    // happens to match the bit layout of the wall grid
+    const char* data = bytes.constData();
+    WallGrid maze(16, 16);
     for (int x = 0; x < 16; x += 1) {
-        QVector<BasicTile> column;
         for (int y = 0; y < 16; y += 1) {
-            int walls = characters.at(x * 16 + y);
-            BasicTile tile;
-            //Each byte reprsents the walls like this: 'X X X X W S E N'
-            tile[Direction::WEST]  = (walls & 1 << 3) != 0;
-            tile[Direction::SOUTH] = (walls & 1 << 2) != 0;
-            tile[Direction::EAST]  = (walls & 1 << 1) != 0;
-            tile[Direction::NORTH] = (walls & 1 << 0) != 0;
-            column.push_back(tile);
+            maze.setWalls(x, y, static_cast<quint8>(data[x * 16 + y] & 0x0f));
         }
-        maze.push_back(column);
     }
 
     return maze;
 }
 
-BasicMaze MazeFileUtilities::deserializeMz2Type(const QByteArray& bytes) {
-
-    // TODO: Convert this to use Qt
-    QVector<char> characters;
-    for (int i = 0; i < bytes.size(); i += 1) {
-        characters.push_back(bytes.at(i));
-    }
-
-    // Reverse the vector order so we can pop back for the next character
-    std::reverse(characters.begin(), characters.end());
-
-    // Why oh why can't cant iterators throw exceptions when derefrencing to invalid locations
-    // Pop back and get popped element
-    auto getPopBack = [](QVector<char>* v) {if(v->size()==0){throw std::exception();}
-                                                      auto e = v->back();
-                                                      v->pop_back();
-                                                      return e;};
+WallGrid MazeFileUtilities::deserializeMz2Type(const QByteArray& bytes) {
 
-    uint32_t stringLength = (getPopBack(&characters) << 4) +
-                             getPopBack(&characters);
-
-    QString mazeName; // The title is not used, but here if needed
-                          // It is a UTF-8 formatted sring
-
-    if (stringLength != 0) {
-        while (stringLength != 0) {
-            unsigned char character = getPopBack(&characters);
-            mazeName += character;
-            if (character >> 7 == 0 ||
-                character >> 6 == 3) { // 11 in binary
-                // This is a utf-8 formated string.  Only decrement the counter
-                // if it is the first character of a sequence.
-                stringLength--;
-            }
+    // Read the bytes in order, without copying them
+    const unsigned char* data =
+        reinterpret_cast<const unsigned char*>(bytes.constData());
+    int size = bytes.size();
+    int index = 0;
+    auto next = [&]() -> uint32_t {
+        if (size <= index) {
+            throw std::runtime_error("Unexpected end of MZ2 data");
+        }
+        return data[index++];
+    };
+
+    uint32_t stringLength = (next() << 4) + next();
+
+    // The title is not used, so we just skip past it. It is a UTF-8
+    // formatted string, and its length is in characters, not bytes.
+    while (stringLength != 0) {
+        uint32_t character = next();
+        if (character >> 7 == 0 ||
+            character >> 6 == 3) { // 11 in binary
+            // Only decrement the counter if it is the
+            // first byte of a sequence.
+            stringLength--;
         }
     }
 
-    uint32_t width = (getPopBack(&characters) << 24) +
-                     (getPopBack(&characters) << 16) +
-                     (getPopBack(&characters) << 8) +
-                     (getPopBack(&characters));
+    uint32_t width = (next() << 24) + (next() << 16) + (next() << 8) + next();
+    uint32_t height = (next() << 24) + (next() << 16) + (next() << 8) + next();
 
-    uint32_t height = (getPopBack(&characters) << 24) +
-                      (getPopBack(&characters) << 16) +
-                      (getPopBack(&characters) << 8) +
-                      (getPopBack(&characters));
-    
-    // Let's make sure we do not read a massive size and go on forerver
-    if (width > 256 || height > 256) {
-        throw std::exception();
+    // Let's make sure we do not read a massive size and go on forerver, or
+    // allocate a grid that the remaining bytes can't possibly describe
+    if (width == 0 || height == 0 ||
+            width > MAX_MZ2_DIMENSION || height > MAX_MZ2_DIMENSION) {
+        throw std::runtime_error("Invalid MZ2 maze size");
+    }
+    qint64 numBits =
+        static_cast<qint64>(height - 1) * width +
+        static_cast<qint64>(width - 1) * height;
+    if (8 * static_cast<qint64>(size - index) < numBits) {
+        throw std::runtime_error("Not enough MZ2 data for the maze size");
     }
 
-    BasicMaze maze;
-
-    for (auto x = 0; x < width; x++) {
-        QVector<BasicTile> column;
-        for (auto y = 0; y < height; y++) {
-            BasicTile tile;
-            for (Direction direction : DIRECTIONS()) {
-                // Make a filled maze so we get the maze border for free
-                // and don't need any special logic to make it happen
-                tile.insert(direction, true);
-            }
-            column.push_back(tile);
+    // Make a filled maze so we get the maze border for free
+    // and don't need any special logic to make it happen
+    WallGrid maze(width, height);
+    for (int x = 0; x < static_cast<int>(width); x += 1) {
+        for (int y = 0; y < static_cast<int>(height); y += 1) {
+            maze.setWalls(x, y, 0x0f);
         }
-        maze.push_back(column);
     }
 
     int numberOfBits = 0;
     int numberOfBytes = 0;
-    unsigned char byte = getPopBack(&characters);
+    uint32_t byte = next();
 
-    for (auto y = 0; y < height - 1; y++) {
-        for (auto x = 0; x < width; x++) {
+    for (int y = 0; y < static_cast<int>(height) - 1; y += 1) {
+        for (int x = 0; x < static_cast<int>(width); x += 1) {
             bool wallExists = (byte & 1) == 1;
             byte >>= 1;
 
-            maze[x][height - 1 - y][Direction::SOUTH] = wallExists;
-            maze[x][height - 1 - y - 1][Direction::NORTH] = wallExists;
+            maze.setWall(x, height - 1 - y, Direction::SOUTH, wallExists);
+            maze.setWall(x, height - 1 - y - 1, Direction::NORTH, wallExists);
 
             numberOfBits = (numberOfBits + 1) % 8;
 
             if (numberOfBits == 0) {
-                byte = getPopBack(&characters);
+                byte = next();
                 numberOfBytes = (numberOfBytes + 1) % 8; // Add one to the number of bytes
             }
         }
     }
 
     if (numberOfBytes != 0) {
-        for (auto i = 0; i < (7 - numberOfBytes); i += 1) {
-            getPopBack(&characters); // Padding so the number of bytes is a muliple of 8
+        for (int i = 0; i < (7 - numberOfBytes); i += 1) {
+            next(); // Padding so the number of bytes is a muliple of 8
         }
         numberOfBytes = 0;
     }
     numberOfBits = 0;
 
-    byte = getPopBack(&characters);
+    byte = next();
 
-    for (auto x = 0; x < width - 1; x++) {
-        for (auto y = 0; y < height; y++) {
+    for (int x = 0; x < static_cast<int>(width) - 1; x += 1) {
+        for (int y = 0; y < static_cast<int>(height); y += 1) {
             bool wallExists = (byte & 1) == 1;
             byte >>= 1;
 
-            maze[x][height - 1 - y][Direction::EAST] = wallExists;
-            maze[x + 1][height - 1 - y][Direction::WEST] = wallExists;
-            
+            maze.setWall(x, height - 1 - y, Direction::EAST, wallExists);
+            maze.setWall(x + 1, height - 1 - y, Direction::WEST, wallExists);
+
             numberOfBits = (numberOfBits + 1) % 8;
 
             if (numberOfBits == 0) {
-                byte = getPopBack(&characters);
+                byte = next();
                 numberOfBytes = (numberOfBytes + 1) % 8; // Add one to the number of bytes
             }
         }
@@ -324,325 +387,396 @@ BasicMaze MazeFileUtilities::deserializeMz2Type(const QByteArray& bytes) {
     return maze;
 }
 
-BasicMaze MazeFileUtilities::deserializeNumType(const QByteArray& bytes) {
-
-    // The maze to be returned
-    BasicMaze maze;
-
-    // The column to be appended
-    QVector<BasicTile> column;
-
-    // Iterate over all of the lines
-    QStringList lines = SimUtilities::splitLines(QString(bytes).trimmed());
-    for (QString line : lines) {
-
-        // Put the tokens in a vector
-        QStringList tokens = line.split(" ", QString::SkipEmptyParts);
-        if (tokens.size() < 6) {
+WallGrid MazeFileUtilities::deserializeNumType(const QByteArray& bytes) {
+
+    // Each line is "x y n e s w", where the walls are in the order of
+    // DIRECTIONS(). The lines are tokenized in place, into a fixed array.
+    static const int NUM_TOKENS = 6;
+    const char* data = bytes.constData();
+    QVector<QPair<int, int>> lines = getLines(bytes);
+    QVector<int> values;
+    values.reserve(lines.size() * NUM_TOKENS);
+    int width = 0;
+    int height = 0;
+    for (const QPair<int, int>& line : lines) {
+        int tokens[NUM_TOKENS];
+        int count = 0;
+        int position = line.first;
+        int end = line.first + line.second;
+        while (position < end) {
+            if (data[position] == ' ') {
+                position += 1;
+                continue;
+            }
+            int value = 0;
+            if (!parseInt(data, &position, end, &value)) {
+                throw std::runtime_error("Non-numeric or out of range token");
+            }
+            if (count < NUM_TOKENS) {
+                tokens[count] = value;
+            }
+            count += 1;
+        }
+        if (count == 0) {
+            continue;
+        }
+        if (count < NUM_TOKENS) {
             throw std::runtime_error("Not enough tokens");
         }
-        for (const QString& token : tokens) {
-            if (!SimUtilities::isInt(token)) {
-                throw std::runtime_error("Non-numeric token");
-            }
+        if (tokens[0] < 0 || tokens[1] < 0) {
+            throw std::runtime_error("Negative tile position");
         }
-
-        // Fill the BasicTile object with the values
-        BasicTile tile;
-        for (Direction direction : DIRECTIONS()) {
-            QString num = tokens.at(2 + DIRECTIONS().indexOf(direction));
-            tile.insert(
-                direction,
-                SimUtilities::strToInt(num) == 1
-            );
+        width = std::max(width, tokens[0] + 1);
+        height = std::max(height, tokens[1] + 1);
+        for (int i = 0; i < NUM_TOKENS; i += 1) {
+            values.append(tokens[i]);
         }
+    }
 
-        // If the tile belongs to a new column,
-        // append the current column and empty it
-        if (maze.size() < SimUtilities::strToInt(tokens.at(0))) {
-            maze.push_back(column);
-            column.clear();
+    // Every tile must appear exactly once
+    if (values.size() / NUM_TOKENS != static_cast<qint64>(width) * height) {
+        throw std::runtime_error("Missing or duplicate tiles");
+    }
+    WallGrid maze(width, height);
+    QVector<bool> seen(width * height, false);
+    for (int i = 0; i < values.size(); i += NUM_TOKENS) {
+        int x = values.at(i);
+        int y = values.at(i + 1);
+        if (seen.at(y * width + x)) {
+            throw std::runtime_error("Duplicate tile");
+        }
+        seen[y * width + x] = true;
+        for (int j = 0; j < DIRECTIONS().size(); j += 1) {
+            maze.setWall(x, y, DIRECTIONS().at(j), values.at(i + 2 + j) == 1);
         }
-
-        // Always append the current tile to the current column
-        column.push_back(tile);
     }
 
-    // Make sure to append the last column
-    maze.push_back(column);
-
     return maze;
 }
 
-QByteArray MazeFileUtilities::serializeMapType(const BasicMaze& maze) {
-
-    // TODO: MACK - FIXME
-    // TODO: MACK - deduplicate this with the maze algo code
-    /*
-    // The characters to use in the file
-    char post = '+';
-    char space = ' ';
-    char vertical = '|';
-    char horizontal = '-';
-
-    // A blank line, and a list of all lines to be written
-    QString blankLine(4 * maze.size() + 1, space);
-    QVector<QString> upsideDownLines {blankLine};
-
-    // For all tiles in the maze
-    for (int i = 0; i < maze.size(); i += 1) {
-        for (int j = 0; j < maze.at(i).size(); j += 1) {
-
-            // Insert more lines if necessary
-            if (upsideDownLines.size() <= 2 * j + 1) {
-                upsideDownLines.push_back(blankLine);
-                upsideDownLines.push_back(blankLine);
-            }
-
-            // Insert posts at the boundaries
-            int left = 4 * i;
-            int right = 4 * (i + 1);
-            int up = 2 * (j + 1);
-            int down = 2 * j;
-            upsideDownLines.at(down).at(left) = post;
-            upsideDownLines.at(down).at(right) = post;
-            upsideDownLines.at(up).at(left) = post;
-            upsideDownLines.at(up).at(right) = post;
-
-            // Insert walls if they exist
-            if (maze.at(i).at(j).at(Direction::NORTH)) {
-                for (int k = 0; k < 3; k += 1) {
-                    upsideDownLines.at(up).at(left + 1 + k) = horizontal;
-                }
-            }
-            if (maze.at(i).at(j).at(Direction::SOUTH)) {
-                for (int k = 0; k < 3; k += 1) {
-                    upsideDownLines.at(down).at(left + 1 + k) = horizontal;
-                }
-            }
-            if (maze.at(i).at(j).at(Direction::EAST)) {
-                upsideDownLines.at(down + 1).at(right) = vertical;
-            }
-            if (maze.at(i).at(j).at(Direction::WEST)) {
-                upsideDownLines.at(down + 1).at(left) = vertical;
-            }
+WallGrid MazeFileUtilities::readMmswRecord(
+        const QByteArray& bytes,
+        int* offset,
+        quint32* seed) {
+
+    // The magic, the seed, the width and the height, and then four bits of
+    // walls per tile, in row-major order and low nibble first, which happens
+    // to match the bit layout of the wall grid
+    const uchar* data = reinterpret_cast<const uchar*>(bytes.constData()) + *offset;
+    int remaining = bytes.size() - *offset;
+    if (
+        remaining < MMSW_HEADER_SIZE ||
+        std::memcmp(data, MMSW_MAGIC, sizeof(MMSW_MAGIC)) != 0
+    ) {
+        throw std::runtime_error("Invalid MMSW record header");
+    }
+    int width = qFromLittleEndian<quint16>(data + 8);
+    int height = qFromLittleEndian<quint16>(data + 10);
+    if (width == 0 || height == 0) {
+        throw std::runtime_error("Invalid MMSW maze size");
+    }
+    qint64 numBytes = (static_cast<qint64>(width) * height + 1) / 2;
+    if (remaining - MMSW_HEADER_SIZE < numBytes) {
+        throw std::runtime_error("Not enough MMSW data for the maze size");
+    }
+
+    WallGrid maze(width, height);
+    const uchar* walls = data + MMSW_HEADER_SIZE;
+    for (int y = 0; y < height; y += 1) {
+        for (int x = 0; x < width; x += 1) {
+            int index = y * width + x;
+            maze.setWalls(x, y, (walls[index / 2] >> (4 * (index % 2))) & 0x0f);
         }
     }
-
-    // Flip the lines so that they're right side up
-    QVector<QString> rightSideUpLines;
-    for (int i = upsideDownLines.size() - 1; i >= 0; i -= 1) {
-        rightSideUpLines.push_back(upsideDownLines.at(i));
+    if (seed != nullptr) {
+        *seed = qFromLittleEndian<quint32>(data + 4);
     }
-
-    // Create the stream
-    std::ofstream file(mazeFilePath.toStdString(), std::ios::trunc);
-
-    // Make sure the file is open
-    if (!file.is_open()) {
-        return false;
-    }
-
-    // Write to the file
-    for (QString line : rightSideUpLines) {
-        file << line << '\n'; // std::endl flushes the buffer everytime its called
-    }
-
-    // Make sure to close the file
-    file.close();
-
-    // Return success
-    return true;
-    */
-    throw std::exception();
+    *offset += MMSW_HEADER_SIZE + static_cast<int>(numBytes);
+    return maze;
 }
 
-QByteArray MazeFileUtilities::serializeMazType(const BasicMaze& maze) {
-
-    // TODO: MACK - FIXME
-    /*
-    if (maze.size() != 16) {
-        return false; // We only support 16x16 mazes
+int MazeFileUtilities::getMmswRecordSize(const QByteArray& bytes, int offset) {
+    const uchar* data = reinterpret_cast<const uchar*>(bytes.constData()) + offset;
+    int remaining = bytes.size() - offset;
+    if (remaining < MMSW_HEADER_SIZE) {
+        return MMSW_HEADER_SIZE;
     }
-
-    if (maze.at(0).size() != 16) {
-        // Lets assume the maze is at least rectangular. I don't know if it cannot be
-
-        return false; // We only support 16x16 mazes
+    if (std::memcmp(data, MMSW_MAGIC, sizeof(MMSW_MAGIC)) != 0) {
+        return -1;
     }
-
-    // Create the stream
-    std::ofstream file(mazeFilePath.toStdString(), std::ios::trunc | std::ios::binary);
-    file.imbue(std::locale::classic());
-
-    // Make sure the file is open
-    if (!file.is_open()) {
-        return false;
+    int width = qFromLittleEndian<quint16>(data + 8);
+    int height = qFromLittleEndian<quint16>(data + 10);
+    qint64 size = MMSW_HEADER_SIZE + (static_cast<qint64>(width) * height + 1) / 2;
+    if (width == 0 || height == 0 || std::numeric_limits<int>::max() < size) {
+        return -1;
     }
+    return static_cast<int>(size);
+}
 
-    // We hardcode values becuase we specifically checked that the maze
-    // was 16x16 above.
-    for (auto x = 0; x < 16; x++) {
-        for (auto y = 0; y < 16; y++) {
-            BasicTile tile = maze.at(x).at(y);
-            //Each byte reprsents the walls like this: 'X X X X W S E N'
-            int representation = (tile[Direction::WEST]  << 3) +
-                                 (tile[Direction::SOUTH] << 2) +
-                                 (tile[Direction::EAST]  << 1) +
-                                 (tile[Direction::NORTH] << 0);
-
-            file.put(representation);
+void MazeFileUtilities::writeMmswRecord(
+        const WallGrid& maze,
+        quint32 seed,
+        QIODevice* device) {
+
+    if (
+        maze.getWidth() == 0 || maze.getHeight() == 0 ||
+        0xffff < maze.getWidth() || 0xffff < maze.getHeight()
+    ) {
+        throw std::runtime_error("Invalid MMSW maze size");
+    }
+    uchar header[MMSW_HEADER_SIZE];
+    std::memcpy(header, MMSW_MAGIC, sizeof(MMSW_MAGIC));
+    qToLittleEndian<quint32>(seed, header + 4);
+    qToLittleEndian<quint16>(maze.getWidth(), header + 8);
+    qToLittleEndian<quint16>(maze.getHeight(), header + 10);
+    device->write(reinterpret_cast<const char*>(header), MMSW_HEADER_SIZE);
+
+    // Rows needn't end on byte boundaries, so the tiles are packed together
+    int width = maze.getWidth();
+    int height = maze.getHeight();
+    QByteArray walls((width * height + 1) / 2, '\0');
+    for (int y = 0; y < height; y += 1) {
+        for (int x = 0; x < width; x += 1) {
+            int index = y * width + x;
+            walls[index / 2] = static_cast<char>(
+                walls.at(index / 2) | (maze.getWalls(x, y) << (4 * (index % 2))));
         }
     }
-
-    // Make sure to close the file
-    file.close();
-
-    // Return success
-    return true;
-    */
-    throw std::exception();
+    device->write(walls);
 }
 
-QByteArray MazeFileUtilities::serializeMz2Type(const BasicMaze& maze) {
+QVector<QPair<int, int>> MazeFileUtilities::getLines(const QByteArray& bytes) {
 
-    // TODO: MACK - FIXME
-    /*
-    // Create the stream
-    std::ofstream file(mazeFilePath.toStdString(), std::ios::trunc | std::ios::binary);
-    file.imbue(std::locale::classic());
-
-    // Make sure the file is open
-    if (!file.is_open()) {
-        return false;
+    // Returns the (offset, length) of each line of the bytes, with leading and
+    // trailing whitespace of the whole array trimmed, and line endings of
+    // "\n", "\r\n", or "\r"
+    const char* data = bytes.constData();
+    int begin = 0;
+    int end = bytes.size();
+    while (begin < end && isWhitespace(data[begin])) {
+        begin += 1;
     }
-
-    file.put(0);  // Hardcoded name is: 'Auto Generated Maze' (length: 19)
-    file.put(19); // I am assuming that the length is encoded in 16 bits.
-                  // The spec is unclear
-    
-    file << "Auto Generated Maze";
-
-    uint32_t width = maze.size();
-    uint32_t height = 0;
-
-    if (maze.size() > 0) {
-        height = maze.at(0).size();
-        if (height == 0)
-            return false; // I don't think this should be allowed?
+    while (begin < end && isWhitespace(data[end - 1])) {
+        end -= 1;
     }
-    else
-        return false; // I don't think this should be allowed?
-
-    file.put(width >> 24); // width
-    file.put(width >> 16);
-    file.put(width >> 8);
-    file.put(width);
-
-    file.put(height >> 24); // height
-    file.put(height >> 16);
-    file.put(height >> 8);
-    file.put(height);
-
-    int numberOfBits = 0;
-    int numberOfBytes = 0;
-    unsigned char toWrite = 0;
-
-    for (auto y = 0; y < height - 1; y++) {
-        for (auto x = 0; x < width; x++) {
-            BasicTile tile = maze.at(x).at(height - 1 - y);
-
-            toWrite >>= 1;
-            if (tile[Direction::SOUTH] == true) {
-                toWrite |= 1 << 7; // Set the MSB bit as one
-            }
-            numberOfBits = (numberOfBits + 1) % 8;
 
-            if (numberOfBits == 0) {
-                file.put(toWrite); // Write the byte when it is full
-                numberOfBytes = (numberOfBytes + 1) % 8; // Add one to the number of bytes
+    QVector<QPair<int, int>> lines;
+    if (begin == end) {
+        return lines;
+    }
+    int start = begin;
+    for (int i = begin; i < end; i += 1) {
+        if (data[i] == '\n' || data[i] == '\r') {
+            lines.append({start, i - start});
+            if (data[i] == '\r' && i + 1 < end && data[i + 1] == '\n') {
+                i += 1;
             }
+            start = i + 1;
         }
     }
+    lines.append({start, end - start});
+    return lines;
+}
 
-    if (numberOfBits != 0) {
-        file.put(toWrite >> (8 - numberOfBits));
-        numberOfBits = 0; // Write the last byte out 
-    }
-    
-    if (numberOfBytes != 0) {
-        for (auto i = 0; i < (7 - numberOfBytes); i += 1 {
-            file.put(0); // Padding so the number of bytes is a muliple of 8
+bool MazeFileUtilities::parseInt(
+        const char* data,
+        int* position,
+        int end,
+        int* value) {
+
+    // Parses an optionally negative integer that ends at whitespace or at the
+    // end, advancing the position past it. Numbers beyond MAX_TEXT_NUMBER are
+    // rejected as soon as they get there, before they can overflow.
+    int i = *position;
+    bool negative = false;
+    if (i < end && data[i] == '-') {
+        negative = true;
+        i += 1;
+    }
+    int digits = 0;
+    int result = 0;
+    while (i < end && '0' <= data[i] && data[i] <= '9') {
+        result = result * 10 + (data[i] - '0');
+        if (MAX_TEXT_NUMBER < result) {
+            return false;
         }
-        numberOfBytes = 0;
+        digits += 1;
+        i += 1;
+    }
+    if (digits == 0 || (i < end && !isWhitespace(data[i]))) {
+        return false;
     }
+    *position = i;
+    *value = negative ? -result : result;
+    return true;
+}
 
-    for (auto x = 0; x < width - 1; x++) {
-        for (auto y = 0; y < height; y++) {
-            BasicTile tile = maze.at(x).at(height - 1 - y);
+bool MazeFileUtilities::isWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
 
-            toWrite >>= 1;
-            if (tile[Direction::EAST] == true) {
-                toWrite |= 1 << 7; // Set the MSB bit as one
+void MazeFileUtilities::writeMapType(const WallGrid& maze, QIODevice* device) {
+
+    // Each tile is three characters wide, between posts. Walls shared by two
+    // tiles are drawn if either of the tiles has them, and lines are written
+    // from the top of the maze down, reusing a single line buffer.
+    static const char POST = '+';
+    static const char SPACE = ' ';
+    static const char VERTICAL = '|';
+    static const char HORIZONTAL = '-';
+    int width = maze.getWidth();
+    int height = maze.getHeight();
+    QByteArray line(4 * width + 2, SPACE);
+    line[line.size() - 1] = '\n';
+    char* data = line.data();
+
+    // The lines of posts are at the tops of the rows, from y = height (the
+    // top of the maze) down to y = 0 (the bottom), with a line of vertical
+    // walls below each of them but the last
+    for (int y = height; 0 <= y; y -= 1) {
+        for (int x = 0; x < width; x += 1) {
+            bool isWall =
+                (y < height && maze.isWall(x, y, Direction::SOUTH)) ||
+                (0 < y && maze.isWall(x, y - 1, Direction::NORTH));
+            data[4 * x] = POST;
+            for (int k = 1; k <= 3; k += 1) {
+                data[4 * x + k] = isWall ? HORIZONTAL : SPACE;
             }
-            numberOfBits = (numberOfBits + 1) % 8;
-
-            if (numberOfBits == 0) {
-                file.put(toWrite); // Write the byte when it is full
-                numberOfBytes = (numberOfBytes + 1) % 8; // Add one to the number of bytes
+        }
+        data[4 * width] = POST;
+        device->write(line);
+        if (y == 0) {
+            break;
+        }
+        for (int x = 0; x <= width; x += 1) {
+            bool isWall =
+                (x < width && maze.isWall(x, y - 1, Direction::WEST)) ||
+                (0 < x && maze.isWall(x - 1, y - 1, Direction::EAST));
+            data[4 * x] = isWall ? VERTICAL : SPACE;
+            if (x < width) {
+                for (int k = 1; k <= 3; k += 1) {
+                    data[4 * x + k] = SPACE;
+                }
             }
         }
+        device->write(line);
     }
+}
+
+void MazeFileUtilities::writeMazType(const WallGrid& maze, QIODevice* device) {
 
-    if (numberOfBits != 0) {
-        file.put(toWrite >> (8 - numberOfBits));
+    // This maze file format is written to only accomodate 16x16 mazes
+    if (maze.getWidth() != 16 || maze.getHeight() != 16) {
+        throw std::runtime_error("MAZ files only support 16x16 mazes");
     }
 
-    if (numberOfBytes != 0) {
-        for (auto i = 0; i < (7 - numberOfBytes); i += 1 {
-            file.put(0); // Padding so the number of bytes is a muliple of 8
+    // Each byte represents the walls like this: 'X X X X W S E N', which
+    // happens to match the bit layout of the wall grid
+    QByteArray bytes(256, 0);
+    for (int x = 0; x < 16; x += 1) {
+        for (int y = 0; y < 16; y += 1) {
+            bytes[x * 16 + y] = static_cast<char>(maze.getWalls(x, y));
         }
     }
-
-    // Make sure to close the file
-    file.close();
-
-    // Return success
-    return true;
-    */
-    throw std::exception();
+    device->write(bytes);
 }
 
-QByteArray MazeFileUtilities::serializeNumType(const BasicMaze& maze) {
-
-    // TODO: MACK - FIXME
-    /*
-    // Create the stream
-    std::ofstream file(mazeFilePath.toStdString(), std::ios::trunc);
+void MazeFileUtilities::writeMz2Type(const WallGrid& maze, QIODevice* device) {
+
+    // An empty title, and then the width and height, big-endian
+    uint32_t width = maze.getWidth();
+    uint32_t height = maze.getHeight();
+    if (width == 0 || height == 0) {
+        throw std::runtime_error("Invalid MZ2 maze size");
+    }
+    char header[10] = {0, 0};
+    for (int i = 0; i < 4; i += 1) {
+        header[2 + i] = static_cast<char>(width >> (24 - 8 * i));
+        header[6 + i] = static_cast<char>(height >> (24 - 8 * i));
+    }
+    device->write(header, sizeof(header));
+
+    // The south walls of all but the bottom row, from the top row down, and
+    // then the east walls of all but the rightmost column, from the left
+    // column rightward, each read from the top down. The bits of each byte are
+    // filled from least to most significant.
+    int northSouthBits = (height - 1) * width;
+    QByteArray section(getMz2SectionSize(northSouthBits), 0);
+    for (int y = 0; y < static_cast<int>(height) - 1; y += 1) {
+        for (int x = 0; x < static_cast<int>(width); x += 1) {
+            if (maze.isWall(x, height - 1 - y, Direction::SOUTH)) {
+                int bit = y * width + x;
+                section[bit / 8] =
+                    static_cast<char>(section.at(bit / 8) | (1 << (bit % 8)));
+            }
+        }
+    }
+    device->write(section);
 
-    // Make sure the file is open
-    if (!file.is_open()) {
-        return false;
+    int eastWestBits = (width - 1) * height;
+    section.fill(0, getMz2SectionSize(eastWestBits));
+    for (int x = 0; x < static_cast<int>(width) - 1; x += 1) {
+        for (int y = 0; y < static_cast<int>(height); y += 1) {
+            if (maze.isWall(x, height - 1 - y, Direction::EAST)) {
+                int bit = x * height + y;
+                section[bit / 8] =
+                    static_cast<char>(section.at(bit / 8) | (1 << (bit % 8)));
+            }
+        }
     }
+    device->write(section);
+}
 
-    // Write to the file
-    for (int x = 0; x < maze.size(); x += 1) {
-        for (int y = 0; y < maze.at(x).size(); y += 1) {
-            file << x << " " << y;
+void MazeFileUtilities::writeNumType(const WallGrid& maze, QIODevice* device) {
+
+    // Each line is "x y n e s w", where the walls are in the order of
+    // DIRECTIONS(). The lines of a column are written together, reusing a
+    // single buffer that is large enough for any of the columns.
+    QByteArray lines;
+    lines.reserve(maze.getHeight() * (2 * 11 + 2 * DIRECTIONS().size() + 2));
+    for (int x = 0; x < maze.getWidth(); x += 1) {
+        lines.resize(0);
+        for (int y = 0; y < maze.getHeight(); y += 1) {
+            appendInt(&lines, x);
+            lines.append(' ');
+            appendInt(&lines, y);
             for (Direction direction : DIRECTIONS()) {
-                file << " " << (maze.at(x).at(y).at(direction) ? 1 : 0);
+                lines.append(' ');
+                lines.append(maze.isWall(x, y, direction) ? '1' : '0');
             }
-            file << "\n"; // std::endl flushes the buffer everytime its called
+            lines.append('\n');
         }
+        device->write(lines);
     }
+}
 
-    // Make sure to close the file
-    file.close();
+int MazeFileUtilities::getMz2SectionSize(int numBits) {
+    // The number of bytes that deserializeMz2Type consumes for a section of
+    // bits, including the padding that follows it
+    int numBytes = numBits / 8;
+    int padding = numBytes % 8 == 0 ? 0 : 7 - numBytes % 8;
+    return 1 + numBytes + padding;
+}
 
-    // Return success
-    return true;
-    */
-    throw std::exception();
+void MazeFileUtilities::appendInt(QByteArray* bytes, int value) {
+    // Appends the decimal digits of the value without any allocation, as
+    // long as the array has enough capacity reserved
+    char digits[12];
+    int count = 0;
+    bool negative = value < 0;
+    qint64 remaining = std::abs(static_cast<qint64>(value));
+    do {
+        digits[count] = static_cast<char>('0' + remaining % 10);
+        remaining /= 10;
+        count += 1;
+    } while (0 < remaining);
+    if (negative) {
+        bytes->append('-');
+    }
+    while (0 < count) {
+        count -= 1;
+        bytes->append(digits[count]);
+    }
 }
 
-} //namespace mms
+} // namespace mms
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <QByteArray>
+#include <QIODevice>
+#include <QPair>
 #include <QString>
+#include <QStringList>
+#include <QVector>
 
-#include "BasicMaze.h"
 #include "MazeFileType.h"
+#include "WallGrid.h"
 
 namespace mms {
 
@@ -14,25 +18,73 @@ public:
 
     MazeFileUtilities() = delete;
 
-    static BasicMaze load(const QString& path);
-    static BasicMaze loadBytes(const QByteArray& bytes);
+    // Loads a maze, using the suffix (if any) and then the contents of the
+    // file to determine its type; throws if the maze can't be parsed
+    static WallGrid load(const QString& path);
+    static WallGrid loadBytes(const QByteArray& bytes, const QString& suffix = "");
 
+    // Finds every maze file (of any MazeFileType) in the directories,
+    // recursively, in a stable order
+    static QStringList findMazeFiles(const QStringList& directories);
+
+    // Determines the type of a maze file without parsing it
+    static MazeFileType detectType(const QByteArray& bytes, const QString& suffix);
+
+    // Writes a maze to a file of the given type, streaming it out rather than
+    // serializing it in memory first; throws if the maze can't be written
+    // (e.g., a MAZ file of a maze that isn't 16x16), leaving any existing
+    // file untouched
     static void save(
-        const BasicMaze& maze,
+        const WallGrid& maze,
         const QString& path,
         MazeFileType type);
 
+    // Reads the binary record (as written by the maze algorithm templates)
+    // that starts at the offset, advancing the offset past it, and optionally
+    // returning the seed that generated it; throws if the record is invalid.
+    // A stream of records is just records laid end to end.
+    static WallGrid readMmswRecord(
+        const QByteArray& bytes,
+        int* offset,
+        quint32* seed = nullptr);
+    // Returns the size of the record that starts at the offset, which may be
+    // more than the bytes available, or -1 if its header is invalid; if the
+    // header itself isn't all there yet, returns the size of the header.
+    static int getMmswRecordSize(const QByteArray& bytes, int offset = 0);
+    static void writeMmswRecord(
+        const WallGrid& maze,
+        quint32 seed,
+        QIODevice* device);
+
 private:
 
-    static BasicMaze deserializeMapType(const QByteArray& bytes);
-    static BasicMaze deserializeMazType(const QByteArray& bytes);
-    static BasicMaze deserializeMz2Type(const QByteArray& bytes);
-    static BasicMaze deserializeNumType(const QByteArray& bytes);
+    static const char MMSW_MAGIC[4];
+    static const int MMSW_HEADER_SIZE = 12;
+
+    static WallGrid deserializeMapType(const QByteArray& bytes);
+    static WallGrid deserializeMazType(const QByteArray& bytes);
+    static WallGrid deserializeMz2Type(const QByteArray& bytes);
+    static WallGrid deserializeNumType(const QByteArray& bytes);
+
+    static void writeMapType(const WallGrid& maze, QIODevice* device);
+    static void writeMazType(const WallGrid& maze, QIODevice* device);
+    static void writeMz2Type(const WallGrid& maze, QIODevice* device);
+    static void writeNumType(const WallGrid& maze, QIODevice* device);
+
+    // The largest width or height of an MZ2 maze that will be read
+    static const quint32 MAX_MZ2_DIMENSION = 4096;
+    static int getMz2SectionSize(int numBits);
+
+    // The largest magnitude of a number in a text maze file, which is the
+    // largest width or height of an MMSW maze, so that no more digits than
+    // that are ever accumulated
+    static const int MAX_TEXT_NUMBER = 65535;
 
-    static QByteArray serializeMapType(const BasicMaze& maze);
-    static QByteArray serializeMazType(const BasicMaze& maze);
-    static QByteArray serializeMz2Type(const BasicMaze& maze);
-    static QByteArray serializeNumType(const BasicMaze& maze);
+    // Allocation-free tokenizing helpers for the text formats
+    static QVector<QPair<int, int>> getLines(const QByteArray& bytes);
+    static bool parseInt(const char* data, int* position, int end, int* value);
+    static bool isWhitespace(char c);
+    static void appendInt(QByteArray* bytes, int value);
 };
 
 } // namespace mms
@@ -4,10 +4,13 @@
 #include <QFileInfo>
 #include <QHBoxLayout>
 #include <QHeaderView>
+#include <QPair>
 #include <QPushButton>
 #include <QTableWidget>
 #include <QVBoxLayout>
+#include <QVector>
 
+#include "MazeCorpus.h"
 #include "MazeFileType.h"
 #include "Resources.h"
 #include "SettingsMazeFiles.h"
@@ -49,8 +52,15 @@ MazeFilesTab::MazeFilesTab() : m_table(new QTableWidget()) {
     connect(m_table, &QTableWidget::itemSelectionChanged, this, [=](){
         const auto& selected = m_table->selectedItems();
         if (0 < selected.size()) {
-            QString path = m_table->item(m_table->currentRow(), 1)->text();
-            emit mazeFileChanged(path);
+            int row = m_table->currentRow();
+            QString path = m_table->item(row, 1)->text();
+            int index = m_table->item(row, 0)->data(Qt::UserRole).toInt();
+            if (index < 0) {
+                emit mazeFileChanged(path);
+            }
+            else {
+                emit corpusEntryChanged(path, index);
+            }
         }
     });
     layout->addWidget(m_table);
@@ -64,6 +74,7 @@ void MazeFilesTab::import() {
     for (const QString& suffix : MAZE_FILE_TYPE_TO_SUFFIX()) {
         suffixes.append(QString("*.") + suffix);
     }
+    suffixes.append(QString("*.") + MazeCorpus::SUFFIX);
     QStringList paths = QFileDialog::getOpenFileNames(
         this,
         "Import Maze File(s)",
@@ -94,13 +105,35 @@ void MazeFilesTab::refresh() {
     QStringList mazeFiles;
     mazeFiles += Resources::getMazes();
     mazeFiles += SettingsMazeFiles::getSettingsMazeFiles();
-    m_table->setRowCount(mazeFiles.size());
-    for (int i = 0; i < mazeFiles.size(); i += 1) {
-        QString path = mazeFiles.at(i);
-        QString name = QFileInfo(path).fileName();
-        m_table->setItem(i, 0, new QTableWidgetItem(name));
-        m_table->setItem(i, 1, new QTableWidgetItem(path));
+
+    // Each maze file is a row, and so is each maze of a corpus; the index of
+    // the maze within the corpus (or -1) is stored with the name
+    QVector<QPair<QString, QPair<QString, int>>> rows;
+    for (const QString& path : mazeFiles) {
+        if (QFileInfo(path).suffix() != MazeCorpus::SUFFIX) {
+            rows.append({QFileInfo(path).fileName(), {path, -1}});
+            continue;
+        }
+        MazeCorpus* corpus = MazeCorpus::open(path);
+        if (corpus == nullptr) {
+            continue;
+        }
+        for (int i = 0; i < corpus->size(); i += 1) {
+            rows.append({corpus->getEntry(i).name, {path, i}});
+        }
+        delete corpus;
     }
+
+    // Sorting must be disabled while the rows are being inserted
+    m_table->setSortingEnabled(false);
+    m_table->setRowCount(rows.size());
+    for (int i = 0; i < rows.size(); i += 1) {
+        QTableWidgetItem* nameItem = new QTableWidgetItem(rows.at(i).first);
+        nameItem->setData(Qt::UserRole, rows.at(i).second.second);
+        m_table->setItem(i, 0, nameItem);
+        m_table->setItem(i, 1, new QTableWidgetItem(rows.at(i).second.first));
+    }
+    m_table->setSortingEnabled(true);
     m_table->resizeColumnsToContents();
 }
 
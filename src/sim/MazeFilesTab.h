@@ -16,6 +16,7 @@ public:
 signals:
 
     void mazeFileChanged(const QString& path);
+    void corpusEntryChanged(const QString& path, int index);
 
 private:
 
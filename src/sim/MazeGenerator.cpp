@@ -0,0 +1,93 @@
+#include "MazeGenerator.h"
+
+#include "../maze/algos/tomasz/Algo.h"
+#include "../maze/algos/tomasz/Interface.h"
+
+#include "Assert.h"
+
+namespace mms {
+
+const double MazeGenerator::RANDOM_WALL_PROBABILITY = 0.40;
+
+MazeGenerator::MazeGenerator(MazeGeneratorType type, int width, int height) :
+        m_type(type),
+        m_width(width),
+        m_height(height),
+        m_tomaszSuccess(true),
+        m_tomaszInterface(nullptr),
+        m_tomaszAlgo(nullptr) {
+    ASSERT_LT(0, width);
+    ASSERT_LT(0, height);
+    if (m_type == MazeGeneratorType::TOMASZ) {
+        m_tomaszInterface = new Interface(width, height, 0, &m_tomaszSuccess);
+        m_tomaszAlgo = new Algo();
+    }
+}
+
+MazeGenerator::~MazeGenerator() {
+    delete m_tomaszAlgo;
+    delete m_tomaszInterface;
+}
+
+WallGrid MazeGenerator::generate(quint32 seed) {
+    switch (m_type) {
+        case MazeGeneratorType::RANDOM:
+            return generateRandom(seed);
+        case MazeGeneratorType::TOMASZ:
+            return generateTomasz(seed);
+    }
+    ASSERT_NEVER_RUNS();
+    return WallGrid();
+}
+
+WallGrid MazeGenerator::generateRandom(quint32 seed) {
+
+    // Unlike the random_c++ algorithm, which decides each side of each wall
+    // separately, decide each wall once and always enclose the maze, so that
+    // the mazes at least have a chance of being valid
+    m_random.seed(seed);
+    std::bernoulli_distribution isWall(RANDOM_WALL_PROBABILITY);
+    WallGrid walls(m_width, m_height);
+    for (int y = 0; y < m_height; y += 1) {
+        for (int x = 0; x < m_width; x += 1) {
+            if (x == 0) {
+                walls.setWall(x, y, Direction::WEST, true);
+            }
+            if (y == 0) {
+                walls.setWall(x, y, Direction::SOUTH, true);
+            }
+            bool north = y == m_height - 1 || isWall(m_random);
+            bool east = x == m_width - 1 || isWall(m_random);
+            walls.setWall(x, y, Direction::NORTH, north);
+            walls.setWall(x, y, Direction::EAST, east);
+            if (y < m_height - 1) {
+                walls.setWall(x, y + 1, Direction::SOUTH, north);
+            }
+            if (x < m_width - 1) {
+                walls.setWall(x + 1, y, Direction::WEST, east);
+            }
+        }
+    }
+    return walls;
+}
+
+WallGrid MazeGenerator::generateTomasz(quint32 seed) {
+
+    // The interface packs the walls exactly as the wall grid does (see
+    // Interface::getPackedWalls), but only byte by byte
+    m_tomaszInterface->reset(seed);
+    m_tomaszAlgo->generate(m_tomaszInterface);
+    ASSERT_TR(m_tomaszSuccess);
+    const std::vector<unsigned char>& packedWalls =
+        m_tomaszInterface->getPackedWalls();
+    WallGrid walls(m_width, m_height);
+    for (int y = 0; y < m_height; y += 1) {
+        for (int x = 0; x < m_width; x += 1) {
+            int index = y * m_width + x;
+            walls.setWalls(x, y, (packedWalls.at(index / 2) >> (4 * (index % 2))) & 0x0f);
+        }
+    }
+    return walls;
+}
+
+} // namespace mms
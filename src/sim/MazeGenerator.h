@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <random>
+
+#include "MazeGeneratorType.h"
+#include "WallGrid.h"
+
+// The tomasz maze algorithm, which is compiled into the simulator (see
+// sim.pro), lives outside of the namespace
+class Algo;
+class Interface;
+
+namespace mms {
+
+// Generates mazes of a single size in-process, rather than by running a maze
+// algorithm. A generator reuses its memory from one maze to the next, so each
+// thread should have its own.
+class MazeGenerator {
+
+public:
+
+    MazeGenerator(MazeGeneratorType type, int width, int height);
+    ~MazeGenerator();
+
+    MazeGenerator(const MazeGenerator&) = delete;
+    MazeGenerator& operator=(const MazeGenerator&) = delete;
+
+    // A given seed always generates the same maze
+    WallGrid generate(quint32 seed);
+
+private:
+
+    // The chance of a wall between two tiles, as in the random_c++ algorithm
+    static const double RANDOM_WALL_PROBABILITY;
+
+    MazeGeneratorType m_type;
+    int m_width;
+    int m_height;
+
+    std::mt19937 m_random;
+    WallGrid generateRandom(quint32 seed);
+
+    bool m_tomaszSuccess;
+    Interface* m_tomaszInterface;
+    Algo* m_tomaszAlgo;
+    WallGrid generateTomasz(quint32 seed);
+};
+
+} // namespace mms
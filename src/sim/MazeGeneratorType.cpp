@@ -0,0 +1,21 @@
+#include "MazeGeneratorType.h"
+
+#include "ContainerUtilities.h"
+
+namespace mms {
+
+const QMap<MazeGeneratorType, QString>& MAZE_GENERATOR_TYPE_TO_STRING() {
+    static const QMap<MazeGeneratorType, QString> map = {
+        {MazeGeneratorType::RANDOM, "random"},
+        {MazeGeneratorType::TOMASZ, "tomasz"},
+    };
+    return map;
+}
+
+const QMap<QString, MazeGeneratorType>& STRING_TO_MAZE_GENERATOR_TYPE() {
+    static const QMap<QString, MazeGeneratorType> map =
+        ContainerUtilities::inverse(MAZE_GENERATOR_TYPE_TO_STRING());
+    return map;
+}
+
+} // namespace mms
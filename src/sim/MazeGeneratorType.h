@@ -0,0 +1,22 @@
+#pragma once
+
+#include <QDebug>
+#include <QMap>
+#include <QString>
+
+namespace mms {
+
+enum class MazeGeneratorType {
+    RANDOM,
+    TOMASZ,
+};
+
+const QMap<MazeGeneratorType, QString>& MAZE_GENERATOR_TYPE_TO_STRING();
+const QMap<QString, MazeGeneratorType>& STRING_TO_MAZE_GENERATOR_TYPE();
+
+inline QDebug operator<<(QDebug stream, MazeGeneratorType mazeGeneratorType) {
+    stream.noquote() << MAZE_GENERATOR_TYPE_TO_STRING().value(mazeGeneratorType);
+    return stream;
+}
+
+} // namespace mms
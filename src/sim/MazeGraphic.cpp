@@ -1,6 +1,7 @@
 #include "MazeGraphic.h"
 
 #include "Assert.h"
+#include "TileGeometry.h"
 
 namespace mms {
 
@@ -11,12 +12,20 @@ MazeGraphic::MazeGraphic(
         bool tileColorsVisible,
         bool tileFogVisible,
         bool tileTextVisible,
-        bool autopopulateTextWithDistance) {
-    for (int x = 0; x < maze->getWidth(); x += 1) {
-        QVector<TileGraphic> column;
-        for (int y = 0; y < maze->getHeight(); y += 1) {
-            column.push_back(TileGraphic(
+        bool autopopulateTextWithDistance) :
+        m_width(maze->getWidth()),
+        m_height(maze->getHeight()),
+        m_wallTruthVisible(wallTruthVisible) {
+
+    // The tile graphics are stored contiguously, in the same column-major
+    // order as the tiles of the buffer interface
+    TileGeometry geometry(m_width, m_height);
+    m_tileGraphics.reserve(m_width * m_height);
+    for (int x = 0; x < m_width; x += 1) {
+        for (int y = 0; y < m_height; y += 1) {
+            m_tileGraphics.append(TileGraphic(
                 maze->getTile(x, y),
+                geometry,
                 bufferInterface,
                 wallTruthVisible,
                 tileColorsVisible,
@@ -24,93 +33,123 @@ MazeGraphic::MazeGraphic(
                 tileTextVisible,
                 autopopulateTextWithDistance));
         }
-        m_tileGraphics.push_back(column);
     }
+}
+
+void MazeGraphic::setMaze(const Maze* maze) {
     ASSERT_EQ(getWidth(), maze->getWidth());
     ASSERT_EQ(getHeight(), maze->getHeight());
+    for (int x = 0; x < getWidth(); x += 1) {
+        for (int y = 0; y < getHeight(); y += 1) {
+            m_tileGraphics[getIndex(x, y)].setTile(maze->getTile(x, y));
+        }
+    }
+}
+
+void MazeGraphic::reset() {
+    for (TileGraphic& tileGraphic : m_tileGraphics) {
+        tileGraphic.reset();
+    }
+}
+
+QVector<TileGraphicState> MazeGraphic::getTileStates() const {
+    QVector<TileGraphicState> states;
+    states.reserve(m_tileGraphics.size());
+    for (const TileGraphic& tileGraphic : m_tileGraphics) {
+        states.append(tileGraphic.getState());
+    }
+    return states;
+}
+
+void MazeGraphic::setTileStates(const QVector<TileGraphicState>& states) {
+    ASSERT_EQ(states.size(), m_tileGraphics.size());
+    for (int i = 0; i < m_tileGraphics.size(); i += 1) {
+        if (!(m_tileGraphics.at(i).getState() == states.at(i))) {
+            m_tileGraphics[i].setState(states.at(i));
+        }
+    }
 }
 
 void MazeGraphic::setTileColor(int x, int y, Color color) {
     ASSERT_TR(withinMaze(x, y));
-    m_tileGraphics[x][y].setColor(color);
+    m_tileGraphics[getIndex(x, y)].setColor(color);
 }
 
 void MazeGraphic::declareWall(int x, int y, Direction direction, bool isWall) {
     ASSERT_TR(withinMaze(x, y));
-    m_tileGraphics[x][y].declareWall(direction, isWall);
+    m_tileGraphics[getIndex(x, y)].declareWall(direction, isWall);
 }
 
 void MazeGraphic::undeclareWall(int x, int y, Direction direction) {
     ASSERT_TR(withinMaze(x, y));
-    m_tileGraphics[x][y].undeclareWall(direction);
+    m_tileGraphics[getIndex(x, y)].undeclareWall(direction);
 }
 
 void MazeGraphic::setTileFogginess(int x, int y, bool foggy) {
     ASSERT_TR(withinMaze(x, y));
-    m_tileGraphics[x][y].setFogginess(foggy);
+    m_tileGraphics[getIndex(x, y)].setFogginess(foggy);
 }
 
 void MazeGraphic::setTileText(int x, int y, const QString& text) {
     ASSERT_TR(withinMaze(x, y));
-    m_tileGraphics[x][y].setText(text);
+    m_tileGraphics[getIndex(x, y)].setText(text);
 }
 
 void MazeGraphic::setWallTruthVisible(bool visible) {
-    for (int x = 0; x < getWidth(); x += 1) {
-        for (int y = 0; y < getHeight(); y += 1) {
-            m_tileGraphics[x][y].setWallTruthVisible(visible);
-        }
+    m_wallTruthVisible = visible;
+    for (TileGraphic& tileGraphic : m_tileGraphics) {
+        tileGraphic.setWallTruthVisible(visible);
     }
 }
 
+bool MazeGraphic::isWallTruthVisible() const {
+    return m_wallTruthVisible;
+}
+
 void MazeGraphic::setTileColorsVisible(bool visible) {
-    for (int x = 0; x < getWidth(); x += 1) {
-        for (int y = 0; y < getHeight(); y += 1) {
-            m_tileGraphics[x][y].setTileColorsVisible(visible);
-        }
+    for (TileGraphic& tileGraphic : m_tileGraphics) {
+        tileGraphic.setTileColorsVisible(visible);
     }
 }
 
 void MazeGraphic::setTileFogVisible(bool visible) {
-    for (int x = 0; x < getWidth(); x += 1) {
-        for (int y = 0; y < getHeight(); y += 1) {
-            m_tileGraphics[x][y].setTileFogVisible(visible);
-        }
+    for (TileGraphic& tileGraphic : m_tileGraphics) {
+        tileGraphic.setTileFogVisible(visible);
     }
 }
 
 void MazeGraphic::setTileTextVisible(bool visible) {
-    for (int x = 0; x < getWidth(); x += 1) {
-        for (int y = 0; y < getHeight(); y += 1) {
-            m_tileGraphics[x][y].setTileTextVisible(visible);
-        }
+    for (TileGraphic& tileGraphic : m_tileGraphics) {
+        tileGraphic.setTileTextVisible(visible);
     }
 }
 
 void MazeGraphic::drawPolygons() const {
-    // Fill the GRAPHIC_CPU_BUFFER
-    for (int x = 0; x < m_tileGraphics.size(); x += 1) {
-        for (int y = 0; y < m_tileGraphics.at(x).size(); y += 1) {
-            m_tileGraphics.at(x).at(y).drawPolygons();
+    // Fill the GRAPHIC_CPU_BUFFER, one layer at a time
+    for (TileGraphicLayer layer : TILE_GRAPHIC_LAYERS()) {
+        for (const TileGraphic& tileGraphic : m_tileGraphics) {
+            tileGraphic.drawPolygons(layer);
         }
     }
 }
 
 void MazeGraphic::drawTextures() {
     // Fill the TEXTURE_CPU_BUFFER
-    for (int x = 0; x < m_tileGraphics.size(); x += 1) {
-        for (int y = 0; y < m_tileGraphics.at(x).size(); y += 1) {
-            m_tileGraphics[x][y].drawTextures();
-        }
+    for (TileGraphic& tileGraphic : m_tileGraphics) {
+        tileGraphic.drawTextures();
     }
 }
 
 int MazeGraphic::getWidth() const {
-    return m_tileGraphics.size();
+    return m_width;
 }
 
 int MazeGraphic::getHeight() const {
-    return (m_tileGraphics.size() > 0 ? m_tileGraphics.at(0).size() : 0);
+    return m_height;
+}
+
+int MazeGraphic::getIndex(int x, int y) const {
+    return m_height * x + y;
 }
 
 bool MazeGraphic::withinMaze(int x, int y) const {
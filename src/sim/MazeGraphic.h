@@ -22,6 +22,18 @@ public:
         bool tileTextVisible,
         bool autopopulateTextWithDistance);
 
+    // Rebinds the tile graphics to another maze of the same dimensions,
+    // e.g., a rotated or mirrored one, without regenerating any geometry
+    void setMaze(const Maze* maze);
+
+    // Clears everything that a mouse algorithm drew, see TileGraphic::reset()
+    void reset();
+
+    // The state of every tile, see TileGraphic::getState(). Setting them only
+    // redraws the tiles that changed.
+    QVector<TileGraphicState> getTileStates() const;
+    void setTileStates(const QVector<TileGraphicState>& states);
+
     void setTileColor(int x, int y, Color color);
     void declareWall(int x, int y, Direction direction, bool isWall);
     void undeclareWall(int x, int y, Direction direction);
@@ -29,6 +41,7 @@ public:
     void setTileText(int x, int y, const QString& text);
 
     void setWallTruthVisible(bool visible);
+    bool isWallTruthVisible() const;
     void setTileColorsVisible(bool visible);
     void setTileFogVisible(bool visible);
     void setTileTextVisible(bool visible);
@@ -40,10 +53,14 @@ public:
 
 private:
 
-    QVector<QVector<TileGraphic>> m_tileGraphics;
+    int m_width;
+    int m_height;
+    QVector<TileGraphic> m_tileGraphics;
+    bool m_wallTruthVisible;
 
     int getWidth() const;
     int getHeight() const;
+    int getIndex(int x, int y) const;
     bool withinMaze(int x, int y) const;
 
 };
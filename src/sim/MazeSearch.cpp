@@ -0,0 +1,301 @@
+#include "MazeSearch.h"
+
+#include <QAtomicInteger>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QSaveFile>
+#include <QTextStream>
+
+#include <algorithm>
+
+#include "Maze.h"
+#include "MazeFileUtilities.h"
+#include "MazeGenerator.h"
+#include "ParallelUtilities.h"
+
+namespace mms {
+
+MazeSearchCriteria::MazeSearchCriteria() :
+    minShortestPath(-1),
+    maxShortestPath(-1),
+    minDiagonalSavings(-1),
+    minOptimalTurns(-1),
+    minDeadEnds(-1),
+    requireOfficial(false),
+    requireUnsolvableByWallFollower(false) {
+}
+
+bool MazeSearchCriteria::matches(const MazeMetrics& metrics) const {
+    if (!metrics.isValid || metrics.shortestPath == -1) {
+        return false;
+    }
+    if (requireOfficial && !metrics.isOfficial) {
+        return false;
+    }
+    if (requireUnsolvableByWallFollower && metrics.solvableByWallFollower) {
+        return false;
+    }
+    if (minShortestPath != -1 && metrics.shortestPath < minShortestPath) {
+        return false;
+    }
+    if (maxShortestPath != -1 && maxShortestPath < metrics.shortestPath) {
+        return false;
+    }
+    if (
+        minDiagonalSavings != -1 &&
+        metrics.shortestPath - metrics.diagonalPath < minDiagonalSavings
+    ) {
+        return false;
+    }
+    if (minOptimalTurns != -1 && metrics.optimalTurns < minOptimalTurns) {
+        return false;
+    }
+    if (minDeadEnds != -1 && metrics.deadEnds < minDeadEnds) {
+        return false;
+    }
+    return true;
+}
+
+QVector<MazeSearchMatch> MazeSearch::search(
+        MazeGeneratorType type,
+        int width,
+        int height,
+        const MazeSearchCriteria& criteria,
+        int count,
+        quint32 firstSeed,
+        qint64 maxCandidates,
+        qint64* numCandidates) {
+
+    QMutex mutex;
+    QVector<QPair<qint64, MazeSearchMatch>> matches;
+    QAtomicInteger<qint64> next(0);
+    QAtomicInt numMatches(0);
+
+    // Each thread generates, validates and scores its own candidates, so that
+    // every stage is always running on every core, and nothing is handed from
+    // thread to thread. Since the seeds are claimed in order, and each thread
+    // finishes its candidate before stopping, the seeds that were tried are
+    // always a prefix of the range, whose first matches are the first overall.
+    ParallelUtilities::forEachCore([&](){
+        MazeGenerator generator(type, width, height);
+        while (numMatches.loadAcquire() < count) {
+            qint64 index = next.fetchAndAddRelaxed(1);
+            if (maxCandidates <= index) {
+                break;
+            }
+            quint32 seed = firstSeed + static_cast<quint32>(index);
+            WallGrid walls = generator.generate(seed);
+
+            // Only score the mazes that pass validation, since it's cheaper
+            Maze* maze = Maze::fromWallGrid(walls);
+            if (
+                !maze->isValidMaze() ||
+                (criteria.requireOfficial && !maze->isOfficialMaze())
+            ) {
+                delete maze;
+                continue;
+            }
+            MazeMetrics metrics = MazeAnalyzer::analyze(*maze);
+            delete maze;
+            if (!criteria.matches(metrics)) {
+                continue;
+            }
+
+            QMutexLocker locker(&mutex);
+            matches.append({index, {seed, walls, metrics}});
+            numMatches.fetchAndAddRelease(1);
+        }
+    });
+
+    std::sort(
+        matches.begin(),
+        matches.end(),
+        [](const QPair<qint64, MazeSearchMatch>& a,
+           const QPair<qint64, MazeSearchMatch>& b) {
+            return a.first < b.first;
+        }
+    );
+    QVector<MazeSearchMatch> results;
+    for (int i = 0; i < matches.size() && i < count; i += 1) {
+        results.append(matches.at(i).second);
+    }
+    if (numCandidates != nullptr) {
+        *numCandidates = std::min(static_cast<qint64>(next.loadAcquire()), maxCandidates);
+    }
+    return results;
+}
+
+int MazeSearch::report(
+        MazeGeneratorType type,
+        int width,
+        int height,
+        const MazeSearchCriteria& criteria,
+        int count,
+        quint32 firstSeed,
+        qint64 maxCandidates,
+        const QString& path) {
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 numCandidates = 0;
+    QVector<MazeSearchMatch> matches = search(
+        type,
+        width,
+        height,
+        criteria,
+        count,
+        firstSeed,
+        maxCandidates,
+        &numCandidates);
+    double seconds = timer.nsecsElapsed() / 1e9;
+
+    // Name the mazes as MazeCorpus does the mazes of a stream of records
+    QString generatorName = MAZE_GENERATOR_TYPE_TO_STRING().value(type);
+    QVector<QPair<QString, MazeMetrics>> results;
+    for (const MazeSearchMatch& match : matches) {
+        results.append({
+            generatorName + "#" + QString::number(match.seed),
+            match.metrics
+        });
+    }
+    QTextStream(stdout) << MazeAnalyzer::toCsv(results);
+
+    if (!path.isEmpty()) {
+        QSaveFile file(path);
+        bool success = file.open(QIODevice::WriteOnly);
+        try {
+            for (int i = 0; success && i < matches.size(); i += 1) {
+                MazeFileUtilities::writeMmswRecord(
+                    matches.at(i).walls,
+                    matches.at(i).seed,
+                    &file);
+            }
+        }
+        catch (const std::exception&) {
+            success = false;
+        }
+        if (!success || !file.commit()) {
+            qWarning().noquote().nospace()
+                << "Unable to write the matching mazes to \"" << path << "\".";
+            return -1;
+        }
+    }
+
+    qInfo().noquote().nospace()
+        << "Found " << matches.size() << " of " << count << " mazes in "
+        << numCandidates << " candidates (" << QString::number(seconds, 'f', 3)
+        << " s).";
+    return matches.size();
+}
+
+void MazeSearch::addOptions(QCommandLineParser* parser) {
+    parser->addOptions({
+        {
+            "search",
+            "Generate mazes until <count> of them match the criteria below, and "
+            "print their metrics.",
+            "count",
+        },
+        {
+            "generator",
+            "Generate the --search mazes with <name>, \"tomasz\" (the default) "
+            "or \"random\".",
+            "name",
+            "tomasz",
+        },
+        {"width", "The width of the --search mazes (default 16).", "tiles", "16"},
+        {"height", "The height of the --search mazes (default 16).", "tiles", "16"},
+        {
+            "max-candidates",
+            "Give up the --search after <count> mazes (default 1000000).",
+            "count",
+            "1000000",
+        },
+        {"min-path", "Match mazes whose shortest path is at least <moves>.", "moves"},
+        {"max-path", "Match mazes whose shortest path is at most <moves>.", "moves"},
+        {
+            "min-diagonal-savings",
+            "Match mazes whose shortest path diagonals shorten by at least <moves>.",
+            "moves",
+        },
+        {"min-turns", "Match mazes whose optimal path has at least <turns>.", "turns"},
+        {"min-dead-ends", "Match mazes with at least <count> dead ends.", "count"},
+        {"official", "Match only mazes that follow the official rules."},
+        {"no-wall-follower", "Match only mazes that a wall follower can't solve."},
+    });
+}
+
+int MazeSearch::runFromArguments(const QCommandLineParser& parser) {
+
+    // Every number must be a non-negative integer, and a criterion that isn't
+    // set is -1, i.e., no bound
+    auto readInt = [&](const QString& name, int* value) {
+        *value = -1;
+        if (parser.value(name).isEmpty()) {
+            return true;
+        }
+        bool ok = false;
+        *value = parser.value(name).toInt(&ok);
+        if (!ok || *value < 0) {
+            qWarning().noquote().nospace()
+                << "Invalid --" << name << " \"" << parser.value(name) << "\".";
+            return false;
+        }
+        return true;
+    };
+    int count = 0;
+    int width = 0;
+    int height = 0;
+    MazeSearchCriteria criteria;
+    if (
+        !readInt("search", &count) ||
+        !readInt("width", &width) ||
+        !readInt("height", &height) ||
+        !readInt("min-path", &criteria.minShortestPath) ||
+        !readInt("max-path", &criteria.maxShortestPath) ||
+        !readInt("min-diagonal-savings", &criteria.minDiagonalSavings) ||
+        !readInt("min-turns", &criteria.minOptimalTurns) ||
+        !readInt("min-dead-ends", &criteria.minDeadEnds)
+    ) {
+        return 1;
+    }
+    criteria.requireOfficial = parser.isSet("official");
+    criteria.requireUnsolvableByWallFollower = parser.isSet("no-wall-follower");
+
+    QString generatorName = parser.value("generator");
+    bool firstSeedOk = false;
+    bool maxCandidatesOk = false;
+    quint32 firstSeed = parser.value("first-seed").toUInt(&firstSeedOk);
+    qint64 maxCandidates = parser.value("max-candidates").toLongLong(&maxCandidatesOk);
+    if (count <= 0 || width <= 0 || height <= 0) {
+        qWarning().noquote().nospace()
+            << "The --search count, --width and --height must be positive.";
+        return 1;
+    }
+    if (!STRING_TO_MAZE_GENERATOR_TYPE().contains(generatorName)) {
+        qWarning().noquote().nospace()
+            << "Invalid --generator \"" << generatorName << "\".";
+        return 1;
+    }
+    if (!firstSeedOk || !maxCandidatesOk || maxCandidates <= 0) {
+        qWarning().noquote().nospace()
+            << "Invalid --first-seed or --max-candidates.";
+        return 1;
+    }
+    int numMatches = report(
+        STRING_TO_MAZE_GENERATOR_TYPE().value(generatorName),
+        width,
+        height,
+        criteria,
+        count,
+        firstSeed,
+        maxCandidates,
+        parser.value("output")
+    );
+    return numMatches < count ? 1 : 0;
+}
+
+} // namespace mms
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QCommandLineParser>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+#include "MazeAnalyzer.h"
+#include "MazeGeneratorType.h"
+#include "WallGrid.h"
+
+namespace mms {
+
+// What a maze must be like to match a search; -1 means no bound
+struct MazeSearchCriteria {
+    MazeSearchCriteria();
+    int minShortestPath;
+    int maxShortestPath;
+    // The fewest moves that diagonals must save on the shortest path
+    int minDiagonalSavings;
+    int minOptimalTurns;
+    int minDeadEnds;
+    bool requireOfficial;
+    bool requireUnsolvableByWallFollower;
+    bool matches(const MazeMetrics& metrics) const;
+};
+
+struct MazeSearchMatch {
+    quint32 seed;
+    WallGrid walls;
+    MazeMetrics metrics;
+};
+
+// Searches for mazes with particular properties by generating them in-process
+// with one seed after another, and scoring each one with MazeAnalyzer
+class MazeSearch {
+
+public:
+
+    MazeSearch() = delete;
+
+    // Tries the seeds from the first seed onward on all cores, until count
+    // mazes match or maxCandidates seeds have been tried, and optionally
+    // returns the number of seeds tried. The matches are in seed order and
+    // don't depend on the number of cores: they're always the mazes of the
+    // first matching seeds.
+    static QVector<MazeSearchMatch> search(
+        MazeGeneratorType type,
+        int width,
+        int height,
+        const MazeSearchCriteria& criteria,
+        int count,
+        quint32 firstSeed,
+        qint64 maxCandidates,
+        qint64* numCandidates = nullptr);
+
+    // Searches, prints the metrics of the matches as CSV to stdout, and, if
+    // the path isn't empty, writes the matches to it as a stream of MMSW
+    // records. Returns the number of matches, or -1 on failure.
+    static int report(
+        MazeGeneratorType type,
+        int width,
+        int height,
+        const MazeSearchCriteria& criteria,
+        int count,
+        quint32 firstSeed,
+        qint64 maxCandidates,
+        const QString& path);
+
+    // The options of --search, and running it with them as parsed, which
+    // returns the exit code
+    static void addOptions(QCommandLineParser* parser);
+    static int runFromArguments(const QCommandLineParser& parser);
+};
+
+} // namespace mms
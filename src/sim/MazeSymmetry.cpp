@@ -0,0 +1,67 @@
+#include "MazeSymmetry.h"
+
+#include "Assert.h"
+#include "WallGridView.h"
+
+namespace mms {
+
+const int MazeSymmetry::NUM_SYMMETRIES;
+
+WallGrid MazeSymmetry::transform(const WallGrid& walls, int symmetry) {
+    return WallGridView(walls, symmetry).toWallGrid();
+}
+
+int MazeSymmetry::fromMirrorAndRotations(bool mirrored, int rotations) {
+    ASSERT_LE(0, rotations);
+    ASSERT_LT(rotations, 4);
+    return (mirrored ? 4 : 0) + rotations;
+}
+
+int MazeSymmetry::compose(int first, int second) {
+    ASSERT_LE(0, first);
+    ASSERT_LT(first, NUM_SYMMETRIES);
+    ASSERT_LE(0, second);
+    ASSERT_LT(second, NUM_SYMMETRIES);
+    // Mirroring after a rotation is the same as mirroring before the inverse
+    // rotation, so a second mirroring reverses the first rotations
+    int firstRotations = first % 4;
+    int secondRotations = second % 4;
+    bool firstMirrored = 4 <= first;
+    bool secondMirrored = 4 <= second;
+    int rotations = (
+        secondRotations + (secondMirrored ? 4 - firstRotations : firstRotations)
+    ) % 4;
+    return fromMirrorAndRotations(firstMirrored != secondMirrored, rotations);
+}
+
+WallGrid MazeSymmetry::canonicalForm(const WallGrid& walls) {
+    WallGrid canonical = walls;
+    for (int i = 1; i < NUM_SYMMETRIES; i += 1) {
+        WallGrid candidate = transform(walls, i);
+        if (lessThan(candidate, canonical)) {
+            canonical = candidate;
+        }
+    }
+    return canonical;
+}
+
+quint64 MazeSymmetry::canonicalHash(const WallGrid& walls) {
+    return canonicalForm(walls).hash();
+}
+
+bool MazeSymmetry::lessThan(const WallGrid& a, const WallGrid& b) {
+    if (a.getWidth() != b.getWidth()) {
+        return a.getWidth() < b.getWidth();
+    }
+    if (a.getHeight() != b.getHeight()) {
+        return a.getHeight() < b.getHeight();
+    }
+    for (int i = 0; i < a.getNumWords(); i += 1) {
+        if (a.getWords()[i] != b.getWords()[i]) {
+            return a.getWords()[i] < b.getWords()[i];
+        }
+    }
+    return false;
+}
+
+} // namespace mms
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include "WallGrid.h"
+
+namespace mms {
+
+// The eight symmetries of a rectangular maze (the dihedral group of the
+// square): an optional mirroring across the vertical axis, followed by zero
+// to three counter-clockwise quarter turns.
+class MazeSymmetry {
+
+public:
+
+    MazeSymmetry() = delete;
+
+    static const int NUM_SYMMETRIES = 8;
+
+    // Symmetry i mirrors if 4 <= i, then rotates i % 4 times
+    static WallGrid transform(const WallGrid& walls, int symmetry);
+
+    // The symmetry that mirrors (optionally) and then rotates the given
+    // number of times counter-clockwise
+    static int fromMirrorAndRotations(bool mirrored, int rotations);
+
+    // The single symmetry equivalent to applying first, then second
+    static int compose(int first, int second);
+
+    // The smallest (by dimensions, then packed words) of the eight images of
+    // the maze, so that all symmetric variants of a maze share a canonical form
+    static WallGrid canonicalForm(const WallGrid& walls);
+
+    // A hash that is invariant under all eight symmetries
+    static quint64 canonicalHash(const WallGrid& walls);
+
+private:
+
+    static bool lessThan(const WallGrid& a, const WallGrid& b);
+};
+
+} // namespace mms
@@ -26,22 +26,43 @@ MazeView::MazeView(
             tileTextVisible,
             autopopulateTextWithDistance) {
 
-    // Establish the coordinates for the tile text characters
+    // Populate the data vectors with wall polygons ...
+    m_mazeGraphic.drawPolygons();
+
+    // ... and, having established the coordinates for the tile text
+    // characters, the tile distance text
     initText(2, 4);
+}
 
-    // Populate the data vectors with wall polygons and tile distance text.
-    m_mazeGraphic.drawPolygons();
-    m_mazeGraphic.drawTextures();
+bool MazeView::setMaze(const Maze* maze) {
+    QPair<int, int> mazeSize = m_bufferInterface.getMazeSize();
+    if (maze->getWidth() != mazeSize.first || maze->getHeight() != mazeSize.second) {
+        return false;
+    }
+    m_mazeGraphic.setMaze(maze);
+    return true;
+}
+
+void MazeView::reset() {
+    m_mazeGraphic.reset();
 }
 
 MazeGraphic* MazeView::getMazeGraphic() {
     return &m_mazeGraphic;
 }
 
+const MazeGraphic* MazeView::getMazeGraphic() const {
+    return &m_mazeGraphic;
+}
+
 void MazeView::initTileGraphicText(int numRows, int numCols) {
     initText(numRows, numCols);
 }
 
+QPair<int, int> MazeView::getTileGraphicTextSize() const {
+    return m_bufferInterface.getTileGraphicTextMaxSize();
+}
+
 const QVector<TriangleGraphic>* MazeView::getGraphicCpuBuffer() const {
     return &m_graphicCpuBuffer;
 }
@@ -50,6 +71,10 @@ const QVector<TriangleTexture>* MazeView::getTextureCpuBuffer() const {
     return &m_textureCpuBuffer;
 }
 
+QPair<int, int> MazeView::getGraphicCpuBufferLayer(TileGraphicLayer layer) const {
+    return m_bufferInterface.getTileGraphicLayerRange(layer);
+}
+
 void MazeView::initText(int numRows, int numCols) {
 
     // Initialze the tile text in the buffer class,
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <QPair>
 #include <QVector>
 
 #include "BufferInterface.h"
 #include "Maze.h"
 #include "MazeGraphic.h"
+#include "TileGraphicLayer.h"
 #include "TriangleGraphic.h"
 #include "TriangleTexture.h"
 
@@ -22,11 +24,26 @@ public:
         bool tileTextVisible, 
         bool autopopulateTextWithDistance);
 
+    // Rebinds the view to another maze, in place, if the maze has the same
+    // dimensions (as any rotation of a square maze does); returns false,
+    // leaving the view unchanged, otherwise
+    bool setMaze(const Maze* maze);
+
+    // Clears everything that a mouse algorithm drew, so that the view can be
+    // reused for another run
+    void reset();
+
     MazeGraphic* getMazeGraphic();
+    const MazeGraphic* getMazeGraphic() const;
     void initTileGraphicText(int numRows, int numCols);
+    QPair<int, int> getTileGraphicTextSize() const;
     const QVector<TriangleGraphic>* getGraphicCpuBuffer() const;
     const QVector<TriangleTexture>* getTextureCpuBuffer() const;
 
+    // Returns the starting triangle index and number of triangles of a
+    // layer of the graphic cpu buffer
+    QPair<int, int> getGraphicCpuBufferLayer(TileGraphicLayer layer) const;
+
 private:
 
     // These vectors contain the triangles that will actually be drawn
@@ -4,6 +4,7 @@
 
 #include "Assert.h"
 #include "GeometryUtilities.h"
+#include "Instrumentation.h"
 #include "Logging.h"
 #include "Param.h"
 #include "SimTime.h"
@@ -15,11 +16,16 @@ namespace mms {
 Model::Model() :
     m_shutdownRequested(false),
     m_maze(nullptr),
-    m_mouse(nullptr),
-    m_stats(nullptr),
+    m_recorder(nullptr),
     m_paused(false),
     m_simSpeed(1.0) {
     ASSERT_RUNS_JUST_ONCE();
+    // The mouse is passed along with each traversed tile, across threads
+    qRegisterMetaType<const Mouse*>("const Mouse*");
+}
+
+Model::~Model() {
+    delete m_recorder;
 }
 
 void Model::start() {
@@ -30,8 +36,15 @@ void Model::start() {
         double now = SimUtilities::getHighResTimestamp();
         acc += (now - prev) * m_simSpeed;
         prev = now;
+        if (acc >= DT) {
+            // How far, in real time, the oldest pending step is overdue
+            Instrumentation::get()->recordTiming(
+                Timing::STEP_LATENESS,
+                (acc - DT) / m_simSpeed * 1000.0);
+        }
         while (acc >= DT) {
             update(DT);
+            Instrumentation::get()->increment(Counter::MODEL_STEPS);
             acc -= DT;
             // TODO: MACK - check for collisions ...
             // std::thread collisionDetector(&Model::checkCollision, this);
@@ -50,7 +63,7 @@ void Model::update(double dt) {
     m_mutex.lock();
 
     // If there's nothing to update, sleep for a little bit
-    if (m_mouse == nullptr || m_paused) {
+    if (m_racers.isEmpty() || m_paused) {
         m_mutex.unlock();
         return;
     }
@@ -58,107 +71,186 @@ void Model::update(double dt) {
     // Calculate the amount of sim time that should pass during this iteration
     Duration elapsedSimTimeForThisIteration = Duration::Seconds(dt);
 
-    // Update the sim time
+    // Update the sim time, which every mouse shares
     SimTime::get()->incrementElapsedSimTime(elapsedSimTimeForThisIteration);
 
+    // Update each of the mice
+    for (int i = 0; i < m_racers.size(); i += 1) {
+        updateRacer(&m_racers[i], elapsedSimTimeForThisIteration);
+    }
+
+    // Sample the trajectory of the first mouse, every so often
+    Duration simTime = SimTime::get()->elapsedSimTime();
+    if (m_recorder != nullptr && m_recorder->isDue(simTime)) {
+        const Mouse* mouse = m_racers.first().mouse;
+        m_recorder->record(
+            simTime,
+            mouse->getCurrentTranslation(),
+            mouse->getCurrentRotation(),
+            mouse->getCurrentDiscretizedTranslation());
+    }
+
+    // Release the mutex
+    m_mutex.unlock();
+}
+
+void Model::updateRacer(Racer* racer, const Duration& elapsedSimTime) {
+
+    Mouse* mouse = racer->mouse;
+    MouseStats* stats = &racer->stats;
+
     // Update the position of the mouse
-    m_mouse->update(elapsedSimTimeForThisIteration);
+    mouse->update(elapsedSimTime);
+    // Update the distance traveled, except across teleports, e.g., when the
+    // algorithm resets the position of the mouse
+    Coordinate translation = mouse->getCurrentTranslation();
+    Distance step = (translation - racer->previousTranslation).getRho();
+    if (step < Distance::Meters(P()->wallLength())) {
+        stats->distanceTraveled += step;
+    }
+    racer->previousTranslation = translation;
 
     // Retrieve the current discretized location of the mouse
-    QPair<int, int> location = m_mouse->getCurrentDiscretizedTranslation();
+    QPair<int, int> location = mouse->getCurrentDiscretizedTranslation();
 
     // If we're ever outside of the maze, crash. It would be cool to have
-    // some "out of bounds" state but I haven't implemented that yet. We
-    // continue here to make sure that we join with the other thread.
+    // some "out of bounds" state but I haven't implemented that yet.
     if (!m_maze->withinMaze(location.first, location.second)) {
-        m_mouse->setCrashed();
-        m_mutex.unlock();
+        mouse->setCrashed();
         return;
     }
 
-    // Retrieve the tile at current location
-    const Tile* tileAtLocation = m_maze->getTile(location.first, location.second);
+    // Retrieve the distance of the current location from the center
+    int distance = m_maze->getDistance(location.first, location.second);
 
     // If this is a new tile, update the set of traversed tiles
-    if (!m_stats->traversedTileLocations.contains(location)) {
-        m_stats->traversedTileLocations.insert(location);
-        if (m_stats->closestDistanceToCenter == -1 ||
-                tileAtLocation->getDistance() < m_stats->closestDistanceToCenter) {
-            m_stats->closestDistanceToCenter = tileAtLocation->getDistance(); 
+    if (!stats->traversedTileLocations.contains(location)) {
+        stats->traversedTileLocations.insert(location);
+        if (stats->closestDistanceToCenter == -1 ||
+                distance < stats->closestDistanceToCenter) {
+            stats->closestDistanceToCenter = distance;
         }
         // Alert any listeners that a new tile was entered
-        emit newTileLocationTraversed(location.first, location.second);
+        emit newTileLocationTraversed(mouse, location.first, location.second);
     }
 
     // If we've returned to the origin, reset the departure time
     if (location.first == 0 && location.second == 0) {
-        m_stats->timeOfOriginDeparture = Duration::Seconds(-1);
+        stats->timeOfOriginDeparture = Duration::Seconds(-1);
     }
 
     // Otherwise, if we've just left the origin, update the departure time
-    else if (m_stats->timeOfOriginDeparture < Duration::Seconds(0)) {
-        m_stats->timeOfOriginDeparture = SimTime::get()->elapsedSimTime();
+    else if (stats->timeOfOriginDeparture < Duration::Seconds(0)) {
+        stats->timeOfOriginDeparture = SimTime::get()->elapsedSimTime();
     }
 
     // Separately, if we're in the center, update the best time to center
     if (m_maze->isCenterTile(location.first, location.second)) {
-        Duration timeToCenter = SimTime::get()->elapsedSimTime() - m_stats->timeOfOriginDeparture;
+        if (stats->timeOfFirstCenterArrival < Duration::Seconds(0)) {
+            stats->timeOfFirstCenterArrival = SimTime::get()->elapsedSimTime();
+        }
+        Duration timeToCenter = SimTime::get()->elapsedSimTime() - stats->timeOfOriginDeparture;
         if (
-            m_stats->bestTimeToCenter < Duration::Seconds(0) ||
-            timeToCenter < m_stats->bestTimeToCenter
+            stats->bestTimeToCenter < Duration::Seconds(0) ||
+            timeToCenter < stats->bestTimeToCenter
         ) {
-            m_stats->bestTimeToCenter = timeToCenter;
+            stats->bestTimeToCenter = timeToCenter;
         }
     }
-
-    // Release the mutex
-    m_mutex.unlock();
 }
 
 void Model::setMaze(const Maze* maze) {
     m_mutex.lock();
-    delete m_stats;
-    m_stats = nullptr;
-    m_mouse = nullptr;
+    m_racers.clear();
     m_maze = maze;
+    if (m_recorder != nullptr) {
+        m_recorder->start("");
+    }
     m_mutex.unlock();
 }
 
 void Model::setMouse(Mouse* mouse) {
+    setMice({mouse});
+}
+
+void Model::removeMouse() {
+    m_mutex.lock();
+    m_racers.clear();
+    m_mutex.unlock();
+}
+
+void Model::setMice(const QVector<Mouse*>& mice) {
     m_mutex.lock();
     ASSERT_FA(m_maze == nullptr);
-    ASSERT_TR(m_mouse == nullptr);
-    ASSERT_TR(m_stats == nullptr);
-    m_mouse = mouse;
-    m_stats = new MouseStats();
+    ASSERT_TR(m_racers.isEmpty());
+    for (Mouse* mouse : mice) {
+        m_racers.append({mouse, MouseStats(), mouse->getCurrentTranslation()});
+    }
+    if (m_recorder != nullptr && !mice.isEmpty()) {
+        m_recorder->start(mice.first()->getMouseFile());
+    }
     SimTime::get()->reset();
     m_mutex.unlock();
 }
 
-void Model::removeMouse() {
-    if (m_mouse == nullptr) {
-        return;
-    }
+void Model::removeMouse(const Mouse* mouse) {
     m_mutex.lock();
-    ASSERT_FA(m_maze == nullptr);
-    ASSERT_FA(m_mouse == nullptr);
-    ASSERT_FA(m_stats == nullptr);
-    delete m_stats;
-    m_stats = nullptr;
-    m_mouse = nullptr;
+    for (int i = 0; i < m_racers.size(); i += 1) {
+        if (m_racers.at(i).mouse == mouse) {
+            m_racers.remove(i);
+            break;
+        }
+    }
     m_mutex.unlock();
 }
 
 MouseStats Model::getMouseStats() const {
     m_mutex.lock();
     MouseStats stats;
-    if (m_stats != nullptr) {
-        stats = *m_stats; 
+    if (!m_racers.isEmpty()) {
+        stats = m_racers.first().stats;
     }
     m_mutex.unlock();
     return stats;
 }
 
+MouseStats Model::getMouseStats(const Mouse* mouse) const {
+    m_mutex.lock();
+    MouseStats stats;
+    for (const Racer& racer : m_racers) {
+        if (racer.mouse == mouse) {
+            stats = racer.stats;
+        }
+    }
+    m_mutex.unlock();
+    return stats;
+}
+
+void Model::setTrajectoryRecording(bool enabled) {
+    m_mutex.lock();
+    if (enabled && m_recorder == nullptr) {
+        m_recorder = new TrajectoryRecorder(
+            TRAJECTORY_CAPACITY,
+            TRAJECTORY_INTERVAL_MILLISECONDS);
+    }
+    else if (!enabled) {
+        delete m_recorder;
+        m_recorder = nullptr;
+    }
+    m_mutex.unlock();
+}
+
+Trajectory Model::getTrajectory() const {
+    m_mutex.lock();
+    Trajectory trajectory;
+    trajectory.mazeHash = 0;
+    if (m_recorder != nullptr) {
+        trajectory = m_recorder->getTrajectory();
+    }
+    m_mutex.unlock();
+    return trajectory;
+}
+
 void Model::setPaused(bool paused) {
     m_paused = paused;
 }
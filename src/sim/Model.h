@@ -2,10 +2,14 @@
 
 #include <QObject>
 #include <QMutex>
+#include <QVector>
 
 #include "Maze.h"
 #include "Mouse.h"
 #include "MouseStats.h"
+#include "TrajectoryRecorder.h"
+#include "units/Coordinate.h"
+#include "units/Duration.h"
 
 namespace mms {
 
@@ -16,6 +20,7 @@ class Model : public QObject {
 public:
 
     Model();
+    ~Model();
     void start();
     void shutdown();
 
@@ -23,14 +28,27 @@ public:
     void setMouse(Mouse* mouse);
     void removeMouse();
 
+    // Puts several mice in the maze at once, e.g., to race two algorithms
+    // against each other. Every mouse is stepped under the same sim clock,
+    // which is reset, and has its own stats.
+    void setMice(const QVector<Mouse*>& mice);
+    void removeMouse(const Mouse* mouse);
+
+    // The stats of the first mouse, or of the given one
     MouseStats getMouseStats() const;
+    MouseStats getMouseStats(const Mouse* mouse) const;
+
+    // Records the trajectory of the first mouse of each run, which is kept
+    // until the next run starts or the maze changes
+    void setTrajectoryRecording(bool enabled);
+    Trajectory getTrajectory() const;
 
     void setPaused(bool paused);
     void setSimSpeed(double factor);
 
 signals:
 
-    void newTileLocationTraversed(int x, int y);
+    void newTileLocationTraversed(const Mouse* mouse, int x, int y);
 
 private:
 
@@ -41,9 +59,22 @@ private:
     mutable QMutex m_mutex;
     bool m_shutdownRequested;
 
+    // A mouse in the maze, its stats, and where it was as of the previous
+    // step, for its distance traveled
+    struct Racer {
+        Mouse* mouse;
+        MouseStats stats;
+        Coordinate previousTranslation;
+    };
+
     const Maze* m_maze;
-    Mouse* m_mouse;
-    MouseStats* m_stats;
+    QVector<Racer> m_racers;
+    void updateRacer(Racer* racer, const Duration& elapsedSimTime);
+
+    // A sample every 10 ms of sim time, with room for about 87 minutes
+    static const int TRAJECTORY_CAPACITY = 1 << 19;
+    static const int TRAJECTORY_INTERVAL_MILLISECONDS = 10;
+    TrajectoryRecorder* m_recorder;
 
     bool m_paused;
     double m_simSpeed;
@@ -123,6 +123,33 @@ void Mouse::teleport(const Coordinate& translation, const Angle& rotation) {
     m_currentRotation = rotation;
 }
 
+MouseState Mouse::getState() const {
+    m_mutex.lock();
+    MouseState state;
+    state.translation = m_currentTranslation;
+    state.rotation = m_currentRotation;
+    state.gyro = m_currentGyro;
+    state.crashed = m_crashed;
+    for (auto it = m_wheels.constBegin(); it != m_wheels.constEnd(); it += 1) {
+        state.wheels.insert(it.key(), it.value().getState());
+    }
+    m_mutex.unlock();
+    return state;
+}
+
+void Mouse::setState(const MouseState& state) {
+    m_mutex.lock();
+    m_currentTranslation = state.translation;
+    m_currentRotation = state.rotation;
+    m_currentGyro = state.gyro;
+    m_crashed = state.crashed;
+    for (auto it = state.wheels.constBegin(); it != state.wheels.constEnd(); it += 1) {
+        ASSERT_TR(m_wheels.contains(it.key()));
+        m_wheels[it.key()].setState(it.value());
+    }
+    m_mutex.unlock();
+}
+
 Direction Mouse::getStartedDirection() const {
     return m_startedDirection;
 }
@@ -322,6 +349,33 @@ void Mouse::setWheelSpeeds(const QMap<QString, AngularVelocity>& wheelSpeeds) {
     m_mutex.unlock();
 }
 
+Speed Mouse::getMaxForwardSpeed() const {
+    // Since each wheel's effect is linear in its speed, the effect of moving
+    // forward at full speed is each wheel's maximum effect, scaled by its
+    // adjustment factor, averaged just as in update()
+    Speed sum;
+    m_mutex.lock();
+    QMap<QString, Wheel>::const_iterator it;
+    for (it = m_wheels.constBegin(); it != m_wheels.constEnd(); it += 1) {
+        sum += it.value().getMaximumEffect().forwardEffect *
+            m_wheelSpeedAdjustmentFactors.value(it.key()).first;
+    }
+    m_mutex.unlock();
+    return m_wheels.isEmpty() ? Speed() : sum / m_wheels.size();
+}
+
+AngularVelocity Mouse::getMaxTurnRate() const {
+    AngularVelocity sum;
+    m_mutex.lock();
+    QMap<QString, Wheel>::const_iterator it;
+    for (it = m_wheels.constBegin(); it != m_wheels.constEnd(); it += 1) {
+        sum += it.value().getMaximumEffect().turnEffect *
+            m_wheelSpeedAdjustmentFactors.value(it.key()).second;
+    }
+    m_mutex.unlock();
+    return m_wheels.isEmpty() ? AngularVelocity() : sum / m_wheels.size();
+}
+
 void Mouse::setWheelSpeedsForMoveForward(double fractionOfMaxSpeed) {
     setWheelSpeedsForMovement(fractionOfMaxSpeed, 1.0, 0.0);
 }
@@ -8,11 +8,13 @@
 
 #include "units/AngularVelocity.h"
 #include "units/Coordinate.h"
+#include "units/Speed.h"
 
 #include "CurveTurnFactorCalculator.h"
 #include "Direction.h"
 #include "EncoderType.h"
 #include "Maze.h"
+#include "MouseState.h"
 #include "Polygon.h"
 #include "Sensor.h"
 #include "Wheel.h"
@@ -43,6 +45,12 @@ public:
     // Sets the current translation and rotation of the mouse
     void teleport(const Coordinate& translation, const Angle& rotation);
 
+    // Gets/sets everything about the mouse that changes as it moves, e.g., to
+    // show it as it was at a checkpoint. The wheels of the state must be
+    // those of the mouse file.
+    MouseState getState() const;
+    void setState(const MouseState& state);
+
     // Returns the direction of the mouse at the most recent reset
     Direction getStartedDirection() const;
 
@@ -102,6 +110,11 @@ public:
     // intentionally not const to avoid making copies of Wheel objects.
     const AngularVelocity& getWheelMaxSpeed(const QString& name);
 
+    // The speed of the mouse when moving forward, and the rate at which it
+    // turns in place, with the wheels set for each movement at full speed
+    Speed getMaxForwardSpeed() const;
+    AngularVelocity getMaxTurnRate() const;
+
     // An atomic interface for setting the wheel speeds
     void setWheelSpeeds(const QMap<QString, AngularVelocity>& wheelSpeeds);
 
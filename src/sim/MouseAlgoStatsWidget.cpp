@@ -1,7 +1,6 @@
 #include "MouseAlgoStatsWidget.h"
 
 #include <QGridLayout>
-#include <QLabel>
 
 namespace mms {
 
@@ -17,6 +16,14 @@ void MouseAlgoStatsWidget::init(QStringList keys) {
         valueHolder->setMinimumWidth(80);
         layout->addWidget(labelHolder, i, 0);
         layout->addWidget(valueHolder, i, 1);
+        m_values.insert(label, valueHolder);
+    }
+}
+
+void MouseAlgoStatsWidget::setValue(const QString& key, const QString& value) {
+    QLabel* valueHolder = m_values.value(key, nullptr);
+    if (valueHolder != nullptr) {
+        valueHolder->setText(value);
     }
 }
 
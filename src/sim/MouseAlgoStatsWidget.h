@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QLabel>
+#include <QMap>
 #include <QStringList>
 #include <QWidget>
 
@@ -12,6 +14,11 @@ class MouseAlgoStatsWidget : public QWidget {
 public:
 
     void init(QStringList keys);
+    void setValue(const QString& key, const QString& value);
+
+private:
+
+    QMap<QString, QLabel*> m_values;
 
 };
 
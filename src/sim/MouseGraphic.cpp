@@ -6,8 +6,9 @@
 
 namespace mms {
 
-MouseGraphic::MouseGraphic(const Mouse* mouse) :
-    m_mouse(mouse) {
+MouseGraphic::MouseGraphic(const Mouse* mouse, double alpha) :
+    m_mouse(mouse),
+    m_alpha(alpha) {
 }
 
 Coordinate MouseGraphic::getInitialMouseTranslation() const {
@@ -30,19 +31,19 @@ QVector<TriangleGraphic> MouseGraphic::draw(
     // First, we draw the body
     buffer.append(SimUtilities::polygonToTriangleGraphics(
         m_mouse->getCurrentBodyPolygon(currentTranslation, currentRotation),
-        ColorManager::get()->getMouseBodyColor(), 1.0));
+        ColorManager::get()->getMouseBodyColor(), m_alpha));
 
     // Next, draw the center of mass
     buffer.append(SimUtilities::polygonToTriangleGraphics(
         m_mouse->getCurrentCenterOfMassPolygon(currentTranslation, currentRotation),
-        ColorManager::get()->getMouseCenterOfMassColor(), 1.0));
+        ColorManager::get()->getMouseCenterOfMassColor(), m_alpha));
 
     // Next, we draw the wheels
     for (const Polygon& wheelPolygon :
             m_mouse->getCurrentWheelPolygons(currentTranslation, currentRotation)) {
         buffer.append(SimUtilities::polygonToTriangleGraphics(
             wheelPolygon,
-            ColorManager::get()->getMouseWheelColor(), 1.0));
+            ColorManager::get()->getMouseWheelColor(), m_alpha));
     }
 
     // Next, we draw the sensors
@@ -50,7 +51,7 @@ QVector<TriangleGraphic> MouseGraphic::draw(
             m_mouse->getCurrentSensorPolygons(currentTranslation, currentRotation)) {
         buffer.append(SimUtilities::polygonToTriangleGraphics(
             sensorPolygon,
-            ColorManager::get()->getMouseSensorColor(), 1.0));
+            ColorManager::get()->getMouseSensorColor(), m_alpha));
     }
 
     // Lastly, we draw the sensor views
@@ -58,7 +59,7 @@ QVector<TriangleGraphic> MouseGraphic::draw(
             m_mouse->getCurrentSensorViewPolygons(currentTranslation, currentRotation)) {
         buffer.append(SimUtilities::polygonToTriangleGraphics(
             polygon,
-            ColorManager::get()->getMouseVisionColor(), 1.0));
+            ColorManager::get()->getMouseVisionColor(), m_alpha));
     }
 
     // Uncomment to draw collision polygon
@@ -14,7 +14,9 @@ class MouseGraphic {
 
 public:
 
-    MouseGraphic(const Mouse* mouse);
+    // An alpha below 1.0 draws the mouse translucent, e.g., to tell a rival
+    // mouse apart from the one being followed
+    MouseGraphic(const Mouse* mouse, double alpha = 1.0);
 
     Coordinate getInitialMouseTranslation() const;
     QPair<Coordinate, Angle> getCurrentMousePosition() const;
@@ -26,6 +28,7 @@ public:
 private:
 
     const Mouse* m_mouse;
+    double m_alpha;
 
 };
 
@@ -13,6 +13,7 @@
 #include "Color.h"
 #include "ColorManager.h"
 #include "FontImage.h"
+#include "Instrumentation.h"
 #include "Logging.h"
 #include "Param.h"
 #include "SimTime.h"
@@ -60,6 +61,8 @@ void MouseInterface::emitMouseAlgoCannotStart(QString errorString) {
 
 QString MouseInterface::dispatch(const QString& command) {
 
+    Instrumentation::get()->increment(Counter::COMMANDS);
+
     // TODO: upforgrabs
     // These functions should have sanity checks, e.g., correct
     // types, not finalizing static options more than once, etc.
@@ -70,6 +73,7 @@ QString MouseInterface::dispatch(const QString& command) {
 
     QStringList tokens = command.split(" ", QString::SkipEmptyParts);
     QString function = tokens.at(0);
+    m_commandCounts[function] += 1;
 
     // TODO: MACK - maybe just call these "update"?
     if (function == "useContinuousInterface") {
@@ -87,18 +91,16 @@ QString MouseInterface::dispatch(const QString& command) {
         return ACK_STRING;
     }
     else if (function == "setTileTextRowsAndCols") {
-        // TODO: MACK - validation
-        // if (tileTextNumberOfRows < 0 || tileTextNumberOfCols < 0) {
-        //     qCritical().noquote().nospace()
-        //         << "Both tileTextNumberOfRows() and tileTextNumberOfCols() must"
-        //         << " return non-negative integers. Since they return \""
-        //         << tileTextNumberOfRows << "\" and \"" << tileTextNumberOfCols
-        //         << "\", respectively, the tile text dimensions of the mouse"
-        //         << " algorithm \"" << mouseAlgorithm << "\" are invalid.";
-        //     SimUtilities::quit();
-        // }
         int rows = SimUtilities::strToInt(tokens.at(1));
         int cols = SimUtilities::strToInt(tokens.at(2));
+        if (rows < 0 || cols < 0) {
+            qWarning().noquote().nospace()
+                << "The numbers of rows and columns of tile text must be"
+                << " non-negative, but they were given as " << rows << " and "
+                << cols << ", respectively. The tile text dimensions are"
+                << " unchanged.";
+            return ACK_STRING;
+        }
         m_view->initTileGraphicText(rows, cols);
         return ACK_STRING;
     }
@@ -154,6 +156,11 @@ QString MouseInterface::dispatch(const QString& command) {
     else if (function == "initialDirection") {
         return QString(QChar(getStartedDirection()));
     }
+    else if (function == "waitForRun") {
+        // The response is deferred until the next run begins
+        emit waitingForRun();
+        return NO_ACK_STRING;
+    }
     else if (function == "getRandomFloat") {
         return QString::number(getRandom());
     }
@@ -402,6 +409,26 @@ void MouseInterface::requestStop() {
     m_stopRequested = true;
 }
 
+QString MouseInterface::beginRun(
+        const Maze* maze,
+        Mouse* mouse,
+        MazeView* view,
+        quint32 seed) {
+    m_maze = maze;
+    m_mouse = mouse;
+    m_view = view;
+    m_stopRequested = false;
+    m_inputButtonsPressed.clear();
+    m_inOrigin = true;
+    m_tilesWithColor.clear();
+    m_tilesWithText.clear();
+    m_commandCounts.clear();
+    return QString("%1 %2 %3")
+        .arg(maze->getWidth())
+        .arg(maze->getHeight())
+        .arg(seed);
+}
+
 void MouseInterface::inputButtonWasPressed(int button) {
     m_inputButtonsPressed[button] = true;
 }
@@ -419,6 +446,18 @@ DynamicMouseAlgorithmOptions MouseInterface::getDynamicOptions() const {
     return m_dynamicOptions;
 }   
 
+QMap<QString, int> MouseInterface::getCommandCounts() const {
+    return m_commandCounts;
+}
+
+const Mouse* MouseInterface::getMouse() const {
+    return m_mouse;
+}
+
+const MazeView* MouseInterface::getView() const {
+    return m_view;
+}
+
 char MouseInterface::getStartedDirection() {
     return DIRECTION_TO_CHAR().value(m_mouse->getStartedDirection()).toLatin1();
 }
@@ -608,7 +647,7 @@ void MouseInterface::declareTileDistance(int x, int y, int distance) {
         setTileTextImpl(x, y, (0 <= distance ? QString::number(distance) : "inf"));
     }
     if (getDynamicOptions().setTileBaseColorWhenDistanceDeclaredCorrectly) {
-        int actualDistance = m_maze->getTile(x, y)->getDistance();
+        int actualDistance = m_maze->getDistance(x, y);
         // A negative distance is interpreted to mean infinity
         if (distance == actualDistance || (distance < 0 && actualDistance < 0)) {
             setTileColorImpl(x, y,
@@ -1110,7 +1149,7 @@ void MouseInterface::setTileTextImpl(int x, int y, const QString& text) {
     QString filtered;
     for (int i = 0; i < text.size(); i += 1) {
         QChar c = text.at(i);
-        if (!FontImage::get()->positions().contains(c)) {
+        if (!FontImage::get()->contains(c)) {
             qWarning().noquote().nospace()
                 << "Unable to set the tile text for unprintable character \""
                 << (c == '\n' ? "\\n" :
@@ -1304,7 +1343,7 @@ bool MouseInterface::isWall(QPair<QPair<int, int>, Direction> wall, bool declare
 
     ASSERT_TR(m_maze->withinMaze(x, y));
 
-    bool wallExists = m_maze->getTile(x, y)->isWall(direction);
+    bool wallExists = m_maze->isWall(x, y, direction);
 
     if (declareWallOnRead) {
         declareWallImpl(wall, wallExists, declareBothWallHalves);
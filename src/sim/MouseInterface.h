@@ -46,6 +46,13 @@ public:
     // Request that the mouse algorithm exit
     void requestStop();
 
+    // Starts another run of a persistent algorithm, i.e., one that sent
+    // waitForRun when it was done with its previous run. The options that the
+    // algorithm set are kept, but the state of the previous run is not.
+    // Returns the response to waitForRun, which the caller should write to
+    // the algorithm once the mouse has been added to the model.
+    QString beginRun(const Maze* maze, Mouse* mouse, MazeView* view, quint32 seed);
+
     // A user pressed an input button in the UI
     void inputButtonWasPressed(int button);
 
@@ -53,6 +60,14 @@ public:
     InterfaceType getInterfaceType(bool canFinalize) const;
     DynamicMouseAlgorithmOptions getDynamicOptions() const;
 
+    // The number of times each command was dispatched
+    QMap<QString, int> getCommandCounts() const;
+
+    // The mouse and view of the current run, see beginRun(). The view is only
+    // ever drawn on from the thread of this interface.
+    const Mouse* getMouse() const;
+    const MazeView* getView() const;
+
 signals:
 
     // Emit sanitized algorithm output
@@ -67,6 +82,10 @@ signals:
     // The algorithm could not be started
     void mouseAlgoCannotStart(QString errorString);
 
+    // A persistent algorithm is done with its run, and is waiting for the
+    // response to waitForRun, see beginRun()
+    void waitingForRun();
+
 private:
 
     // *********************** START PUBLIC INTERFACE ******************** //
@@ -198,6 +217,9 @@ private:
     // Whether or a stop was requested
     bool m_stopRequested;
 
+    // The number of times each command was dispatched, by name
+    QMap<QString, int> m_commandCounts;
+
     // Whether or not the input buttons are pressed/acknowleged
     QMap<int, bool> m_inputButtonsPressed;
 
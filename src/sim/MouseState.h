@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QMap>
+#include <QString>
+
+#include "units/Angle.h"
+#include "units/AngularVelocity.h"
+#include "units/Coordinate.h"
+
+namespace mms {
+
+// The parts of a wheel that change as the mouse moves
+struct WheelState {
+    AngularVelocity speed;
+    Angle absoluteRotation;
+    Angle relativeRotation;
+};
+
+// The parts of a mouse that change as it moves, as opposed to those that are
+// fixed by its mouse file, e.g., for checkpointing a run
+struct MouseState {
+    Coordinate translation;
+    Angle rotation;
+    AngularVelocity gyro;
+    bool crashed;
+    QMap<QString, WheelState> wheels;
+};
+
+} // namespace mms
@@ -3,6 +3,7 @@
 #include <QPair>
 #include <QSet>
 
+#include "units/Distance.h"
 #include "units/Duration.h"
 
 namespace mms {
@@ -10,6 +11,9 @@ namespace mms {
 struct MouseStats {
     Duration bestTimeToCenter = Duration::Seconds(-1);
     Duration timeOfOriginDeparture = Duration::Seconds(-1);
+    // The sim time at which the mouse first reached the center
+    Duration timeOfFirstCenterArrival = Duration::Seconds(-1);
+    Distance distanceTraveled = Distance::Meters(0);
     QSet<QPair<int, int>> traversedTileLocations;
     int closestDistanceToCenter = -1;
 };
@@ -0,0 +1,82 @@
+#include "ParallelUtilities.h"
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <exception>
+
+namespace mms {
+
+void ParallelUtilities::forEachIndex(
+        int count,
+        const std::function<void(int)>& function) {
+
+    // The first exception thrown by any call, which is kept for the calling
+    // thread, since one that escaped QRunnable::run() would terminate
+    struct Failure {
+        QMutex mutex;
+        std::exception_ptr exception;
+    };
+
+    // Each worker claims the next unclaimed index until there are none left
+    class Worker : public QRunnable {
+    public:
+        Worker(
+                int count,
+                const std::function<void(int)>* function,
+                QAtomicInt* next,
+                Failure* failure) :
+            m_count(count),
+            m_function(function),
+            m_next(next),
+            m_failure(failure) {
+        }
+        void run() override {
+            try {
+                for (int i = m_next->fetchAndAddRelaxed(1); i < m_count; i = m_next->fetchAndAddRelaxed(1)) {
+                    (*m_function)(i);
+                }
+            }
+            catch (...) {
+                // Leave no indices for the other workers to claim
+                m_next->storeRelease(m_count);
+                m_failure->mutex.lock();
+                if (!m_failure->exception) {
+                    m_failure->exception = std::current_exception();
+                }
+                m_failure->mutex.unlock();
+            }
+        }
+    private:
+        int m_count;
+        const std::function<void(int)>* m_function;
+        QAtomicInt* m_next;
+        Failure* m_failure;
+    };
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(QThreadPool::globalInstance()->maxThreadCount());
+    QAtomicInt next(0);
+    Failure failure;
+    int numWorkers = std::min(count, pool.maxThreadCount());
+    for (int i = 0; i < numWorkers; i += 1) {
+        // The pool deletes each worker once it has run
+        pool.start(new Worker(count, &function, &next, &failure));
+    }
+    pool.waitForDone();
+    if (failure.exception) {
+        std::rethrow_exception(failure.exception);
+    }
+}
+
+void ParallelUtilities::forEachCore(const std::function<void()>& function) {
+    int numCores = QThreadPool::globalInstance()->maxThreadCount();
+    forEachIndex(numCores, [&](int) {
+        function();
+    });
+}
+
+} // namespace mms
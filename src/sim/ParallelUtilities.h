@@ -0,0 +1,28 @@
+#pragma once
+
+#include <functional>
+
+namespace mms {
+
+class ParallelUtilities {
+
+public:
+
+    ParallelUtilities() = delete;
+
+    // Calls function(i) for each i in [0, count), spread across a thread pool
+    // with one thread per core, and returns once every call has returned.
+    // Indices are handed out one at a time, so uneven amounts of work per
+    // index are balanced automatically. If a call throws, no more indices are
+    // handed out, and the first exception is rethrown on the calling thread
+    // once the calls in progress have returned.
+    static void forEachIndex(int count, const std::function<void(int)>& function);
+
+    // Calls function() once on each thread of a pool with one thread per
+    // core, and returns once every call has returned. This suits work that
+    // keeps per-thread state and decides for itself when it's done. Exceptions
+    // are rethrown as for forEachIndex().
+    static void forEachCore(const std::function<void()>& function);
+};
+
+} // namespace mms
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QVector>
+
+#include <atomic>
+
+namespace mms {
+
+// A fixed-capacity ring of samples with a single writer and any number of
+// readers. Writes never block or allocate; readers may observe a sample being
+// overwritten, which is acceptable for statistics.
+template <typename T, int CAPACITY>
+class RingBuffer {
+
+public:
+
+    RingBuffer() : m_next(0) {
+        for (int i = 0; i < CAPACITY; i += 1) {
+            m_samples[i].store(T(), std::memory_order_relaxed);
+        }
+    }
+
+    void push(T sample) {
+        unsigned long long index = m_next.load(std::memory_order_relaxed);
+        m_samples[index % CAPACITY].store(sample, std::memory_order_relaxed);
+        m_next.store(index + 1, std::memory_order_release);
+    }
+
+    // The total number of samples ever pushed
+    unsigned long long count() const {
+        return m_next.load(std::memory_order_acquire);
+    }
+
+    // Returns the most recent samples, oldest first
+    QVector<T> snapshot() const {
+        unsigned long long next = count();
+        unsigned long long size = next < CAPACITY ? next : CAPACITY;
+        QVector<T> samples;
+        samples.reserve(static_cast<int>(size));
+        for (unsigned long long i = next - size; i < next; i += 1) {
+            samples.append(m_samples[i % CAPACITY].load(std::memory_order_relaxed));
+        }
+        return samples;
+    }
+
+private:
+
+    std::atomic<T> m_samples[CAPACITY];
+    std::atomic<unsigned long long> m_next;
+
+};
+
+} // namespace mms
@@ -0,0 +1,349 @@
+#include "RunComparison.h"
+
+#include <QDebug>
+#include <QHash>
+#include <QMap>
+#include <QSaveFile>
+#include <QSet>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ParallelUtilities.h"
+
+namespace mms {
+
+const double RunComparison::T_CRITICAL_VALUES[30] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+};
+
+int RunComparison::report(
+        const QString& storePath,
+        const QString& baseline,
+        const QString& candidate,
+        const QString& path) {
+
+    if (baseline.isEmpty() != candidate.isEmpty()) {
+        qWarning().noquote().nospace()
+            << "Both a baseline and a candidate build are needed, or neither.";
+        return -1;
+    }
+    QVector<RunRecord> records;
+    if (!RunStore::read(storePath, &records)) {
+        return -1;
+    }
+    QVector<RevisionPair> revisions = getRevisionPairs(records, baseline, candidate);
+    if (revisions.isEmpty()) {
+        qWarning().noquote().nospace()
+            << "No algorithm in the run store \"" << storePath
+            << "\" has two builds to compare.";
+        return -1;
+    }
+
+    QVector<MetricComparison> comparisons = compare(records, revisions);
+    QByteArray output = toCsv(comparisons).toUtf8();
+    if (path.isEmpty()) {
+        QTextStream(stdout) << output;
+    }
+    else {
+        QSaveFile file(path);
+        if (
+            !file.open(QIODevice::WriteOnly) ||
+            file.write(output) != output.size() ||
+            !file.commit()
+        ) {
+            qWarning().noquote().nospace()
+                << "Unable to write the comparison to \"" << path << "\".";
+            return -1;
+        }
+    }
+
+    int numRegressions = 0;
+    for (const MetricComparison& comparison : comparisons) {
+        if (comparison.isRegression) {
+            numRegressions += 1;
+            qInfo().noquote().nospace()
+                << "Regression: " << comparison.algoName << " "
+                << comparison.metric << " went from "
+                << comparison.baselineMean << " to " << comparison.candidateMean
+                << " over " << comparison.numPairs << " runs.";
+        }
+    }
+    qInfo().noquote().nospace()
+        << "Found " << numRegressions << " regressions in "
+        << comparisons.size() << " comparisons.";
+    return numRegressions;
+}
+
+void RunComparison::addOptions(QCommandLineParser* parser) {
+    parser->addOptions({
+        {
+            "compare",
+            "Compare the two most recent builds of each algorithm in the run store "
+            "<file>, write the table to --output, or stdout, and exit with 2 if any "
+            "metric got significantly worse.",
+            "file",
+        },
+        {"baseline", "The build to --compare against, by its hash.", "hash"},
+        {"candidate", "The build to --compare, by its hash.", "hash"},
+    });
+}
+
+int RunComparison::runFromArguments(const QCommandLineParser& parser) {
+    int numRegressions = report(
+        parser.value("compare"),
+        parser.value("baseline"),
+        parser.value("candidate"),
+        parser.value("output")
+    );
+    if (numRegressions < 0) {
+        return 1;
+    }
+    return numRegressions == 0 ? 0 : 2;
+}
+
+QVector<MetricComparison> RunComparison::compare(
+        const QVector<RunRecord>& records,
+        const QVector<RevisionPair>& revisions) {
+
+    // The runs of each algorithm, so that each pair of revisions only has to
+    // look at its own algorithm's runs. Runs that didn't complete are kept,
+    // since a build that starts failing is the worst kind of regression.
+    QHash<QString, QVector<int>> indicesByAlgo;
+    for (int i = 0; i < records.size(); i += 1) {
+        indicesByAlgo[records.at(i).algoName].append(i);
+    }
+
+    // For each pair of revisions, the values of each metric for each key that
+    // both revisions ran, averaged over repeated runs of the same key. Each
+    // index is only ever written by the thread that claimed it.
+    using Samples = QMap<QString, QVector<QPair<double, double>>>;
+    QVector<Samples> samplesByPair(revisions.size());
+    ParallelUtilities::forEachIndex(revisions.size(), [&](int i){
+        const RevisionPair& pair = revisions.at(i);
+        // The sums of the metrics of each key, and the number of runs
+        using Sums = QPair<QMap<QString, double>, int>;
+        QHash<QString, Sums> sums[2];
+        QSet<QString> commands;
+        auto getKey = [](const RunRecord& record) {
+            return QString("%1 %2 %3")
+                .arg(record.result.mazeHash, 16, 16, QChar('0'))
+                .arg(record.seed)
+                .arg(record.mouseFile);
+        };
+
+        // A run that didn't complete may not have gotten any sim time, e.g.,
+        // if it couldn't be set up, so it counts as taking as long as the
+        // longest run of its key, which for a timeout is the limit
+        QHash<QString, double> longestSimTimes;
+        for (int index : indicesByAlgo.value(pair.algoName)) {
+            const RunRecord& record = records.at(index);
+            double& longest = longestSimTimes[getKey(record)];
+            longest = std::max(longest, record.result.simTime);
+        }
+
+        for (int index : indicesByAlgo.value(pair.algoName)) {
+            const RunRecord& record = records.at(index);
+            int side = -1;
+            if (record.buildHash == pair.baseline) {
+                side = 0;
+            }
+            else if (record.buildHash == pair.candidate) {
+                side = 1;
+            }
+            else {
+                continue;
+            }
+            QString key = getKey(record);
+            Sums& keySums = sums[side][key];
+            const TournamentResult& result = record.result;
+            bool isComplete = result.status == "complete";
+            if (!isComplete) {
+                keySums.first["time_to_center"] += longestSimTimes.value(key);
+            }
+            else {
+                keySums.first["time_to_center"] +=
+                    result.bestTimeToCenter < 0.0 ? result.simTime : result.bestTimeToCenter;
+            }
+            keySums.first["failure_rate"] += isComplete && !result.crashed ? 0.0 : 1.0;
+            int numCommands = 0;
+            const QMap<QString, int>& counts = result.commandCounts;
+            for (auto it = counts.constBegin(); it != counts.constEnd(); it += 1) {
+                keySums.first["commands:" + it.key()] += it.value();
+                commands.insert(it.key());
+                numCommands += it.value();
+            }
+            keySums.first["commands"] += numCommands;
+            keySums.second += 1;
+        }
+        QStringList metrics = {"time_to_center", "failure_rate", "commands"};
+        QStringList commandList = commands.values();
+        std::sort(commandList.begin(), commandList.end());
+        for (const QString& command : commandList) {
+            metrics.append("commands:" + command);
+        }
+        for (auto it = sums[0].constBegin(); it != sums[0].constEnd(); it += 1) {
+            if (!sums[1].contains(it.key())) {
+                continue;
+            }
+            const Sums& baselineSums = it.value();
+            const Sums& candidateSums = sums[1].value(it.key());
+            for (const QString& metric : metrics) {
+                samplesByPair[i][metric].append({
+                    baselineSums.first.value(metric) / baselineSums.second,
+                    candidateSums.first.value(metric) / candidateSums.second,
+                });
+            }
+        }
+    });
+
+    // Then the statistics of every metric of every pair, in parallel
+    QVector<MetricComparison> comparisons;
+    QVector<const QVector<QPair<double, double>>*> samples;
+    for (int i = 0; i < revisions.size(); i += 1) {
+        const RevisionPair& pair = revisions.at(i);
+        const Samples& pairSamples = samplesByPair.at(i);
+        for (auto it = pairSamples.constBegin(); it != pairSamples.constEnd(); it += 1) {
+            comparisons.append({
+                pair.algoName, pair.baseline, pair.candidate, it.key(),
+                0, 0.0, 0.0, 0.0, false,
+            });
+            samples.append(&it.value());
+        }
+    }
+    ParallelUtilities::forEachIndex(comparisons.size(), [&](int i){
+
+        // A paired t-test on the differences, candidate minus baseline
+        MetricComparison& comparison = comparisons[i];
+        const QVector<QPair<double, double>>& pairs = *samples.at(i);
+        int n = pairs.size();
+        double baselineSum = 0.0;
+        double candidateSum = 0.0;
+        for (const QPair<double, double>& pair : pairs) {
+            baselineSum += pair.first;
+            candidateSum += pair.second;
+        }
+        comparison.numPairs = n;
+        comparison.baselineMean = baselineSum / n;
+        comparison.candidateMean = candidateSum / n;
+        double meanDifference = comparison.candidateMean - comparison.baselineMean;
+        if (n < 2) {
+            return;
+        }
+        double sumOfSquares = 0.0;
+        for (const QPair<double, double>& pair : pairs) {
+            double deviation = pair.second - pair.first - meanDifference;
+            sumOfSquares += deviation * deviation;
+        }
+        double standardError = std::sqrt(sumOfSquares / (n - 1) / n);
+
+        // Runs are often deterministic, in which case every difference may
+        // be the same, and any consistent increase is a real one
+        if (standardError == 0.0) {
+            double infinity = std::numeric_limits<double>::infinity();
+            comparison.t = meanDifference == 0.0 ? 0.0 : std::copysign(infinity, meanDifference);
+        }
+        else {
+            comparison.t = meanDifference / standardError;
+        }
+        comparison.isRegression =
+            0.0 < meanDifference && getCriticalValue(n - 1) < comparison.t;
+    });
+
+    return comparisons;
+}
+
+QString RunComparison::toCsv(const QVector<MetricComparison>& comparisons) {
+    QStringList lines;
+    lines.append(
+        "algorithm,baseline,candidate,metric,pairs,baseline_mean,"
+        "candidate_mean,change,t,regression"
+    );
+    for (const MetricComparison& comparison : comparisons) {
+        QString algoName = comparison.algoName;
+        algoName.replace("\"", "\"\"");
+        double change = comparison.baselineMean == 0.0 ? 0.0 :
+            (comparison.candidateMean - comparison.baselineMean) / comparison.baselineMean;
+        lines.append(QStringList({
+            "\"" + algoName + "\"",
+            QString("%1").arg(comparison.baseline, 16, 16, QChar('0')),
+            QString("%1").arg(comparison.candidate, 16, 16, QChar('0')),
+            comparison.metric,
+            QString::number(comparison.numPairs),
+            QString::number(comparison.baselineMean, 'f', 3),
+            QString::number(comparison.candidateMean, 'f', 3),
+            QString::number(change * 100.0, 'f', 1) + "%",
+            QString::number(comparison.t, 'f', 3),
+            comparison.isRegression ? "true" : "false",
+        }).join(","));
+    }
+    return lines.join("\n") + "\n";
+}
+
+double RunComparison::getCriticalValue(int degreesOfFreedom) {
+    if (degreesOfFreedom <= 30) {
+        return T_CRITICAL_VALUES[degreesOfFreedom - 1];
+    }
+    // Approaches the normal distribution's 1.960, and is within 0.002 of the
+    // exact value beyond 30 degrees of freedom
+    return 1.960 + 2.5 / degreesOfFreedom;
+}
+
+QVector<RevisionPair> RunComparison::getRevisionPairs(
+        const QVector<RunRecord>& records,
+        const QString& baseline,
+        const QString& candidate) {
+
+    // The builds of each algorithm, in the order that they first ran
+    QMap<QString, QVector<quint64>> builds;
+    QMap<QString, QMap<quint64, qint64>> firstRuns;
+    for (const RunRecord& record : records) {
+        QMap<quint64, qint64>& runs = firstRuns[record.algoName];
+        if (
+            !runs.contains(record.buildHash) ||
+            record.timestamp < runs.value(record.buildHash)
+        ) {
+            runs.insert(record.buildHash, record.timestamp);
+        }
+    }
+    for (auto it = firstRuns.constBegin(); it != firstRuns.constEnd(); it += 1) {
+        QVector<quint64> hashes = it.value().keys().toVector();
+        const QMap<quint64, qint64>& runs = it.value();
+        std::sort(hashes.begin(), hashes.end(), [&](quint64 a, quint64 b){
+            return runs.value(a) < runs.value(b);
+        });
+        builds.insert(it.key(), hashes);
+    }
+
+    QVector<RevisionPair> revisions;
+    if (baseline.isEmpty()) {
+        for (auto it = builds.constBegin(); it != builds.constEnd(); it += 1) {
+            int n = it.value().size();
+            if (2 <= n) {
+                revisions.append({it.key(), it.value().at(n - 2), it.value().at(n - 1)});
+            }
+        }
+        return revisions;
+    }
+    bool baselineOk = false;
+    bool candidateOk = false;
+    quint64 baselineHash = baseline.toULongLong(&baselineOk, 16);
+    quint64 candidateHash = candidate.toULongLong(&candidateOk, 16);
+    if (!baselineOk || !candidateOk) {
+        qWarning().noquote().nospace()
+            << "Invalid build hash \"" << (baselineOk ? candidate : baseline) << "\".";
+        return revisions;
+    }
+    for (auto it = builds.constBegin(); it != builds.constEnd(); it += 1) {
+        if (it.value().contains(baselineHash) && it.value().contains(candidateHash)) {
+            revisions.append({it.key(), baselineHash, candidateHash});
+        }
+    }
+    return revisions;
+}
+
+} // namespace mms
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QCommandLineParser>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtGlobal>
+
+#include "RunStore.h"
+
+namespace mms {
+
+// Two builds of an algorithm, see Tournament::getBuildHash()
+struct RevisionPair {
+    QString algoName;
+    quint64 baseline;
+    quint64 candidate;
+};
+
+// How one metric of an algorithm changed between two of its revisions, over
+// the runs that both revisions made (same maze, mouse file and seed)
+struct MetricComparison {
+    QString algoName;
+    quint64 baseline;
+    quint64 candidate;
+    QString metric;
+    int numPairs;
+    double baselineMean;
+    double candidateMean;
+    // The paired t statistic of the candidate minus the baseline
+    double t;
+    // Whether the candidate is worse, i.e., larger, with 95% confidence
+    bool isRegression;
+};
+
+// Compares revisions of mouse algorithms using the runs in a RunStore. Every
+// metric is lower-is-better: the time to the center (runs that never got
+// there count as taking their whole sim time, and runs that didn't complete
+// as taking the longest sim time of any run of the same key), the fraction
+// of runs that failed, timed out, errored or crashed, the total number of
+// commands, and the number of each command.
+class RunComparison {
+
+public:
+
+    RunComparison() = delete;
+
+    // Compares the baseline and candidate builds of each algorithm, given as
+    // hexadecimal build hashes, or, if both are empty, the two most recent
+    // builds of each algorithm. Writes the comparisons as CSV to the file, or
+    // to stdout if the path is empty. Returns the number of regressions, or
+    // -1 on failure.
+    static int report(
+        const QString& storePath,
+        const QString& baseline,
+        const QString& candidate,
+        const QString& path);
+
+    // The options of --compare, and running it with them as parsed, which
+    // returns the exit code: 2 if there are regressions
+    static void addOptions(QCommandLineParser* parser);
+    static int runFromArguments(const QCommandLineParser& parser);
+
+    // Compares the revisions, computing the metrics on all cores
+    static QVector<MetricComparison> compare(
+        const QVector<RunRecord>& records,
+        const QVector<RevisionPair>& revisions);
+
+    static QString toCsv(const QVector<MetricComparison>& comparisons);
+
+private:
+
+    // The two-sided 95% critical values of Student's t distribution, for 1
+    // through 30 degrees of freedom
+    static const double T_CRITICAL_VALUES[30];
+
+    static double getCriticalValue(int degreesOfFreedom);
+
+    // The pairs to compare, or an empty vector if there are none
+    static QVector<RevisionPair> getRevisionPairs(
+        const QVector<RunRecord>& records,
+        const QString& baseline,
+        const QString& candidate);
+};
+
+} // namespace mms
@@ -0,0 +1,228 @@
+#include "RunStore.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QPair>
+#include <QVector>
+#include <QtEndian>
+
+#include <cstring>
+
+#include "ParallelUtilities.h"
+
+namespace mms {
+
+// The layout of a run store, with all integers little-endian:
+//
+//   header (16 bytes)
+//     0    char[4]     magic, "MMSR"
+//     4    quint32     version
+//     8    quint64     reserved
+//
+//   record, repeated
+//     0    quint32     size of the payload
+//     4    payload, a little-endian QDataStream (Qt 5.6) of, in order:
+//            algorithm name, build hash, maze hash, mouse file, seed,
+//            timestamp, status, best time to center, exploration time,
+//            distance, crashed, sim time, tiles traversed, closest distance
+//            to center, error, and the command counts (a QMap<QString, int>)
+
+const QString RunStore::SUFFIX = "mmsr";
+const char RunStore::MAGIC[4] = {'M', 'M', 'S', 'R'};
+
+RunStore* RunStore::open(const QString& path) {
+
+    RunStore* store = new RunStore(path);
+    auto fail = [&](const QString& reason) -> RunStore* {
+        qWarning().noquote().nospace()
+            << "Unable to open run store \"" << path << "\": " << reason << ".";
+        delete store;
+        return nullptr;
+    };
+
+    if (!store->m_file.open(QIODevice::ReadWrite | QIODevice::Append)) {
+        return fail("file can't be written");
+    }
+
+    // Write the header of a new store, or check that of an existing one
+    if (store->m_file.size() == 0) {
+        QByteArray header(HEADER_SIZE, '\0');
+        std::memcpy(header.data(), MAGIC, sizeof(MAGIC));
+        qToLittleEndian<quint32>(VERSION, header.data() + 4);
+        if (store->m_file.write(header) != header.size() || !store->m_file.flush()) {
+            return fail("header can't be written");
+        }
+    }
+    else {
+        store->m_file.seek(0);
+        QByteArray header = store->m_file.read(HEADER_SIZE);
+        if (
+            header.size() != HEADER_SIZE ||
+            std::memcmp(header.constData(), MAGIC, sizeof(MAGIC)) != 0
+        ) {
+            return fail("not a run store");
+        }
+        if (qFromLittleEndian<quint32>(header.constData() + 4) != VERSION) {
+            return fail("unsupported version");
+        }
+
+        // A run that was cut short may have left a partial record behind.
+        // Records are found by their size prefixes, so anything appended
+        // after it would be lost too; it's cut off before appending.
+        qint64 fileSize = store->m_file.size();
+        qint64 offset = HEADER_SIZE;
+        while (offset + 4 <= fileSize) {
+            store->m_file.seek(offset);
+            QByteArray size = store->m_file.read(4);
+            if (size.size() != 4) {
+                break;
+            }
+            qint64 end = offset + 4 + qFromLittleEndian<quint32>(size.constData());
+            if (fileSize < end) {
+                break;
+            }
+            offset = end;
+        }
+        if (offset != fileSize) {
+            qWarning().noquote().nospace()
+                << "Removing the truncated last record of run store \""
+                << path << "\".";
+            if (!store->m_file.resize(offset)) {
+                return fail("truncated last record can't be removed");
+            }
+        }
+    }
+
+    return store;
+}
+
+bool RunStore::append(const RunRecord& record) {
+    QByteArray payload = encode(record);
+    QByteArray size(4, '\0');
+    qToLittleEndian<quint32>(payload.size(), size.data());
+    return (
+        m_file.write(size) == size.size() &&
+        m_file.write(payload) == payload.size() &&
+        m_file.flush()
+    );
+}
+
+bool RunStore::read(const QString& path, QVector<RunRecord>* records) {
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning().noquote().nospace()
+            << "Unable to read run store \"" << path << "\".";
+        return false;
+    }
+    QByteArray bytes = file.readAll();
+    if (
+        bytes.size() < HEADER_SIZE ||
+        std::memcmp(bytes.constData(), MAGIC, sizeof(MAGIC)) != 0 ||
+        qFromLittleEndian<quint32>(bytes.constData() + 4) != VERSION
+    ) {
+        qWarning().noquote().nospace()
+            << "Unable to read run store \"" << path << "\": not a run store.";
+        return false;
+    }
+
+    // Finding the records only takes a hop per record, so it's done up front,
+    // and the decoding, which is the bulk of the work, is done in parallel
+    QVector<QPair<int, int>> spans;
+    qint64 offset = HEADER_SIZE;
+    while (offset + 4 <= bytes.size()) {
+        qint64 size = qFromLittleEndian<quint32>(bytes.constData() + offset);
+        if (bytes.size() < offset + 4 + size) {
+            break;
+        }
+        spans.append({static_cast<int>(offset + 4), static_cast<int>(size)});
+        offset += 4 + size;
+    }
+    if (offset != bytes.size()) {
+        qWarning().noquote().nospace()
+            << "Skipping the truncated last record of run store \"" << path << "\".";
+    }
+
+    // Each index is only ever written by the thread that claimed it
+    QVector<RunRecord> decoded(spans.size());
+    QVector<bool> isValid(spans.size(), false);
+    ParallelUtilities::forEachIndex(spans.size(), [&](int i){
+        QByteArray payload = QByteArray::fromRawData(
+            bytes.constData() + spans.at(i).first,
+            spans.at(i).second);
+        isValid[i] = decode(payload, &decoded[i]);
+    });
+
+    records->clear();
+    for (int i = 0; i < decoded.size(); i += 1) {
+        if (isValid.at(i)) {
+            records->append(decoded.at(i));
+        }
+        else {
+            qWarning().noquote().nospace()
+                << "Skipping malformed record " << i << " of run store \""
+                << path << "\".";
+        }
+    }
+    return true;
+}
+
+RunStore::RunStore(const QString& path) : m_file(path) {
+}
+
+QByteArray RunStore::encode(const RunRecord& record) {
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    const TournamentResult& result = record.result;
+    stream
+        << record.algoName
+        << record.buildHash
+        << result.mazeHash
+        << record.mouseFile
+        << record.seed
+        << record.timestamp
+        << result.status
+        << result.bestTimeToCenter
+        << result.explorationTime
+        << result.distance
+        << result.crashed
+        << result.simTime
+        << static_cast<qint32>(result.tilesTraversed)
+        << static_cast<qint32>(result.closestDistanceToCenter)
+        << result.error
+        << result.commandCounts;
+    return bytes;
+}
+
+bool RunStore::decode(const QByteArray& bytes, RunRecord* record) {
+    QDataStream stream(bytes);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    TournamentResult& result = record->result;
+    qint32 tilesTraversed = 0;
+    qint32 closestDistanceToCenter = -1;
+    stream
+        >> record->algoName
+        >> record->buildHash
+        >> result.mazeHash
+        >> record->mouseFile
+        >> record->seed
+        >> record->timestamp
+        >> result.status
+        >> result.bestTimeToCenter
+        >> result.explorationTime
+        >> result.distance
+        >> result.crashed
+        >> result.simTime
+        >> tilesTraversed
+        >> closestDistanceToCenter
+        >> result.error
+        >> result.commandCounts;
+    result.tilesTraversed = tilesTraversed;
+    result.closestDistanceToCenter = closestDistanceToCenter;
+    return stream.status() == QDataStream::Ok && stream.atEnd();
+}
+
+} // namespace mms
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+#include "Tournament.h"
+
+namespace mms {
+
+// One run of a mouse algorithm, as kept in a RunStore. Runs of the same
+// algorithm revision on the same maze, mouse and seed share a key, and runs
+// of different revisions with the same key can be compared.
+struct RunRecord {
+    QString algoName;
+    // See Tournament::getBuildHash()
+    quint64 buildHash;
+    QString mouseFile;
+    quint32 seed;
+    // Milliseconds since the epoch, for ordering the revisions
+    qint64 timestamp;
+    // Holds the maze hash, the MouseStats and the command counts
+    TournamentResult result;
+};
+
+// An append-only file of RunRecords. Records are only ever added to the end,
+// so a store can accumulate the results of many tournaments, across many
+// revisions of each algorithm, and a run that's cut short loses at most its
+// last record.
+class RunStore {
+
+public:
+
+    // The suffix of run store files
+    static const QString SUFFIX;
+
+    // Opens the store for appending, creating it if it doesn't exist, or
+    // returns nullptr if it can't be opened or isn't a run store
+    static RunStore* open(const QString& path);
+
+    // Writes the record to the end of the store, and flushes it
+    bool append(const RunRecord& record);
+
+    // Reads every record in the store, decoding them on all cores. Returns
+    // false if the store can't be read. A truncated last record is skipped.
+    static bool read(const QString& path, QVector<RunRecord>* records);
+
+private:
+
+    explicit RunStore(const QString& path);
+
+    // See RunStore.cpp for the layout of the file
+    static const char MAGIC[4];
+    static const quint32 VERSION = 1;
+    static const int HEADER_SIZE = 16;
+
+    QFile m_file;
+
+    static QByteArray encode(const RunRecord& record);
+    static bool decode(const QByteArray& bytes, RunRecord* record);
+};
+
+} // namespace mms
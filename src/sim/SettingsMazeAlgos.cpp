@@ -10,6 +10,7 @@ const QString SettingsMazeAlgos::KEY_NAME = "name";
 const QString SettingsMazeAlgos::KEY_DIR_PATH = "dirPath";
 const QString SettingsMazeAlgos::KEY_BUILD_COMMAND = "buildCommand";
 const QString SettingsMazeAlgos::KEY_RUN_COMMAND = "runCommand";
+const QString SettingsMazeAlgos::KEY_BUILT_HASH = "builtHash";
 
 QStringList SettingsMazeAlgos::names() {
     return Settings::get()->values(GROUP, KEY_NAME);
@@ -27,6 +28,16 @@ QString SettingsMazeAlgos::getRunCommand(const QString& name) {
     return getValue(name, KEY_RUN_COMMAND);
 }
 
+QString SettingsMazeAlgos::getBuiltHash(const QString& name) {
+    return getValue(name, KEY_BUILT_HASH);
+}
+
+void SettingsMazeAlgos::setBuiltHash(const QString& name, const QString& builtHash) {
+    Settings::get()->update(GROUP, KEY_NAME, name, {
+        {KEY_BUILT_HASH, builtHash},
+    });
+}
+
 void SettingsMazeAlgos::add(
     const QString& name,
     const QString& dirPath,
@@ -16,6 +16,11 @@ public:
     static QString getBuildCommand(const QString& name);
     static QString getRunCommand(const QString& name);
 
+    // The hex AlgoBuilder::getSourceHash() of the last successful build, or
+    // empty if the algorithm hasn't been built
+    static QString getBuiltHash(const QString& name);
+    static void setBuiltHash(const QString& name, const QString& builtHash);
+
     static void add(
         const QString& name,
         const QString& dirPath,
@@ -38,6 +43,7 @@ private:
     static const QString KEY_DIR_PATH;
     static const QString KEY_BUILD_COMMAND;
     static const QString KEY_RUN_COMMAND;
+    static const QString KEY_BUILT_HASH;
 
     static QString getValue(const QString& name, const QString& key);
 
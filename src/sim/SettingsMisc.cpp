@@ -7,9 +7,15 @@ namespace mms {
 
 const QString SettingsMisc::GROUP = "misc";
 const QString SettingsMisc::KEY_RECENT_MAZE_ALGO = "recent-maze-algo";
+const QString SettingsMisc::KEY_MAZE_ALGO_BINARY_OUTPUT = "maze-algo-binary-output";
 const QString SettingsMisc::KEY_RECENT_MOUSE_ALGO = "recent-mouse-algo";
 const QString SettingsMisc::KEY_RECENT_WINDOW_WIDTH = "recent-window-width";
 const QString SettingsMisc::KEY_RECENT_WINDOW_HEIGHT = "recent-window-height";
+const QString SettingsMisc::KEY_EXPORT_WIDTH = "export-width";
+const QString SettingsMisc::KEY_EXPORT_HEIGHT = "export-height";
+const QString SettingsMisc::KEY_EXPORT_FRAME_INTERVAL = "export-frame-interval";
+const QString SettingsMisc::KEY_CHECKPOINT_INTERVAL = "checkpoint-interval";
+const QString SettingsMisc::KEY_CHECKPOINT_CAPACITY = "checkpoint-capacity";
 const QString SettingsMisc::KEY_FONT_IMAGE_PATH_COMBO_BOX_VALUE =
     "font-image-path-combo-box-value";
 const QString SettingsMisc::KEY_FONT_IMAGE_PATH_LINE_EDIT_VALUE =
@@ -25,6 +31,15 @@ void SettingsMisc::setRecentMazeAlgo(const QString& name) {
     setValue(KEY_RECENT_MAZE_ALGO, name);
 }
 
+bool SettingsMisc::getMazeAlgoBinaryOutput() {
+    return getValue(KEY_MAZE_ALGO_BINARY_OUTPUT) == "true";
+}
+
+void SettingsMisc::setMazeAlgoBinaryOutput(bool binaryOutput) {
+    QString value = binaryOutput ? "true" : "false";
+    setValue(KEY_MAZE_ALGO_BINARY_OUTPUT, value);
+}
+
 QString SettingsMisc::getRecentMouseAlgo() {
     return getValue(KEY_RECENT_MOUSE_ALGO);
 }
@@ -49,6 +64,46 @@ void SettingsMisc::setRecentWindowHeight(int height) {
     setValue(KEY_RECENT_WINDOW_HEIGHT, QString::number(height));
 }
 
+int SettingsMisc::getExportWidth() {
+    return getNumber(KEY_EXPORT_WIDTH, 1024);
+}
+
+void SettingsMisc::setExportWidth(int width) {
+    setValue(KEY_EXPORT_WIDTH, QString::number(width));
+}
+
+int SettingsMisc::getExportHeight() {
+    return getNumber(KEY_EXPORT_HEIGHT, 1024);
+}
+
+void SettingsMisc::setExportHeight(int height) {
+    setValue(KEY_EXPORT_HEIGHT, QString::number(height));
+}
+
+int SettingsMisc::getExportFrameInterval() {
+    return getNumber(KEY_EXPORT_FRAME_INTERVAL, 100);
+}
+
+void SettingsMisc::setExportFrameInterval(int milliseconds) {
+    setValue(KEY_EXPORT_FRAME_INTERVAL, QString::number(milliseconds));
+}
+
+int SettingsMisc::getCheckpointInterval() {
+    return getNumber(KEY_CHECKPOINT_INTERVAL, 1000);
+}
+
+void SettingsMisc::setCheckpointInterval(int milliseconds) {
+    setValue(KEY_CHECKPOINT_INTERVAL, QString::number(milliseconds));
+}
+
+int SettingsMisc::getCheckpointCapacity() {
+    return getNumber(KEY_CHECKPOINT_CAPACITY, 3600);
+}
+
+void SettingsMisc::setCheckpointCapacity(int capacity) {
+    setValue(KEY_CHECKPOINT_CAPACITY, QString::number(capacity));
+}
+
 QString SettingsMisc::getFontImagePathComboBoxValue() {
     return getValue(KEY_FONT_IMAGE_PATH_COMBO_BOX_VALUE);
 }
@@ -13,6 +13,9 @@ public:
     static QString getRecentMazeAlgo();
     static void setRecentMazeAlgo(const QString& name);
 
+    static bool getMazeAlgoBinaryOutput();
+    static void setMazeAlgoBinaryOutput(bool binaryOutput);
+
     static QString getRecentMouseAlgo();
     static void setRecentMouseAlgo(const QString& name);
 
@@ -22,6 +25,20 @@ public:
     static int getRecentWindowHeight();
     static void setRecentWindowHeight(int height);
 
+    // Offscreen image and frame export
+    static int getExportWidth();
+    static void setExportWidth(int width);
+    static int getExportHeight();
+    static void setExportHeight(int height);
+    static int getExportFrameInterval();
+    static void setExportFrameInterval(int milliseconds);
+
+    // Run checkpoints, see CheckpointHistory
+    static int getCheckpointInterval();
+    static void setCheckpointInterval(int milliseconds);
+    static int getCheckpointCapacity();
+    static void setCheckpointCapacity(int capacity);
+
     // Font image path
     static QString getFontImagePathComboBoxValue();
     static QString getFontImagePathLineEditValue();
@@ -34,9 +51,15 @@ private:
 
     static const QString GROUP;
     static const QString KEY_RECENT_MAZE_ALGO;
+    static const QString KEY_MAZE_ALGO_BINARY_OUTPUT;
     static const QString KEY_RECENT_MOUSE_ALGO;
     static const QString KEY_RECENT_WINDOW_WIDTH;
     static const QString KEY_RECENT_WINDOW_HEIGHT;
+    static const QString KEY_EXPORT_WIDTH;
+    static const QString KEY_EXPORT_HEIGHT;
+    static const QString KEY_EXPORT_FRAME_INTERVAL;
+    static const QString KEY_CHECKPOINT_INTERVAL;
+    static const QString KEY_CHECKPOINT_CAPACITY;
 
     static const QString KEY_FONT_IMAGE_PATH_LINE_EDIT_VALUE;
     static const QString KEY_FONT_IMAGE_PATH_COMBO_BOX_VALUE;
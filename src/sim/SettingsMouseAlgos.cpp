@@ -18,6 +18,7 @@ const QString SettingsMouseAlgos::KEY_MOUSE_FILE_PATH_LINE_EDIT_VALUE =
     "mouseFilePathLineEditValue";
 const QString SettingsMouseAlgos::KEY_MOUSE_FILE_PATH_COMBO_BOX_SELECTED =
     "mouseFilePathComboBoxSelected";
+const QString SettingsMouseAlgos::KEY_BUILT_HASH = "builtHash";
 
 QStringList SettingsMouseAlgos::names() {
     return Settings::get()->values(GROUP, KEY_NAME);
@@ -47,6 +48,23 @@ bool SettingsMouseAlgos::getMouseFilePathComboBoxSelected(const QString& name) {
     return getValue(name, KEY_MOUSE_FILE_PATH_COMBO_BOX_SELECTED) == "true";
 }
 
+QString SettingsMouseAlgos::getMouseFilePath(const QString& name) {
+    if (getMouseFilePathComboBoxSelected(name)) {
+        return getMouseFilePathComboBoxValue(name);
+    }
+    return getMouseFilePathLineEditValue(name);
+}
+
+QString SettingsMouseAlgos::getBuiltHash(const QString& name) {
+    return getValue(name, KEY_BUILT_HASH);
+}
+
+void SettingsMouseAlgos::setBuiltHash(const QString& name, const QString& builtHash) {
+    Settings::get()->update(GROUP, KEY_NAME, name, {
+        {KEY_BUILT_HASH, builtHash},
+    });
+}
+
 void SettingsMouseAlgos::add(
     const QString& name,
     const QString& dirPath,
@@ -19,6 +19,14 @@ public:
     static QString getMouseFilePathLineEditValue(const QString& name);
     static bool getMouseFilePathComboBoxSelected(const QString& name);
 
+    // The combo box value if it was selected, and the line edit value if not
+    static QString getMouseFilePath(const QString& name);
+
+    // The hex AlgoBuilder::getSourceHash() of the last successful build, or
+    // empty if the algorithm hasn't been built
+    static QString getBuiltHash(const QString& name);
+    static void setBuiltHash(const QString& name, const QString& builtHash);
+
     static void add(
         const QString& name,
         const QString& dirPath,
@@ -50,6 +58,7 @@ private:
     static const QString KEY_MOUSE_FILE_PATH_COMBO_BOX_VALUE;
     static const QString KEY_MOUSE_FILE_PATH_LINE_EDIT_VALUE;
     static const QString KEY_MOUSE_FILE_PATH_COMBO_BOX_SELECTED;
+    static const QString KEY_BUILT_HASH;
     
     static QString getValue(const QString& name, const QString& key);
     
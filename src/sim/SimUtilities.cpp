@@ -1,6 +1,12 @@
 #include "SimUtilities.h"
 
 #include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
 #include <QRegExp>
 #include <QThread>
 #include <QTime>
@@ -65,6 +71,111 @@ QStringList SimUtilities::splitLines(const QString& string) {
     return string.split(QRegExp("\n|\r\n|\r"));
 }
 
+QStringList SimUtilities::getLines(const QString& text, QStringList* buffer) {
+
+    // TODO: upforgrabs
+    // Determine whether or not this function is perf sensitive. If so,
+    // refactor this so that we're not copying QStrings between lists.
+
+    // Separate the text by line
+    QStringList parts = SimUtilities::splitLines(text);
+
+    // We'll return list of complete lines
+    QStringList lines;
+
+    // If the text has at least one newline character, we definitely have a
+    // complete line; combine it with the contents of the buffer and append
+    // it to the list of lines to be returned
+    if (1 < parts.size()) {
+        lines.append(buffer->join("") + parts.at(0));
+        buffer->clear();
+    }
+
+    // All newline-separated parts in the text are lines
+    for (int i = 1; i < parts.size() - 1; i += 1) {
+        lines.append(parts.at(i));
+    }
+
+    // Store the last part of the text (empty string if the text ended
+    // with newline) in the buffer, to be combined with future input
+    buffer->append(parts.at(parts.size() - 1));
+
+    return lines;
+}
+
+quint64 SimUtilities::hashBytes(const QByteArray& bytes, quint64 hash) {
+    for (char byte : bytes) {
+        hash ^= static_cast<quint8>(byte);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+quint64 SimUtilities::hashDirectory(const QString& dirPath) {
+
+    // Sort the paths, since the iteration order depends on the file system
+    QDir dir(dirPath);
+    QStringList paths;
+    QDirIterator iterator(dirPath, QDir::Files, QDirIterator::Subdirectories);
+    while (iterator.hasNext()) {
+        paths.append(dir.relativeFilePath(iterator.next()));
+    }
+    std::sort(paths.begin(), paths.end());
+
+    // The NUL after each path keeps the boundaries between them unambiguous
+    quint64 hash = hashBytes(QByteArray());
+    for (const QString& path : paths) {
+        quint64 fileHash = 0;
+        if (!hashFile(dir.filePath(path), &fileHash)) {
+            continue;
+        }
+        hash = hashBytes(path.toUtf8() + '\0', hash);
+        hash = hashBytes(QByteArray::number(fileHash) + '\0', hash);
+    }
+    return hash;
+}
+
+bool SimUtilities::hashFile(const QString& path, quint64* hash) {
+
+    // Directories are hashed from the UI thread and from worker threads
+    struct Entry {
+        qint64 size;
+        QDateTime lastModified;
+        quint64 hash;
+    };
+    static QMutex mutex;
+    static QHash<QString, Entry> cache;
+
+    QFileInfo info(path);
+    QString key = info.absoluteFilePath();
+    qint64 size = info.size();
+    QDateTime lastModified = info.lastModified();
+    mutex.lock();
+    auto it = cache.constFind(key);
+    bool isCached = (
+        it != cache.constEnd() &&
+        it->size == size &&
+        it->lastModified == lastModified
+    );
+    if (isCached) {
+        *hash = it->hash;
+    }
+    mutex.unlock();
+    if (isCached) {
+        return true;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    *hash = hashBytes(file.readAll());
+    mutex.lock();
+    cache.insert(key, {size, lastModified, *hash});
+    mutex.unlock();
+    return true;
+}
+
 bool SimUtilities::isBool(const QString& str) {
     return str == "true" || str == "false";
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QByteArray>
 #include <QPair>
 #include <QString>
 #include <QStringList>
@@ -45,6 +46,21 @@ public:
     // Splits into lines in a cross-platform way
     static QStringList splitLines(const QString& string);
 
+    // Given some text (and a buffer containing past input), return
+    // all complete lines and append remaining text to the buffer
+    static QStringList getLines(const QString& text, QStringList* buffer);
+
+    // 64-bit FNV-1a of the bytes, continuing from a previous hash, if any
+    static quint64 hashBytes(
+        const QByteArray& bytes,
+        quint64 hash = 14695981039346656037ULL);
+
+    // A hash of the relative path and contents of every file in a directory,
+    // recursively, skipping hidden files and directories such as .git. The
+    // hash of each file's contents is cached by its size and modification
+    // time, so hashing a directory again only reads the files that changed.
+    static quint64 hashDirectory(const QString& dirPath);
+
     // Convert between types
     static bool isBool(const QString& str);
     static bool isInt(const QString& str);
@@ -61,6 +77,12 @@ public:
         Color color,
         double alpha);
 
+private:
+
+    // The hash of the contents of a file, from the cache if the file's size
+    // and modification time didn't change. Returns false if it can't be read.
+    static bool hashFile(const QString& path, quint64* hash);
+
 };
 
 } // namespace mms
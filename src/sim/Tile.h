@@ -1,50 +1,32 @@
 #pragma once
 
-#include <QMap>
-#include <QVector>
+#include <QtGlobal>
 
 #include "Direction.h"
-#include "Polygon.h"
 
 namespace mms {
 
-class Tile{
+// A lightweight, read-only view of a single tile of a maze. Tiles are handed
+// out by value by Maze::getTile(); the walls live in the maze's WallGrid, and
+// the geometry of a tile is computed by TileGeometry.
+class Tile {
 
 public:
     Tile();
+    Tile(int x, int y, quint8 walls, int distance);
 
     int getX() const;
     int getY() const;
-    void setPos(int x, int y);
 
     bool isWall(Direction direction) const;
-    void setWall(Direction direction, bool isWall);
 
     int getDistance() const;
-    void setDistance(int distance);
-
-    Polygon getFullPolygon() const;
-    Polygon getInteriorPolygon() const;
-    Polygon getWallPolygon(Direction direction) const;
-    QVector<Polygon> getCornerPolygons() const;
-
-    void initPolygons(int mazeWidth, int mazeHeight);
 
 private:
     int m_x;
     int m_y;
-    QMap<Direction, bool> m_walls;
+    quint8 m_walls;
     int m_distance;
-
-    Polygon m_fullPolygon;
-    Polygon m_interiorPolygon;
-    QMap<Direction, Polygon> m_wallPolygons;
-    QVector<Polygon> m_cornerPolygons;
-
-    void initFullPolygon(int mazeWidth, int mazeHeight);
-    void initInteriorPolygon(int mazeWidth, int mazeHeight);
-    void initWallPolygons(int mazeWWidth, int mazeHeight);
-    void initCornerPolygons(int mazeWWidth, int mazeHeight);
 };
 
 } // namespace mms
@@ -0,0 +1,92 @@
+#include "TileGeometry.h"
+
+#include "Param.h"
+
+namespace mms {
+
+TileGeometry::TileGeometry(int mazeWidth, int mazeHeight) :
+    TileGeometry(mazeWidth, mazeHeight, P()->wallLength(), P()->wallWidth()) {
+}
+
+TileGeometry::TileGeometry(
+        int mazeWidth,
+        int mazeHeight,
+        double wallLength,
+        double wallWidth) :
+        m_mazeWidth(mazeWidth),
+        m_mazeHeight(mazeHeight),
+        m_wallLength(wallLength),
+        m_wallWidth(wallWidth) {
+}
+
+QPair<Coordinate, Coordinate> TileGeometry::getFullRectangle(int x, int y) const {
+    Bounds full = getFullBounds(x, y);
+    return toRectangle(full.left, full.bottom, full.right, full.top);
+}
+
+QPair<Coordinate, Coordinate> TileGeometry::getInteriorRectangle(int x, int y) const {
+    Bounds interior = getInteriorBounds(x, y);
+    return toRectangle(interior.left, interior.bottom, interior.right, interior.top);
+}
+
+QPair<Coordinate, Coordinate> TileGeometry::getWallRectangle(
+        int x, int y, Direction direction) const {
+    Bounds outer = getFullBounds(x, y);
+    Bounds inner = getInteriorBounds(x, y);
+    switch (direction) {
+        case Direction::NORTH:
+            return toRectangle(inner.left, inner.top, inner.right, outer.top);
+        case Direction::EAST:
+            return toRectangle(inner.right, inner.bottom, outer.right, inner.top);
+        case Direction::SOUTH:
+            return toRectangle(inner.left, outer.bottom, inner.right, inner.bottom);
+        case Direction::WEST:
+            return toRectangle(outer.left, inner.bottom, inner.left, inner.top);
+    }
+}
+
+QVector<QPair<Coordinate, Coordinate>> TileGeometry::getCornerRectangles(
+        int x, int y) const {
+    Bounds outer = getFullBounds(x, y);
+    Bounds inner = getInteriorBounds(x, y);
+    return {
+        toRectangle(outer.left, outer.bottom, inner.left, inner.bottom),
+        toRectangle(outer.left, inner.top, inner.left, outer.top),
+        toRectangle(inner.right, inner.top, outer.right, outer.top),
+        toRectangle(inner.right, outer.bottom, outer.right, inner.bottom),
+    };
+}
+
+TileGeometry::Bounds TileGeometry::getFullBounds(int x, int y) const {
+    // Tiles on the edge of the maze extend an extra half wall width outward,
+    // so that the outer walls are as thick as the inner ones
+    double halfWallWidth = m_wallWidth / 2.0;
+    double tileLength = m_wallLength + m_wallWidth;
+    return {
+        tileLength * x - (x == 0 ? halfWallWidth : 0.0),
+        tileLength * y - (y == 0 ? halfWallWidth : 0.0),
+        tileLength * (x + 1) + (x == m_mazeWidth - 1 ? halfWallWidth : 0.0),
+        tileLength * (y + 1) + (y == m_mazeHeight - 1 ? halfWallWidth : 0.0),
+    };
+}
+
+TileGeometry::Bounds TileGeometry::getInteriorBounds(int x, int y) const {
+    double halfWallWidth = m_wallWidth / 2.0;
+    Bounds full = getFullBounds(x, y);
+    return {
+        full.left + halfWallWidth * (x == 0 ? 2 : 1),
+        full.bottom + halfWallWidth * (y == 0 ? 2 : 1),
+        full.right - halfWallWidth * (x == m_mazeWidth - 1 ? 2 : 1),
+        full.top - halfWallWidth * (y == m_mazeHeight - 1 ? 2 : 1),
+    };
+}
+
+QPair<Coordinate, Coordinate> TileGeometry::toRectangle(
+        double left, double bottom, double right, double top) {
+    return {
+        Coordinate::Cartesian(Distance::Meters(left), Distance::Meters(bottom)),
+        Coordinate::Cartesian(Distance::Meters(right), Distance::Meters(top)),
+    };
+}
+
+} // namespace mms
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QPair>
+#include <QVector>
+
+#include "Direction.h"
+#include "units/Coordinate.h"
+
+namespace mms {
+
+// Computes the rectangles that make up a tile, given the tile's position, the
+// size of the maze, and the wall length and width. Nothing is stored per tile;
+// every rectangle is a handful of multiplications away. Each rectangle is
+// returned as a pair of its lower left and upper right corners.
+//
+//      5---6-------------9---a
+//      |   |             |   |
+//      4---7-------------8---b
+//      |   |             |   |
+//      |   |             |   |
+//      |   |             |   |
+//      |   |             |   |
+//      |   |             |   |
+//      1---2-------------d---e
+//      |   |             |   |
+//      0---3-------------c---f
+//
+//      full: 0a
+//      interior: 28
+//      walls: north 79, east de, south 3d, west 17
+//      corners: lower left 02, upper left 46, upper right 8a, lower right cf
+class TileGeometry {
+
+public:
+
+    // Uses the wall length and width from the params
+    TileGeometry(int mazeWidth, int mazeHeight);
+    TileGeometry(int mazeWidth, int mazeHeight, double wallLength, double wallWidth);
+
+    QPair<Coordinate, Coordinate> getFullRectangle(int x, int y) const;
+    QPair<Coordinate, Coordinate> getInteriorRectangle(int x, int y) const;
+    QPair<Coordinate, Coordinate> getWallRectangle(int x, int y, Direction direction) const;
+
+    // In the order lower left, upper left, upper right, lower right
+    QVector<QPair<Coordinate, Coordinate>> getCornerRectangles(int x, int y) const;
+
+private:
+
+    int m_mazeWidth;
+    int m_mazeHeight;
+    double m_wallLength;
+    double m_wallWidth;
+
+    // The left, bottom, right, and top bounds of a tile, in meters
+    struct Bounds {
+        double left;
+        double bottom;
+        double right;
+        double top;
+    };
+    Bounds getFullBounds(int x, int y) const;
+    Bounds getInteriorBounds(int x, int y) const;
+
+    static QPair<Coordinate, Coordinate> toRectangle(
+        double left, double bottom, double right, double top);
+};
+
+} // namespace mms
@@ -2,26 +2,42 @@
 
 #include <QPair>
 
+#include "Assert.h"
 #include "Color.h"
 #include "ColorManager.h"
 #include "FontImage.h"
 #include "Param.h"
+#include "WallGrid.h"
 
 namespace mms {
 
+bool TileGraphicState::operator==(const TileGraphicState& other) const {
+    return (
+        color == other.color &&
+        declaredWalls == other.declaredWalls &&
+        declaredWallValues == other.declaredWallValues &&
+        foggy == other.foggy &&
+        text == other.text
+    );
+}
+
 TileGraphic::TileGraphic() :
-    m_tile(nullptr),
+    m_geometry(0, 0, 0.0, 0.0),
     m_bufferInterface(nullptr),
     m_color(Color::BLACK),
+    m_declaredWalls(0),
+    m_declaredWallValues(0),
     m_foggy(false),
     m_wallTruthVisible(false),
     m_tileColorsVisible(false),
     m_tileFogVisible(false),
-    m_tileTextVisible(false) {
+    m_tileTextVisible(false),
+    m_autopopulateTextWithDistance(false) {
 }
 
 TileGraphic::TileGraphic(
-        const Tile* tile,
+        const Tile& tile,
+        const TileGeometry& geometry,
         BufferInterface* bufferInterface,
         bool wallTruthVisible,
         bool tileColorsVisible,
@@ -29,34 +45,75 @@ TileGraphic::TileGraphic(
         bool tileTextVisible,
         bool autopopulateTextWithDistance) :
         m_tile(tile),
+        m_geometry(geometry),
         m_bufferInterface(bufferInterface),
         m_color(ColorManager::get()->getTileBaseColor()),
+        m_declaredWalls(0),
+        m_declaredWallValues(0),
         m_foggy(true),
         m_wallTruthVisible(wallTruthVisible),
         m_tileColorsVisible(tileColorsVisible),
         m_tileFogVisible(tileFogVisible),
-        m_tileTextVisible(tileTextVisible) {
-    if (autopopulateTextWithDistance) {
-        m_text = (
-            0 <= m_tile->getDistance()
-            ? QString::number(m_tile->getDistance())
-            : "inf"
-        );
+        m_tileTextVisible(tileTextVisible),
+        m_autopopulateTextWithDistance(autopopulateTextWithDistance) {
+    if (m_autopopulateTextWithDistance) {
+        m_text = getDistanceText();
+    }
+}
+
+void TileGraphic::setTile(const Tile& tile) {
+    ASSERT_EQ(tile.getX(), m_tile.getX());
+    ASSERT_EQ(tile.getY(), m_tile.getY());
+    m_tile = tile;
+    updateWalls();
+    if (m_autopopulateTextWithDistance) {
+        setText(getDistanceText());
     }
 }
 
+void TileGraphic::reset() {
+    m_declaredWalls = 0;
+    m_declaredWallValues = 0;
+    updateWalls();
+    setColor(ColorManager::get()->getTileBaseColor());
+    setFogginess(true);
+    setText(m_autopopulateTextWithDistance ? getDistanceText() : "");
+}
+
+TileGraphicState TileGraphic::getState() const {
+    return {m_color, m_declaredWalls, m_declaredWallValues, m_foggy, m_text};
+}
+
+void TileGraphic::setState(const TileGraphicState& state) {
+    m_declaredWalls = state.declaredWalls;
+    m_declaredWallValues = state.declaredWallValues;
+    updateWalls();
+    setColor(state.color);
+    setFogginess(state.foggy);
+    setText(state.text);
+}
+
 void TileGraphic::setColor(Color color) {
     m_color = color;
     updateColor();
 }
 
 void TileGraphic::declareWall(Direction direction, bool isWall) {
-    m_declaredWalls[direction] = isWall;
+    quint8 bit = WallGrid::directionBit(direction);
+    m_declaredWalls |= bit;
+    if (isWall) {
+        m_declaredWallValues |= bit;
+    }
+    else {
+        m_declaredWallValues &= ~bit;
+    }
     updateWall(direction);
 }
 
 void TileGraphic::undeclareWall(Direction direction) {
-    m_declaredWalls.remove(direction);
+    quint8 bit = WallGrid::directionBit(direction);
+    m_declaredWalls &= ~bit;
+    m_declaredWallValues &= ~bit;
     updateWall(direction);
 }
 
@@ -66,6 +123,9 @@ void TileGraphic::setFogginess(bool foggy) {
 }
 
 void TileGraphic::setText(const QString& text) {
+    if (text == m_text) {
+        return;
+    }
     m_text = text;
     updateText();
 }
@@ -90,44 +150,56 @@ void TileGraphic::setTileTextVisible(bool visible) {
     updateText();
 }
 
-void TileGraphic::drawPolygons() const {
+void TileGraphic::drawPolygons(TileGraphicLayer layer) const {
 
     // Note that the order in which we call insertIntoGraphicCpuBuffer
     // determines the order in which the polygons are drawn. Also note that the
-    // *StartingIndex methods in GrahicsUtilities.h depend upon this order.
-
-    // Draw the base of the tile
-    m_bufferInterface->insertIntoGraphicCpuBuffer(
-        m_tile->getFullPolygon(),
-        m_tileColorsVisible
-            ? m_color
-            : ColorManager::get()->getTileBaseColor(),
-        1.0);
-
-    // Draw each of the walls of the tile
-    for (Direction direction : DIRECTIONS()) {
-        QPair<Color, float> colorAndAlpha = deduceWallColorAndAlpha(direction);
-        m_bufferInterface->insertIntoGraphicCpuBuffer(
-            m_tile->getWallPolygon(direction),
-            colorAndAlpha.first,
-            colorAndAlpha.second);
-    }
-
-    // Draw the corners of the tile
-    for (Polygon polygon : m_tile->getCornerPolygons()) {
-        m_bufferInterface->insertIntoGraphicCpuBuffer(
-            polygon,
-            ColorManager::get()->getTileCornerColor(),
-            1.0);
+    // *StartingIndex methods in BufferInterface depend upon this order.
+
+    switch (layer) {
+
+        // Draw the base of the tile
+        case TileGraphicLayer::BASE:
+            m_bufferInterface->insertIntoGraphicCpuBuffer(
+                m_geometry.getFullRectangle(m_tile.getX(), m_tile.getY()),
+                m_tileColorsVisible
+                    ? m_color
+                    : ColorManager::get()->getTileBaseColor(),
+                1.0);
+            break;
+
+        // Draw each of the walls of the tile
+        case TileGraphicLayer::WALLS:
+            for (Direction direction : DIRECTIONS()) {
+                QPair<Color, float> colorAndAlpha = deduceWallColorAndAlpha(direction);
+                m_bufferInterface->insertIntoGraphicCpuBuffer(
+                    m_geometry.getWallRectangle(m_tile.getX(), m_tile.getY(), direction),
+                    colorAndAlpha.first,
+                    colorAndAlpha.second);
+            }
+            break;
+
+        // Draw the corners of the tile
+        case TileGraphicLayer::CORNERS:
+            for (const auto& rectangle : m_geometry.getCornerRectangles(
+                    m_tile.getX(), m_tile.getY())) {
+                m_bufferInterface->insertIntoGraphicCpuBuffer(
+                    rectangle,
+                    ColorManager::get()->getTileCornerColor(),
+                    1.0);
+            }
+            break;
+
+        // Draw the fog
+        case TileGraphicLayer::FOG:
+            m_bufferInterface->insertIntoGraphicCpuBuffer(
+                m_geometry.getFullRectangle(m_tile.getX(), m_tile.getY()),
+                ColorManager::get()->getTileFogColor(),
+                m_foggy && m_tileFogVisible
+                    ? ColorManager::get()->getTileFogAlpha()
+                    : 0.0);
+            break;
     }
-
-    // Draw the fog
-    m_bufferInterface->insertIntoGraphicCpuBuffer(
-        m_tile->getFullPolygon(),
-        ColorManager::get()->getTileFogColor(),
-        m_foggy && m_tileFogVisible
-            ? ColorManager::get()->getTileFogAlpha()
-            : 0.0);
 }
 
 void TileGraphic::drawTextures() {
@@ -139,14 +211,17 @@ void TileGraphic::drawTextures() {
             m_bufferInterface->insertIntoTextureCpuBuffer();
         }
     }
+    // ... forget whatever glyphs were previously written, since the
+    // triangle texture objects are brand new ...
+    m_glyphs.fill(-1, maxRowsAndCols.first * maxRowsAndCols.second);
     // ... and then populate those triangle texture objects with data
     updateText();
 }
 
 void TileGraphic::updateColor() const {
     m_bufferInterface->updateTileGraphicBaseColor(
-        m_tile->getX(),
-        m_tile->getY(),
+        m_tile.getX(),
+        m_tile.getY(),
         m_tileColorsVisible
             ? m_color
             : ColorManager::get()->getTileBaseColor());
@@ -160,54 +235,56 @@ void TileGraphic::updateWalls() const {
 
 void TileGraphic::updateFog() const {
     m_bufferInterface->updateTileGraphicFog(
-        m_tile->getX(),
-        m_tile->getY(),
+        m_tile.getX(),
+        m_tile.getY(),
         m_foggy && m_tileFogVisible
             ? ColorManager::get()->getTileFogAlpha()
             : 0.0);
 }
 
-void TileGraphic::updateText() const {
+void TileGraphic::updateText() {
 
     // First, retrieve the maximum number of rows and cols of text allowed
     QPair<int, int> maxRowsAndCols =
         m_bufferInterface->getTileGraphicTextMaxSize();
-
-    // Then, generate the rows of text that will be displayed
-    QVector<QString> rowsOfText;
-
-    // Split the text into rows
-    QString remaining = m_text;
-    while (!remaining.isEmpty() && rowsOfText.size() < maxRowsAndCols.first) {
-        QString row = remaining.left(maxRowsAndCols.second);
-        rowsOfText.append(row);
-        remaining = remaining.mid(maxRowsAndCols.second);
+    int maxRows = maxRowsAndCols.first;
+    int maxCols = maxRowsAndCols.second;
+    if (maxRows <= 0 || maxCols <= 0) {
+        m_glyphs.clear();
+        return;
+    }
+    if (m_glyphs.size() != maxRows * maxCols) {
+        m_glyphs.fill(-1, maxRows * maxCols);
     }
 
-    // For all possible character positions, insert some character
-    // (blank if necessary) into the tile text cpu buffer
-    for (int row = 0; row < maxRowsAndCols.first; row += 1) {
-        for (int col = 0; col < maxRowsAndCols.second; col += 1) {
-            int numRows = std::min(
-                static_cast<int>(rowsOfText.size()),
-                maxRowsAndCols.first
-            );
-            int numCols = std::min(
-                static_cast<int>(row < rowsOfText.size() ? rowsOfText.at(row).size() : 0),
-                maxRowsAndCols.second
-            );
+    // The text is split into rows of at most maxCols characters each, and
+    // anything that doesn't fit in maxRows rows is dropped
+    int length = m_text.size();
+    int numRows = std::min((length + maxCols - 1) / maxCols, maxRows);
+
+    // For all possible character positions, insert some character (blank if
+    // necessary) into the tile text cpu buffer, but only if that position
+    // doesn't already contain the exact same glyph
+    for (int row = 0; row < maxRows; row += 1) {
+        int numCols = 0;
+        if (row < numRows) {
+            numCols = std::min(length - row * maxCols, maxCols);
+        }
+        for (int col = 0; col < maxCols; col += 1) {
             QChar c = ' ';
-            if (
-                m_tileTextVisible &&
-                row < rowsOfText.size() &&
-                col < rowsOfText.at(row).size()
-            ) {
-                c = rowsOfText.at(row).at(col).toLatin1();
+            if (m_tileTextVisible && col < numCols) {
+                c = m_text.at(row * maxCols + col).toLatin1();
+            }
+            ASSERT_TR(FontImage::get()->contains(c));
+            int glyph = encodeGlyph(numRows, numCols, c);
+            int slot = row * maxCols + col;
+            if (m_glyphs.at(slot) == glyph) {
+                continue;
             }
-            ASSERT_TR(FontImage::get()->positions().contains(c));
+            m_glyphs[slot] = glyph;
             m_bufferInterface->updateTileGraphicText(
-                m_tile->getX(),
-                m_tile->getY(),
+                m_tile.getX(),
+                m_tile.getY(),
                 numRows,
                 numCols,
                 row,
@@ -218,11 +295,29 @@ void TileGraphic::updateText() const {
     }
 }
 
+int TileGraphic::encodeGlyph(int numRows, int numCols, QChar c) {
+    // The position of a character depends not only on the character itself
+    // but also on the number of rows and cols being displayed, so all three
+    // are packed together; none of them exceed a byte
+    ASSERT_LT(numRows, 256);
+    ASSERT_LT(numCols, 256);
+    ASSERT_LT(c.unicode(), 256);
+    return (numRows << 16) | (numCols << 8) | c.unicode();
+}
+
+QString TileGraphic::getDistanceText() const {
+    return (
+        0 <= m_tile.getDistance()
+        ? QString::number(m_tile.getDistance())
+        : "inf"
+    );
+}
+
 void TileGraphic::updateWall(Direction direction) const {
     QPair<Color, float> colorAndAlpha = deduceWallColorAndAlpha(direction);
     m_bufferInterface->updateTileGraphicWallColor(
-        m_tile->getX(),
-        m_tile->getY(),
+        m_tile.getX(),
+        m_tile.getY(),
         direction,
         colorAndAlpha.first,
         colorAndAlpha.second
@@ -237,17 +332,18 @@ QPair<Color, float> TileGraphic::deduceWallColorAndAlpha(Direction direction) co
 
     // Either draw the true walls of the tile ...
     if (m_wallTruthVisible) {
-        wallAlpha = m_tile->isWall(direction) ? 1.0 : 0.0;
+        wallAlpha = m_tile.isWall(direction) ? 1.0 : 0.0;
     }
 
     // ... or the algorithm's (un)declared walls
     else {
 
         // If the wall was declared, use the wall color and tile base color ...
-        if (m_declaredWalls.contains(direction)) {
-            if (m_declaredWalls.value(direction)) {
+        quint8 bit = WallGrid::directionBit(direction);
+        if ((m_declaredWalls & bit) != 0) {
+            if ((m_declaredWallValues & bit) != 0) {
                 // Correct declaration
-                if (m_tile->isWall(direction)) {
+                if (m_tile.isWall(direction)) {
                     wallColor = ColorManager::get()->getTileWallColor();
                 }
                 // Incorrect declaration
@@ -257,7 +353,7 @@ QPair<Color, float> TileGraphic::deduceWallColorAndAlpha(Direction direction) co
             }
             else {
                 // Incorrect declaration
-                if (m_tile->isWall(direction)) {
+                if (m_tile.isWall(direction)) {
                     wallColor = ColorManager::get()->getIncorrectlyDeclaredNoWallColor();
                 }
                 // Correct declaration
@@ -269,7 +365,7 @@ QPair<Color, float> TileGraphic::deduceWallColorAndAlpha(Direction direction) co
 
         // ... otherwise, use the undeclared walls colors
         else {
-            if (m_tile->isWall(direction)) {
+            if (m_tile.isWall(direction)) {
                 wallColor = ColorManager::get()->getUndeclaredWallColor();
             }
             else {
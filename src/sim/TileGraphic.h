@@ -1,21 +1,36 @@
 #pragma once
 
-#include <QMap>
 #include <QPair>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
 
 #include "BufferInterface.h"
 #include "Color.h"
 #include "Tile.h"
+#include "TileGeometry.h"
+#include "TileGraphicLayer.h"
 
 namespace mms {
 
+// What a mouse algorithm drew on a tile, see TileGraphic::getState()
+struct TileGraphicState {
+    Color color;
+    quint8 declaredWalls;
+    quint8 declaredWallValues;
+    bool foggy;
+    QString text;
+    bool operator==(const TileGraphicState& other) const;
+};
+
 class TileGraphic {
 
 public:
 
     TileGraphic();
     TileGraphic(
-        const Tile* tile,
+        const Tile& tile,
+        const TileGeometry& geometry,
         BufferInterface* bufferInterface,
         bool wallTruthVisible,
         bool tileColorsVisible,
@@ -23,6 +38,19 @@ public:
         bool tileTextVisible,
         bool autopopulateTextWithDistance);
 
+    // Rebinds the graphic to a tile at the same position, e.g., of a rotated
+    // maze, updating only the walls and distance text in place
+    void setTile(const Tile& tile);
+
+    // Restores the color, declared walls, fog and text to how they were when
+    // the graphic was constructed, as for a new run on the same maze
+    void reset();
+
+    // Gets/sets the color, declared walls, fog and text, e.g., to show the
+    // tile as it was at a checkpoint
+    TileGraphicState getState() const;
+    void setState(const TileGraphicState& state);
+
     void setColor(const Color color);
     void declareWall(Direction direction, bool isWall);
     void undeclareWall(Direction direction);
@@ -35,7 +63,7 @@ public:
     void setTileTextVisible(bool visible);
 
     // TODO: MACK - rename these to "reload" or something
-    void drawPolygons() const;
+    void drawPolygons(TileGraphicLayer layer) const;
     void drawTextures();
 
     // TODO: MACK - do I need these anymore?
@@ -43,17 +71,21 @@ public:
     void updateColor() const;
     void updateWalls() const;
     void updateFog() const;
-    void updateText() const;
+    void updateText();
     
 private:
 
     // Input and output objects
-    const Tile* m_tile;
+    Tile m_tile;
+    TileGeometry m_geometry;
     BufferInterface* m_bufferInterface;
 
     // Visual state
     Color m_color;
-    QMap<Direction, bool> m_declaredWalls;
+    // The directions in which walls have been declared, and of those, the
+    // directions in which they were declared to exist, as wall grid masks
+    quint8 m_declaredWalls;
+    quint8 m_declaredWallValues;
     bool m_foggy;
     QString m_text;
 
@@ -62,8 +94,15 @@ private:
     bool m_tileColorsVisible;
     bool m_tileFogVisible;
     bool m_tileTextVisible;
+    bool m_autopopulateTextWithDistance;
+
+    // The glyph last written to each character slot of the texture buffer,
+    // used to skip slots that haven't changed (see encodeGlyph)
+    QVector<int> m_glyphs;
 
     // Helper functions
+    static int encodeGlyph(int numRows, int numCols, QChar c);
+    QString getDistanceText() const;
     void updateWall(Direction direction) const;
     QPair<Color, float> deduceWallColorAndAlpha(Direction direction) const;
 };
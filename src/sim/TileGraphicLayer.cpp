@@ -0,0 +1,25 @@
+#include "TileGraphicLayer.h"
+
+namespace mms {
+
+const QVector<TileGraphicLayer>& TILE_GRAPHIC_LAYERS() {
+    static const QVector<TileGraphicLayer> layers = {
+        TileGraphicLayer::BASE,
+        TileGraphicLayer::WALLS,
+        TileGraphicLayer::CORNERS,
+        TileGraphicLayer::FOG,
+    };
+    return layers;
+}
+
+const QMap<TileGraphicLayer, QString>& TILE_GRAPHIC_LAYER_TO_STRING() {
+    static const QMap<TileGraphicLayer, QString> map = {
+        {TileGraphicLayer::BASE, "BASE"},
+        {TileGraphicLayer::WALLS, "WALLS"},
+        {TileGraphicLayer::CORNERS, "CORNERS"},
+        {TileGraphicLayer::FOG, "FOG"},
+    };
+    return map;
+}
+
+} // namespace mms
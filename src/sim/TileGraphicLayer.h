@@ -0,0 +1,28 @@
+#pragma once
+
+#include <QDebug>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+namespace mms {
+
+// The graphic cpu buffer is split into layers, drawn in this order. Within
+// each layer, every tile has the same number of triangles, and the tiles are
+// laid out column by column.
+enum class TileGraphicLayer {
+    BASE,
+    WALLS,
+    CORNERS,
+    FOG,
+};
+
+const QVector<TileGraphicLayer>& TILE_GRAPHIC_LAYERS();
+const QMap<TileGraphicLayer, QString>& TILE_GRAPHIC_LAYER_TO_STRING();
+
+inline QDebug operator<<(QDebug stream, TileGraphicLayer tileGraphicLayer) {
+    stream.noquote() << TILE_GRAPHIC_LAYER_TO_STRING().value(tileGraphicLayer);
+    return stream;
+}
+
+} // namespace mms
@@ -1,5 +1,6 @@
 #include "TileGraphicTextCache.h"
 
+#include "Assert.h"
 #include "FontImage.h"
 
 namespace mms {
@@ -22,20 +23,15 @@ QPair<int, int> TileGraphicTextCache::getTileGraphicTextMaxSize() const {
 }
 
 QPair<double, double> TileGraphicTextCache::getFontImageCharacterPosition(QChar c) const {
-    ASSERT_TR(FontImage::get()->positions().contains(c));
-    return FontImage::get()->positions().value(c);
+    return FontImage::get()->position(c);
 }
 
 QPair<Coordinate, Coordinate> TileGraphicTextCache::getTileGraphicTextPosition(
         int x, int y, int numRows, int numCols, int row, int col) const {
 
     // Get the character position in the maze for the starting tile
-    QPair<Coordinate, Coordinate> textPosition = m_tileGraphicTextPositions.value(
-        {
-            {numRows, numCols},
-            {row, col}
-        }
-    );
+    const QPair<Coordinate, Coordinate>& textPosition =
+        m_tileGraphicTextPositions.at(getPositionIndex(numRows, numCols, row, col));
 
     // Now get the character position in the maze for *this* tile
     Distance tileLength = m_wallLength + m_wallWidth;
@@ -46,9 +42,25 @@ QPair<Coordinate, Coordinate> TileGraphicTextCache::getTileGraphicTextPosition(
     return {LL, UR};
 }
 
-QMap<
-    QPair<QPair<int, int>, QPair<int, int>>,
-    QPair<Coordinate, Coordinate>> TileGraphicTextCache::buildPositionCache(
+int TileGraphicTextCache::getPositionIndex(
+        int numRows, int numCols, int row, int col) const {
+    int maxRows = m_tileGraphicTextMaxSize.first;
+    int maxCols = m_tileGraphicTextMaxSize.second;
+    ASSERT_LE(0, numRows);
+    ASSERT_LE(numRows, maxRows);
+    ASSERT_LE(0, numCols);
+    ASSERT_LE(numCols, maxCols);
+    ASSERT_LE(0, row);
+    ASSERT_LE(row, maxRows);
+    ASSERT_LE(0, col);
+    ASSERT_LE(col, maxCols);
+    return (
+        ((numRows * (maxCols + 1) + numCols) * (maxRows + 1) + row)
+        * (maxCols + 1) + col
+    );
+}
+
+QVector<QPair<Coordinate, Coordinate>> TileGraphicTextCache::buildPositionCache(
         double borderFraction, TileTextAlignment tileTextAlignment) {
 
     // The tile graphic text could look like either of the following, depending
@@ -72,13 +84,12 @@ QMap<
     //     *[A]--------------------------*-*    *[A]--------------------------*-*
     //     *-*---------------------------*-*    *-*---------------------------*-*
 
-    QMap<
-        QPair<QPair<int, int>, QPair<int, int>>,
-        QPair<Coordinate, Coordinate>> positionCache;
-
     int maxRows = m_tileGraphicTextMaxSize.first;
     int maxCols = m_tileGraphicTextMaxSize.second;
 
+    QVector<QPair<Coordinate, Coordinate>> positionCache(
+        (maxRows + 1) * (maxCols + 1) * (maxRows + 1) * (maxCols + 1));
+
     // First we get the unscaled diagonal
     Coordinate A = Coordinate::Cartesian(m_wallWidth / 2.0, m_wallWidth / 2.0);
     Coordinate B = A + Coordinate::Cartesian(m_wallLength, m_wallLength);
@@ -144,16 +155,8 @@ QMap<
                         );
                     }
 
-                    positionCache.insert(
-                        {
-                            // The number of rows/cols to be drawn
-                            {numRows, numCols},
-                            // The row and col of the current character
-                            {row, col}
-                        },
-                        // The lower left and upper right texture coordinate
-                        {LL, UR}
-                    );
+                    // The lower left and upper right texture coordinate
+                    positionCache[getPositionIndex(numRows, numCols, row, col)] = {LL, UR};
                 }
             }
         }
@@ -1,8 +1,8 @@
 #pragma once
 
 #include <QChar>
-#include <QMap>
 #include <QPair>
+#include <QVector>
 
 #include "TileTextAlignment.h"
 #include "units/Coordinate.h"
@@ -40,18 +40,18 @@ private:
     // The max rows and cols of text per tile
     QPair<int, int> m_tileGraphicTextMaxSize;
 
-    // A map of the number of rows/cols to be displayed and the current row/col
-    // to the LL/UR text coordinates for the starting tile, namely tile (0, 0)
-    QMap<
-        QPair<QPair<int, int>, QPair<int, int>>,
-        QPair<Coordinate, Coordinate>> m_tileGraphicTextPositions;
+    // A flat table, indexed by the number of rows/cols to be displayed and the
+    // current row/col (see getPositionIndex), of the LL/UR text coordinates
+    // for the starting tile, namely tile (0, 0)
+    QVector<QPair<Coordinate, Coordinate>> m_tileGraphicTextPositions;
+
+    // Returns the index into the text position table
+    int getPositionIndex(int numRows, int numCols, int row, int col) const;
 
     // Just a helper method for building the text position cache
-    QMap<
-        QPair<QPair<int, int>, QPair<int, int>>,
-        QPair<Coordinate, Coordinate>> buildPositionCache(
-            double borderFraction,
-            TileTextAlignment tiletextAlignment);
+    QVector<QPair<Coordinate, Coordinate>> buildPositionCache(
+        double borderFraction,
+        TileTextAlignment tiletextAlignment);
 };
 
 } // namespace mms
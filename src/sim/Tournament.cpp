@@ -0,0 +1,829 @@
+#include "Tournament.h"
+
+#include <QAtomicInt>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+#include <functional>
+
+#include "AlgoBuilder.h"
+#include "FrameRecorder.h"
+#include "LayoutType.h"
+#include "Maze.h"
+#include "MazeFileUtilities.h"
+#include "MazeView.h"
+#include "Model.h"
+#include "Mouse.h"
+#include "MouseGraphic.h"
+#include "MouseInterface.h"
+#include "ProcessUtilities.h"
+#include "RunStore.h"
+#include "SettingsMisc.h"
+#include "SettingsMouseAlgos.h"
+#include "SimTime.h"
+#include "SimUtilities.h"
+#include "units/Duration.h"
+
+namespace mms {
+
+const QString Tournament::RESULT_PREFIX = "TOURNAMENT RESULT ";
+
+TournamentLimits::TournamentLimits() :
+    simSpeed(10.0),
+    simTimeLimit(600.0),
+    jobTimeout(120.0) {
+}
+
+TournamentResult::TournamentResult() :
+    status("error"),
+    bestTimeToCenter(-1.0),
+    explorationTime(-1.0),
+    distance(0.0),
+    crashed(false),
+    simTime(0.0),
+    tilesTraversed(0),
+    closestDistanceToCenter(-1),
+    mazeHash(0) {
+}
+
+int Tournament::run(
+        const QStringList& algoNames,
+        const QStringList& directories,
+        quint32 firstSeed,
+        int numSeeds,
+        const TournamentLimits& limits,
+        const QString& path,
+        const QString& storePath,
+        const QString& exportDirectory,
+        bool exportFrames) {
+
+    for (const QString& algoName : algoNames) {
+        if (!SettingsMouseAlgos::names().contains(algoName)) {
+            qWarning().noquote().nospace()
+                << "Unknown mouse algorithm \"" << algoName << "\".";
+            return -1;
+        }
+    }
+    if (!exportDirectory.isEmpty() && !QDir().mkpath(exportDirectory)) {
+        qWarning().noquote().nospace()
+            << "Unable to create the export directory \"" << exportDirectory << "\".";
+        return -1;
+    }
+    RunStore* store = nullptr;
+    if (!storePath.isEmpty()) {
+        store = RunStore::open(storePath);
+        if (store == nullptr) {
+            return -1;
+        }
+    }
+    QMap<QString, quint64> buildHashes;
+    for (const QString& algoName : algoNames) {
+        buildHashes.insert(algoName, getBuildHash(algoName));
+        qInfo().noquote().nospace()
+            << "Build of " << algoName << ": "
+            << QString("%1").arg(buildHashes.value(algoName), 16, 16, QChar('0')) << ".";
+    }
+    QStringList mazeFiles = MazeFileUtilities::findMazeFiles(directories);
+    QVector<TournamentJob> jobs;
+    for (const QString& algoName : algoNames) {
+        for (const QString& mazeFile : mazeFiles) {
+            for (int i = 0; i < numSeeds; i += 1) {
+                jobs.append({algoName, mazeFile, firstSeed + static_cast<quint32>(i)});
+            }
+        }
+    }
+
+    // Consecutive runs of the same algorithm are batched into one process, so
+    // that a persistent algorithm is only started once per batch (see
+    // runJobs()). The batches are kept small enough that there are several
+    // per slot, and each free slot takes the next batch in the queue, so a
+    // slow run never holds up the others, and every core stays busy until
+    // the queue is empty.
+    int numSlots = std::max(1, QThread::idealThreadCount());
+    int batchSize = std::max(1, std::min(
+        MAX_BATCH_SIZE,
+        static_cast<int>(jobs.size()) / (numSlots * BATCHES_PER_SLOT)));
+    QVector<QPair<int, int>> batches;
+    for (int begin = 0; begin < jobs.size();) {
+        int end = begin + 1;
+        while (
+            end < jobs.size() &&
+            end - begin < batchSize &&
+            jobs.at(end).algoName == jobs.at(begin).algoName
+        ) {
+            end += 1;
+        }
+        batches.append({begin, end});
+        begin = end;
+    }
+
+    QVector<TournamentResult> results(jobs.size());
+    QVector<bool> timedOut(batches.size(), false);
+    int next = 0;
+    int numRunning = 0;
+    int numFinished = 0;
+    QEventLoop loop;
+    std::function<void()> startBatches;
+    std::function<void(int, QProcess*)> finishBatch = [&](int batch, QProcess* process) {
+
+        // A batch that was killed is missing the results of its last runs
+        QVector<TournamentResult> batchResults = readResults(process->readAllStandardOutput());
+        for (int index = batches.at(batch).first; index < batches.at(batch).second; index += 1) {
+            int i = index - batches.at(batch).first;
+            if (i < batchResults.size()) {
+                results[index] = batchResults.at(i);
+            }
+            else if (timedOut.at(batch)) {
+                results[index].status = "timeout";
+            }
+            else {
+                results[index].error = "no result";
+            }
+            if (store != nullptr) {
+                const TournamentJob& job = jobs.at(index);
+                RunRecord record;
+                record.algoName = job.algoName;
+                record.buildHash = buildHashes.value(job.algoName);
+                record.mouseFile = SettingsMouseAlgos::getMouseFilePath(job.algoName);
+                record.seed = job.seed;
+                record.timestamp = QDateTime::currentMSecsSinceEpoch();
+                record.result = results.at(index);
+                if (!store->append(record)) {
+                    qWarning().noquote().nospace()
+                        << "Unable to write to the run store \"" << storePath << "\".";
+                }
+            }
+            numFinished += 1;
+            qInfo().noquote().nospace()
+                << "[" << numFinished << "/" << jobs.size() << "] "
+                << jobs.at(index).algoName << " on \"" << jobs.at(index).mazeFile
+                << "\" (seed " << jobs.at(index).seed << "): "
+                << results.at(index).status << ".";
+        }
+        process->deleteLater();
+        numRunning -= 1;
+        if (numFinished == jobs.size()) {
+            loop.quit();
+        }
+        else {
+            startBatches();
+        }
+    };
+    startBatches = [&]() {
+        while (numRunning < numSlots && next < batches.size()) {
+            int batch = next;
+            next += 1;
+            numRunning += 1;
+            QProcess* process = new QProcess();
+            process->setStandardErrorFile(QProcess::nullDevice());
+
+            // Each run enforces its own time limit, so this only catches a
+            // process that hangs outright
+            int numJobs = batches.at(batch).second - batches.at(batch).first;
+            QTimer* timer = new QTimer(process);
+            timer->setSingleShot(true);
+            QObject::connect(timer, &QTimer::timeout, process, [&, batch, process](){
+                timedOut[batch] = true;
+                process->kill();
+            });
+            QObject::connect(
+                process,
+                static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(
+                    &QProcess::finished
+                ),
+                process,
+                [&, batch, process](){
+                    finishBatch(batch, process);
+                }
+            );
+            QObject::connect(
+                process,
+                &QProcess::errorOccurred,
+                process,
+                [&, batch, process](QProcess::ProcessError error){
+                    // Otherwise, the process still finishes
+                    if (error == QProcess::FailedToStart) {
+                        finishBatch(batch, process);
+                    }
+                }
+            );
+            process->start(
+                QCoreApplication::applicationFilePath(),
+                getJobArguments(
+                    jobs.at(batches.at(batch).first).algoName,
+                    limits,
+                    exportDirectory,
+                    exportFrames));
+            process->write(getJobInput(jobs.mid(batches.at(batch).first, numJobs)));
+            process->closeWriteChannel();
+            timer->start(static_cast<int>(limits.jobTimeout * (numJobs + 1) * 1000));
+        }
+    };
+    if (!jobs.isEmpty()) {
+        startBatches();
+        loop.exec();
+    }
+    delete store;
+
+    QByteArray output = toCsv(jobs, results).toUtf8();
+    if (path.isEmpty()) {
+        QTextStream(stdout) << output;
+    }
+    else {
+        QSaveFile file(path);
+        if (
+            !file.open(QIODevice::WriteOnly) ||
+            file.write(output) != output.size() ||
+            !file.commit()
+        ) {
+            qWarning().noquote().nospace()
+                << "Unable to write the tournament results to \"" << path << "\".";
+            return -1;
+        }
+    }
+    int numComplete = 0;
+    for (const TournamentResult& result : results) {
+        if (result.status == "complete") {
+            numComplete += 1;
+        }
+    }
+    qInfo().noquote().nospace()
+        << "Completed " << numComplete << " of " << jobs.size() << " runs.";
+    return numComplete;
+}
+
+int Tournament::runJobs(
+        const QString& algoName,
+        const TournamentLimits& limits,
+        const QString& exportDirectory,
+        bool exportFrames) {
+
+    // The runs are listed on stdin, one "<seed> <maze file>" per line
+    QFile input;
+    input.open(stdin, QIODevice::ReadOnly);
+    QVector<TournamentJob> jobs;
+    for (const QString& line : SimUtilities::splitLines(QString::fromUtf8(input.readAll()))) {
+        int space = line.indexOf(' ');
+        if (0 < space) {
+            jobs.append({algoName, line.mid(space + 1), line.left(space).toUInt()});
+        }
+    }
+    if (!SettingsMouseAlgos::names().contains(algoName)) {
+        TournamentResult result;
+        result.error = "unknown mouse algorithm";
+        for (int i = 0; i < jobs.size(); i += 1) {
+            printResult(result);
+        }
+        return 1;
+    }
+
+    // As in the GUI, the model steps the mouse on its own thread, and the
+    // algorithm's commands are handled on another
+    Model model;
+    QThread modelThread;
+    QObject::connect(&modelThread, &QThread::started, &model, &Model::start);
+    model.moveToThread(&modelThread);
+    model.setSimSpeed(limits.simSpeed);
+    modelThread.start();
+
+    // Images of the runs, if asked for, are rendered on this thread while the
+    // algorithm draws on the view, just like the map in the GUI
+    FrameRecorder* recorder = nullptr;
+    if (!exportDirectory.isEmpty()) {
+        if (QDir().mkpath(exportDirectory)) {
+            recorder = new FrameRecorder(
+                SettingsMisc::getExportWidth(),
+                SettingsMisc::getExportHeight());
+        }
+        else {
+            qWarning().noquote().nospace()
+                << "Unable to create the export directory \"" << exportDirectory
+                << "\"; the runs won't be exported.";
+        }
+    }
+
+    // The algorithm, which outlives its run if it's persistent. Its process is
+    // created on its own thread, which thus has to be stopped before the
+    // process can be cleaned up.
+    QThread* algoThread = nullptr;
+    MouseInterface* mouseInterface = nullptr;
+    QProcess* process = nullptr;
+    QStringList stderrBuffer;
+    QAtomicInt exitCode(-1);
+    QAtomicInt finished(0);
+    QAtomicInt waiting(0);
+    QAtomicInt started(0);
+    QString startError;
+    auto stopAlgoThread = [&](){
+        algoThread->quit();
+        mouseInterface->requestStop();
+        algoThread->wait();
+    };
+    auto destroyAlgo = [&](){
+        if (process != nullptr) {
+            process->terminate();
+            if (!process->waitForFinished(TERMINATE_TIMEOUT)) {
+                process->kill();
+                process->waitForFinished();
+            }
+        }
+        delete process;
+        delete mouseInterface;
+        delete algoThread;
+        process = nullptr;
+        mouseInterface = nullptr;
+        algoThread = nullptr;
+    };
+
+    // The mazes, mice and views of every run, which are only deleted once the
+    // algorithm can no longer refer to them
+    QVector<Maze*> mazes;
+    QVector<Mouse*> mice;
+    QVector<MazeView*> views;
+
+    int numComplete = 0;
+    for (const TournamentJob& job : jobs) {
+
+        TournamentResult result;
+        Maze* maze = Maze::fromFile(job.mazeFile);
+        if (maze == nullptr || !maze->isValidMaze()) {
+            result.error = "invalid maze";
+            printResult(result);
+            delete maze;
+            continue;
+        }
+        mazes.append(maze);
+        Mouse* mouse = new Mouse(maze);
+        mice.append(mouse);
+        if (!mouse->reload(SettingsMouseAlgos::getMouseFilePath(algoName))) {
+            result.error = "invalid mouse file";
+            printResult(result);
+            continue;
+        }
+
+        // A view of a maze of the same size can be cleared and reused
+        MazeView* view = views.isEmpty() ? nullptr : views.last();
+        if (view != nullptr && view->setMaze(maze)) {
+            view->reset();
+        }
+        else {
+            view = new MazeView(maze, false, false, false, false, false);
+            views.append(view);
+        }
+
+        MouseGraphic mouseGraphic(mouse);
+        QString exportName = QString("%1-%2-%3")
+            .arg(QFileInfo(job.mazeFile).completeBaseName())
+            .arg(algoName)
+            .arg(job.seed);
+        if (recorder != nullptr) {
+            recorder->setScene(maze, view, &mouseGraphic, LayoutType::FULL);
+            if (exportFrames) {
+                recorder->start(
+                    QDir(exportDirectory).filePath(exportName),
+                    Duration::Milliseconds(SettingsMisc::getExportFrameInterval()));
+            }
+        }
+
+        // A persistent algorithm may have exited while it was waiting
+        if (algoThread != nullptr && finished.loadAcquire() != 0) {
+            stopAlgoThread();
+            destroyAlgo();
+        }
+        model.removeMouse();
+        model.setMaze(maze);
+        waiting.storeRelease(0);
+        started.storeRelease(0);
+        if (algoThread != nullptr) {
+
+            // The algorithm is waiting for this run, so there's no need to
+            // start it again
+            QTimer::singleShot(0, mouseInterface, [&, maze, mouse, view, job](){
+                QString response = mouseInterface->beginRun(maze, mouse, view, job.seed);
+                model.setMouse(mouse);
+                started.storeRelease(1);
+                process->write((response + "\n").toUtf8());
+            });
+        }
+        else {
+            algoThread = new QThread();
+            mouseInterface = new MouseInterface(maze, mouse, view);
+            exitCode.storeRelease(-1);
+            finished.storeRelease(0);
+            startError.clear();
+            stderrBuffer.clear();
+            QObject::connect(algoThread, &QThread::started, mouseInterface, [&, mouse, job](){
+                process = new QProcess();
+                QObject::connect(
+                    process,
+                    &QProcess::readyReadStandardOutput,
+                    mouseInterface,
+                    [&](){
+                        mouseInterface->handleStandardOutput(process->readAllStandardOutput());
+                    }
+                );
+                QObject::connect(
+                    process,
+                    &QProcess::readyReadStandardError,
+                    mouseInterface,
+                    [&](){
+                        QString text = process->readAllStandardError();
+                        for (const QString& line : SimUtilities::getLines(text, &stderrBuffer)) {
+                            QString response = mouseInterface->dispatch(line);
+                            if (!response.isEmpty()) {
+                                process->write((response + "\n").toUtf8());
+                            }
+                        }
+                    }
+                );
+                QObject::connect(
+                    process,
+                    static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(
+                        &QProcess::finished
+                    ),
+                    mouseInterface,
+                    [&](int code, QProcess::ExitStatus status){
+                        exitCode.storeRelease(status == QProcess::NormalExit ? code : -1);
+                        finished.storeRelease(1);
+                    }
+                );
+                QObject::connect(mouseInterface, &MouseInterface::waitingForRun, [&](){
+                    waiting.storeRelease(1);
+                });
+                model.setMouse(mouse);
+                started.storeRelease(1);
+                QString command = SettingsMouseAlgos::getRunCommand(algoName);
+                command += " ";
+                command += QString::number(job.seed);
+                if (!ProcessUtilities::start(command, SettingsMouseAlgos::getDirPath(algoName), process)) {
+                    startError = process->errorString();
+                    finished.storeRelease(1);
+                }
+            });
+            mouseInterface->moveToThread(algoThread);
+            algoThread->start();
+        }
+
+        // The run is over once the algorithm exits or waits for the next run,
+        // the mouse crashes, or the sim time or the real time runs out
+        QElapsedTimer timer;
+        timer.start();
+        bool timedOut = false;
+        QEventLoop loop;
+        QTimer poll;
+        QObject::connect(&poll, &QTimer::timeout, [&](){
+            if (recorder != nullptr) {
+                recorder->captureFrame();
+            }
+            timedOut = limits.jobTimeout * 1000 < timer.elapsed();
+            if (timedOut || (
+                started.loadAcquire() != 0 && (
+                    finished.loadAcquire() != 0 ||
+                    waiting.loadAcquire() != 0 ||
+                    mouse->didCrash() ||
+                    !(SimTime::get()->elapsedSimTime() < Duration::Seconds(limits.simTimeLimit))
+                )
+            )) {
+                loop.quit();
+            }
+        });
+        poll.start(POLL_INTERVAL);
+        loop.exec();
+
+        // A persistent algorithm that's done with its run is idle until the
+        // next one begins, but any other algorithm has to be stopped before
+        // the model, so that no command is left waiting on the model to move
+        // the mouse
+        bool isWaiting = waiting.loadAcquire() != 0 && !timedOut;
+        if (!isWaiting) {
+            stopAlgoThread();
+        }
+        if (recorder != nullptr) {
+            recorder->stop();
+            recorder->exportImage(QDir(exportDirectory).filePath(exportName + ".png"));
+        }
+        MouseStats stats = model.getMouseStats();
+        bool exitedWithError = finished.loadAcquire() != 0 && exitCode.loadAcquire() != 0;
+        if (timedOut) {
+            result.status = "timeout";
+        }
+        else if (isWaiting || (startError.isEmpty() && !exitedWithError)) {
+            result.status = "complete";
+        }
+        else {
+            result.status = "failed";
+        }
+        result.bestTimeToCenter = stats.bestTimeToCenter.getSeconds();
+        result.explorationTime = stats.timeOfFirstCenterArrival.getSeconds();
+        result.distance = stats.distanceTraveled.getMeters();
+        result.crashed = mouse->didCrash();
+        result.simTime = SimTime::get()->elapsedSimTime().getSeconds();
+        result.tilesTraversed = stats.traversedTileLocations.size();
+        result.closestDistanceToCenter = stats.closestDistanceToCenter;
+        result.mazeHash = maze->getWalls().toWallGrid().hash();
+        result.commandCounts = mouseInterface->getCommandCounts();
+        result.error = startError;
+        printResult(result);
+        if (result.status == "complete") {
+            numComplete += 1;
+        }
+        if (!isWaiting) {
+            model.removeMouse();
+            destroyAlgo();
+        }
+    }
+
+    if (algoThread != nullptr) {
+        stopAlgoThread();
+        destroyAlgo();
+    }
+    model.removeMouse();
+    model.shutdown();
+    modelThread.quit();
+    modelThread.wait();
+    // Waits for the images that are still being written
+    delete recorder;
+    qDeleteAll(views);
+    qDeleteAll(mice);
+    qDeleteAll(mazes);
+    return numComplete == jobs.size() ? 0 : 1;
+}
+
+quint64 Tournament::getBuildHash(const QString& algoName) {
+    quint64 hash = SimUtilities::hashDirectory(SettingsMouseAlgos::getDirPath(algoName));
+    for (const QString& command : {
+        SettingsMouseAlgos::getBuildCommand(algoName),
+        SettingsMouseAlgos::getRunCommand(algoName),
+    }) {
+        hash = SimUtilities::hashBytes(command.toUtf8() + '\0', hash);
+    }
+    return hash;
+}
+
+QString Tournament::toCsv(
+        const QVector<TournamentJob>& jobs,
+        const QVector<TournamentResult>& results) {
+    QStringList lines;
+    lines.append(
+        "algorithm,maze,seed,status,best_time_to_center,exploration_time,"
+        "distance,crashed,sim_time,tiles_traversed,commands,error"
+    );
+    for (int i = 0; i < jobs.size(); i += 1) {
+        const TournamentJob& job = jobs.at(i);
+        const TournamentResult& result = results.at(i);
+        QString algoName = job.algoName;
+        QString mazeFile = job.mazeFile;
+        QString error = result.error;
+        for (QString* field : {&algoName, &mazeFile, &error}) {
+            field->replace("\"", "\"\"");
+        }
+        int numCommands = 0;
+        for (int count : result.commandCounts) {
+            numCommands += count;
+        }
+        lines.append(QStringList({
+            "\"" + algoName + "\"",
+            "\"" + mazeFile + "\"",
+            QString::number(job.seed),
+            result.status,
+            QString::number(result.bestTimeToCenter, 'f', 3),
+            QString::number(result.explorationTime, 'f', 3),
+            QString::number(result.distance, 'f', 3),
+            result.crashed ? "true" : "false",
+            QString::number(result.simTime, 'f', 3),
+            QString::number(result.tilesTraversed),
+            QString::number(numCommands),
+            "\"" + error + "\"",
+        }).join(","));
+    }
+    return lines.join("\n") + "\n";
+}
+
+void Tournament::addOptions(QCommandLineParser* parser) {
+    parser->addOptions({
+        {
+            "tournament",
+            "Run the mouse algorithm <name> (repeat for more) on the maze files in "
+            "<directories>, headlessly and on all cores, and write a table of the "
+            "results to --output, or stdout.",
+            "name",
+        },
+        {"seeds", "Run each --tournament pairing with <count> seeds (default 1).", "count", "1"},
+        {
+            "sim-speed",
+            "Run the --tournament at <factor> times real time (default 10).",
+            "factor",
+            "10",
+        },
+        {
+            "sim-time-limit",
+            "End each --tournament run after <seconds> of sim time (default 600).",
+            "seconds",
+            "600",
+        },
+        {
+            "job-timeout",
+            "Kill any --tournament run that takes over <seconds> of real time "
+            "(default 120).",
+            "seconds",
+            "120",
+        },
+        {
+            "build",
+            "Before the --tournament, build every algorithm whose directory or "
+            "build command changed since its last successful build, all at once.",
+        },
+        {"build-logs", "Write the output of each --build to <dir>/<name>.log.", "dir"},
+        {
+            "store",
+            "Append every --tournament run, with its maze, mouse, seed and "
+            "algorithm build, to the run store <file>, for --compare.",
+            "file",
+        },
+        {
+            "export-dir",
+            "Write an image of the map at the end of each --tournament run to "
+            "<dir>/<maze>-<name>-<seed>.png, at the export resolution of the "
+            "settings.",
+            "dir",
+        },
+        {
+            "export-frames",
+            "Also write the frames of each --tournament run, at the frame interval "
+            "of the settings, into <dir>/<maze>-<name>-<seed>, for --export-dir.",
+        },
+        {
+            "tournament-job",
+            "Perform the --tournament runs of <name> listed on stdin, without the "
+            "GUI; used by --tournament.",
+            "name",
+        },
+    });
+}
+
+int Tournament::runFromArguments(const QCommandLineParser& parser) {
+    TournamentLimits limits;
+    if (!readLimits(parser, &limits)) {
+        return 1;
+    }
+    if (parser.isSet("tournament-job")) {
+        return runJobs(
+            parser.value("tournament-job"),
+            limits,
+            parser.value("export-dir"),
+            parser.isSet("export-frames")
+        );
+    }
+    bool ok = false;
+    quint32 firstSeed = parser.value("first-seed").toUInt(&ok);
+    if (!ok) {
+        qWarning().noquote().nospace()
+            << "Invalid --first-seed \"" << parser.value("first-seed") << "\".";
+        return 1;
+    }
+    int numSeeds = parser.value("seeds").toInt(&ok);
+    if (!ok || numSeeds <= 0) {
+        qWarning().noquote().nospace()
+            << "Invalid --seeds \"" << parser.value("seeds") << "\".";
+        return 1;
+    }
+    if (parser.isSet("build")) {
+        int numFailed = AlgoBuilder::buildMouseAlgos(
+            parser.values("tournament"),
+            parser.value("build-logs")
+        );
+        if (numFailed != 0) {
+            return 1;
+        }
+    }
+    int count = run(
+        parser.values("tournament"),
+        parser.positionalArguments(),
+        firstSeed,
+        numSeeds,
+        limits,
+        parser.value("output"),
+        parser.value("store"),
+        parser.value("export-dir"),
+        parser.isSet("export-frames")
+    );
+    return count < 0 ? 1 : 0;
+}
+
+bool Tournament::readLimits(const QCommandLineParser& parser, TournamentLimits* limits) {
+    for (QPair<QString, double*> pair : {
+        qMakePair(QString("sim-speed"), &limits->simSpeed),
+        qMakePair(QString("sim-time-limit"), &limits->simTimeLimit),
+        qMakePair(QString("job-timeout"), &limits->jobTimeout),
+    }) {
+        bool ok = false;
+        *pair.second = parser.value(pair.first).toDouble(&ok);
+        if (!ok || *pair.second <= 0.0) {
+            qWarning().noquote().nospace()
+                << "Invalid --" << pair.first << " \""
+                << parser.value(pair.first) << "\".";
+            return false;
+        }
+    }
+    return true;
+}
+
+QStringList Tournament::getJobArguments(
+        const QString& algoName,
+        const TournamentLimits& limits,
+        const QString& exportDirectory,
+        bool exportFrames) {
+    QStringList arguments = {
+        "-platform", "offscreen",
+        "--tournament-job", algoName,
+        "--sim-speed", QString::number(limits.simSpeed),
+        "--sim-time-limit", QString::number(limits.simTimeLimit),
+        "--job-timeout", QString::number(limits.jobTimeout),
+    };
+    if (!exportDirectory.isEmpty()) {
+        arguments << "--export-dir" << QDir(exportDirectory).absolutePath();
+        if (exportFrames) {
+            arguments << "--export-frames";
+        }
+    }
+    return arguments;
+}
+
+QByteArray Tournament::getJobInput(const QVector<TournamentJob>& jobs) {
+    QByteArray input;
+    for (const TournamentJob& job : jobs) {
+        input += QString("%1 %2\n").arg(job.seed).arg(job.mazeFile).toUtf8();
+    }
+    return input;
+}
+
+QVector<TournamentResult> Tournament::readResults(const QByteArray& output) {
+
+    // The results are the lines with the prefix, in the order of the runs,
+    // since the rest of the output is the runs' log
+    QVector<TournamentResult> results;
+    for (const QString& line : SimUtilities::splitLines(QString::fromUtf8(output))) {
+        if (!line.startsWith(RESULT_PREFIX)) {
+            continue;
+        }
+        QJsonObject object = QJsonDocument::fromJson(
+            line.mid(RESULT_PREFIX.size()).toUtf8()).object();
+        TournamentResult result;
+        result.status = object.value("status").toString("error");
+        result.bestTimeToCenter = object.value("bestTimeToCenter").toDouble(-1.0);
+        result.explorationTime = object.value("explorationTime").toDouble(-1.0);
+        result.distance = object.value("distance").toDouble();
+        result.crashed = object.value("crashed").toBool();
+        result.simTime = object.value("simTime").toDouble();
+        result.tilesTraversed = object.value("tilesTraversed").toInt();
+        result.closestDistanceToCenter = object.value("closestDistanceToCenter").toInt(-1);
+        // JSON numbers are doubles, which can't hold every 64-bit hash
+        result.mazeHash = object.value("mazeHash").toString().toULongLong(nullptr, 16);
+        QJsonObject commandCounts = object.value("commandCounts").toObject();
+        for (auto it = commandCounts.constBegin(); it != commandCounts.constEnd(); it += 1) {
+            result.commandCounts.insert(it.key(), it.value().toInt());
+        }
+        result.error = object.value("error").toString();
+        results.append(result);
+    }
+    return results;
+}
+
+void Tournament::printResult(const TournamentResult& result) {
+    QJsonObject object;
+    object.insert("status", result.status);
+    object.insert("bestTimeToCenter", result.bestTimeToCenter);
+    object.insert("explorationTime", result.explorationTime);
+    object.insert("distance", result.distance);
+    object.insert("crashed", result.crashed);
+    object.insert("simTime", result.simTime);
+    object.insert("tilesTraversed", result.tilesTraversed);
+    object.insert("closestDistanceToCenter", result.closestDistanceToCenter);
+    object.insert("mazeHash", QString::number(result.mazeHash, 16));
+    QJsonObject commandCounts;
+    for (auto it = result.commandCounts.constBegin(); it != result.commandCounts.constEnd(); it += 1) {
+        commandCounts.insert(it.key(), it.value());
+    }
+    object.insert("commandCounts", commandCounts);
+    object.insert("error", result.error);
+    QTextStream(stdout)
+        << RESULT_PREFIX
+        << QJsonDocument(object).toJson(QJsonDocument::Compact)
+        << "\n";
+}
+
+} // namespace mms
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <QByteArray>
+#include <QCommandLineParser>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtGlobal>
+
+namespace mms {
+
+// One run of a tournament: a mouse algorithm on a maze, with a seed
+struct TournamentJob {
+    QString algoName;
+    QString mazeFile;
+    quint32 seed;
+};
+
+struct TournamentLimits {
+    TournamentLimits();
+    // Seconds of sim time per second of real time
+    double simSpeed;
+    // The seconds of sim time that each run gets
+    double simTimeLimit;
+    // The seconds of real time after which a run is killed
+    double jobTimeout;
+};
+
+// Times are in seconds of sim time, and -1 if the mouse never got there
+struct TournamentResult {
+    TournamentResult();
+    // "complete", "failed" (the algorithm exited with an error), "timeout",
+    // or "error" (the run couldn't be set up)
+    QString status;
+    double bestTimeToCenter;
+    // When the mouse first reached the center
+    double explorationTime;
+    // In meters
+    double distance;
+    bool crashed;
+    double simTime;
+    int tilesTraversed;
+    int closestDistanceToCenter;
+    // The hash of the walls of the maze, as oriented for the run
+    quint64 mazeHash;
+    // The number of times the algorithm sent each command
+    QMap<QString, int> commandCounts;
+    QString error;
+};
+
+// Runs every mouse algorithm on every maze with every seed, and tabulates the
+// results. Each batch of runs gets its own headless simulator process, since
+// the model and the sim time are per process.
+class Tournament {
+
+public:
+
+    Tournament() = delete;
+
+    // Runs the algorithms on the maze files in the directories, with the seeds
+    // [firstSeed, firstSeed + numSeeds), as many runs at once as there are
+    // cores. Writes the table of results as CSV to the file, or to stdout if
+    // the path is empty, and appends each result to the RunStore at the store
+    // path, if any. Returns the number of runs that completed, or -1 on
+    // failure. See runJobs() for the export directory.
+    static int run(
+        const QStringList& algoNames,
+        const QStringList& directories,
+        quint32 firstSeed,
+        int numSeeds,
+        const TournamentLimits& limits,
+        const QString& path,
+        const QString& storePath,
+        const QString& exportDirectory,
+        bool exportFrames);
+
+    // Performs the runs of the algorithm listed on stdin, one "<seed> <maze
+    // file>" per line, in this process and without the GUI, and prints each
+    // result to stdout for run() to read. An algorithm that sends waitForRun
+    // when it's done with a run is kept running, and given the next run in
+    // response, rather than being restarted. If the export directory isn't
+    // empty, an image of the map at the end of each run is written into it, as
+    // "<maze>-<algorithm>-<seed>.png", along with the frames of the run, in a
+    // directory of the same name, if asked for. Images are rendered at the
+    // export resolution of the settings. Returns 0 if every run completed.
+    static int runJobs(
+        const QString& algoName,
+        const TournamentLimits& limits,
+        const QString& exportDirectory,
+        bool exportFrames);
+
+    // Identifies a revision of an algorithm: a hash of the contents of its
+    // directory, after building, and of its build and run commands
+    static quint64 getBuildHash(const QString& algoName);
+
+    static QString toCsv(
+        const QVector<TournamentJob>& jobs,
+        const QVector<TournamentResult>& results);
+
+    // The options of --tournament and --tournament-job, and running either
+    // with them as parsed, which returns the exit code
+    static void addOptions(QCommandLineParser* parser);
+    static int runFromArguments(const QCommandLineParser& parser);
+
+private:
+
+    // Marks the line of a run's stdout that holds its result
+    static const QString RESULT_PREFIX;
+
+    // How often, in real milliseconds, a run checks whether it's done
+    static const int POLL_INTERVAL = 10;
+
+    // How long, in real milliseconds, an algorithm gets to exit when asked
+    static const int TERMINATE_TIMEOUT = 1000;
+
+    // The most runs that one process performs, and the fewest batches of runs
+    // per slot that run() aims for, so that the load stays balanced
+    static const int MAX_BATCH_SIZE = 16;
+    static const int BATCHES_PER_SLOT = 4;
+
+    // Reads the limits of the runs from the parsed options; returns false,
+    // after a warning, if any of them is invalid
+    static bool readLimits(const QCommandLineParser& parser, TournamentLimits* limits);
+
+    static QStringList getJobArguments(
+        const QString& algoName,
+        const TournamentLimits& limits,
+        const QString& exportDirectory,
+        bool exportFrames);
+    static QByteArray getJobInput(const QVector<TournamentJob>& jobs);
+    static QVector<TournamentResult> readResults(const QByteArray& output);
+    static void printResult(const TournamentResult& result);
+};
+
+} // namespace mms
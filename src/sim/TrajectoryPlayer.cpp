@@ -0,0 +1,63 @@
+#include "TrajectoryPlayer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Assert.h"
+#include "units/Distance.h"
+
+namespace mms {
+
+TrajectoryPlayer::TrajectoryPlayer(const QVector<TrajectorySample>& samples) :
+    m_samples(samples),
+    m_cursor(0) {
+    ASSERT_FA(m_samples.isEmpty());
+}
+
+QPair<Coordinate, Angle> TrajectoryPlayer::getPose(const Duration& simTime) {
+
+    double time = simTime.getMilliseconds();
+    int last = m_samples.size() - 1;
+
+    // Move the cursor to the last sample at or before the time
+    if (
+        time < m_samples.at(m_cursor).simTime ||
+        (m_cursor + 2 <= last && m_samples.at(m_cursor + 2).simTime <= time)
+    ) {
+        auto it = std::upper_bound(
+            m_samples.constBegin(),
+            m_samples.constEnd(),
+            time,
+            [](double t, const TrajectorySample& sample){
+                return t < sample.simTime;
+            }
+        );
+        m_cursor = std::max(0, static_cast<int>(it - m_samples.constBegin()) - 1);
+    }
+    else if (m_cursor < last && m_samples.at(m_cursor + 1).simTime <= time) {
+        m_cursor += 1;
+    }
+
+    const TrajectorySample& before = m_samples.at(m_cursor);
+    if (m_cursor == last || time <= before.simTime) {
+        return toPose(before.x, before.y, before.rotation);
+    }
+    const TrajectorySample& after = m_samples.at(m_cursor + 1);
+    double fraction = (time - before.simTime) / (after.simTime - before.simTime);
+
+    // The rotation turns the shorter way around
+    double turn = std::remainder(after.rotation - before.rotation, 2.0 * M_PI);
+    return toPose(
+        before.x + (after.x - before.x) * fraction,
+        before.y + (after.y - before.y) * fraction,
+        before.rotation + turn * fraction);
+}
+
+QPair<Coordinate, Angle> TrajectoryPlayer::toPose(double x, double y, double rotation) {
+    return {
+        Coordinate::Cartesian(Distance::Meters(x), Distance::Meters(y)),
+        Angle::Radians(rotation),
+    };
+}
+
+} // namespace mms
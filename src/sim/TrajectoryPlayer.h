@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QPair>
+#include <QVector>
+
+#include "TrajectoryRecorder.h"
+#include "units/Angle.h"
+#include "units/Coordinate.h"
+#include "units/Duration.h"
+
+namespace mms {
+
+// Plays back a recorded trajectory, e.g., as a ghost alongside a live run.
+// Poses between samples are interpolated rather than simulated, so playback
+// costs next to nothing.
+class TrajectoryPlayer {
+
+public:
+
+    explicit TrajectoryPlayer(const QVector<TrajectorySample>& samples);
+
+    // The pose at the sim time, between the samples around it. Before the
+    // first sample and after the last, the pose is that of the sample.
+    QPair<Coordinate, Angle> getPose(const Duration& simTime);
+
+private:
+
+    QVector<TrajectorySample> m_samples;
+
+    // The last sample at or before the previous time. Playing forward only
+    // moves it a sample or so per frame; any other jump is a binary search.
+    int m_cursor;
+
+    static QPair<Coordinate, Angle> toPose(double x, double y, double rotation);
+};
+
+} // namespace mms
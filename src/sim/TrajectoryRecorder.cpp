@@ -0,0 +1,165 @@
+#include "TrajectoryRecorder.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QSaveFile>
+
+#include <cmath>
+#include <cstring>
+
+#include "Assert.h"
+
+namespace mms {
+
+// The layout of a trajectory file, a little-endian QDataStream (Qt 5.6) with
+// single precision floats:
+//
+//   char[4]     magic, "MMST"
+//   quint32     version
+//   QString     mouse file
+//   quint64     maze hash
+//   quint32     number of samples
+//   sample, repeated
+//     qint32    sim time, in milliseconds
+//     float     x, y and rotation
+//     qint16    tile x and y
+
+const QString TrajectoryRecorder::SUFFIX = "mmst";
+const char TrajectoryRecorder::MAGIC[4] = {'M', 'M', 'S', 'T'};
+
+TrajectoryRecorder::TrajectoryRecorder(int capacity, int intervalMilliseconds) :
+    m_samples(capacity),
+    m_intervalMilliseconds(intervalMilliseconds),
+    m_next(0),
+    m_numRecorded(0),
+    m_nextSampleTime(0) {
+    ASSERT_LT(0, capacity);
+    ASSERT_LT(0, intervalMilliseconds);
+}
+
+void TrajectoryRecorder::start(const QString& mouseFile) {
+    m_mouseFile = mouseFile;
+    m_next = 0;
+    m_numRecorded = 0;
+    m_nextSampleTime = 0;
+}
+
+bool TrajectoryRecorder::isDue(const Duration& simTime) const {
+    return m_nextSampleTime <= simTime.getMilliseconds();
+}
+
+void TrajectoryRecorder::record(
+        const Duration& simTime,
+        const Coordinate& translation,
+        const Angle& rotation,
+        const QPair<int, int>& tile) {
+    qint32 milliseconds = static_cast<qint32>(std::lround(simTime.getMilliseconds()));
+    TrajectorySample& sample = m_samples[m_next];
+    sample.simTime = milliseconds;
+    sample.x = static_cast<float>(translation.getX().getMeters());
+    sample.y = static_cast<float>(translation.getY().getMeters());
+    sample.rotation = static_cast<float>(rotation.getRadiansZeroTo2pi());
+    sample.tileX = static_cast<qint16>(tile.first);
+    sample.tileY = static_cast<qint16>(tile.second);
+    m_next = (m_next + 1) % m_samples.size();
+    m_numRecorded += 1;
+    m_nextSampleTime = milliseconds + m_intervalMilliseconds;
+}
+
+Trajectory TrajectoryRecorder::getTrajectory() const {
+    Trajectory trajectory;
+    trajectory.mouseFile = m_mouseFile;
+    trajectory.mazeHash = 0;
+    if (m_numRecorded <= m_samples.size()) {
+        trajectory.samples = m_samples.mid(0, static_cast<int>(m_numRecorded));
+    }
+    else {
+        trajectory.samples = m_samples.mid(m_next) + m_samples.mid(0, m_next);
+    }
+    return trajectory;
+}
+
+bool TrajectoryRecorder::save(const QString& path, const Trajectory& trajectory) {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning().noquote().nospace()
+            << "Unable to write trajectory \"" << path << "\".";
+        return false;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream.writeRawData(MAGIC, sizeof(MAGIC));
+    stream
+        << VERSION
+        << trajectory.mouseFile
+        << trajectory.mazeHash
+        << static_cast<quint32>(trajectory.samples.size());
+    for (const TrajectorySample& sample : trajectory.samples) {
+        stream
+            << sample.simTime
+            << sample.x
+            << sample.y
+            << sample.rotation
+            << sample.tileX
+            << sample.tileY;
+    }
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        qWarning().noquote().nospace()
+            << "Unable to write trajectory \"" << path << "\".";
+        return false;
+    }
+    return true;
+}
+
+bool TrajectoryRecorder::load(const QString& path, Trajectory* trajectory) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning().noquote().nospace()
+            << "Unable to read trajectory \"" << path << "\".";
+        return false;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    char magic[sizeof(MAGIC)] = {};
+    quint32 version = 0;
+    stream.readRawData(magic, sizeof(magic));
+    stream >> version;
+    if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION) {
+        qWarning().noquote().nospace()
+            << "Unable to read trajectory \"" << path << "\": not a trajectory.";
+        return false;
+    }
+    quint32 numSamples = 0;
+    stream >> trajectory->mouseFile >> trajectory->mazeHash >> numSamples;
+
+    // Each sample is 20 bytes, so a bogus count can't make us allocate more
+    // than the file could hold
+    if (file.size() - file.pos() < static_cast<qint64>(numSamples) * 20) {
+        qWarning().noquote().nospace()
+            << "Unable to read trajectory \"" << path << "\": truncated.";
+        return false;
+    }
+    trajectory->samples.resize(numSamples);
+    for (TrajectorySample& sample : trajectory->samples) {
+        stream
+            >> sample.simTime
+            >> sample.x
+            >> sample.y
+            >> sample.rotation
+            >> sample.tileX
+            >> sample.tileY;
+    }
+    if (stream.status() != QDataStream::Ok) {
+        qWarning().noquote().nospace()
+            << "Unable to read trajectory \"" << path << "\": truncated.";
+        return false;
+    }
+    return true;
+}
+
+} // namespace mms
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+#include "units/Angle.h"
+#include "units/Coordinate.h"
+#include "units/Duration.h"
+
+namespace mms {
+
+// Where a mouse was at some point of a run. Kept small, since a run is many
+// thousands of these.
+struct TrajectorySample {
+    // Milliseconds of sim time since the start of the run
+    qint32 simTime;
+    // Meters
+    float x;
+    float y;
+    // Radians, counterclockwise from the positive x axis
+    float rotation;
+    // The tile of the mouse, see Mouse::getCurrentDiscretizedTranslation()
+    qint16 tileX;
+    qint16 tileY;
+};
+
+// A recorded run of a mouse, oldest sample first
+struct Trajectory {
+    QString mouseFile;
+    // See WallGrid::hash(), or 0 if unknown
+    quint64 mazeHash;
+    QVector<TrajectorySample> samples;
+};
+
+// Records the trajectory of a mouse from the model's update loop. All of the
+// memory is allocated up front, and a step costs a comparison, plus copying
+// the pose once per interval, so that recording doesn't slow the model down.
+// When the buffer is full, the oldest samples are overwritten.
+class TrajectoryRecorder {
+
+public:
+
+    // The suffix of trajectory files
+    static const QString SUFFIX;
+
+    TrajectoryRecorder(int capacity, int intervalMilliseconds);
+
+    // Discards the samples, for a new run of a mouse with the given file
+    void start(const QString& mouseFile);
+
+    // Whether a sample is due at the sim time
+    bool isDue(const Duration& simTime) const;
+
+    void record(
+        const Duration& simTime,
+        const Coordinate& translation,
+        const Angle& rotation,
+        const QPair<int, int>& tile);
+
+    Trajectory getTrajectory() const;
+
+    // Writes or reads a trajectory file. Both return false, and log why, on
+    // failure.
+    static bool save(const QString& path, const Trajectory& trajectory);
+    static bool load(const QString& path, Trajectory* trajectory);
+
+private:
+
+    // See TrajectoryRecorder.cpp for the layout of the file
+    static const char MAGIC[4];
+    static const quint32 VERSION = 1;
+
+    QVector<TrajectorySample> m_samples;
+    int m_intervalMilliseconds;
+    QString m_mouseFile;
+
+    // The index of the next sample to write, and the number of samples
+    // written, which may be more than the capacity
+    int m_next;
+    qint64 m_numRecorded;
+    qint32 m_nextSampleTime;
+};
+
+} // namespace mms
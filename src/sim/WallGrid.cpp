@@ -0,0 +1,111 @@
+#include "WallGrid.h"
+
+#include <algorithm>
+
+#include "Assert.h"
+
+namespace mms {
+
+WallGrid::WallGrid() : WallGrid(0, 0) {
+}
+
+WallGrid::WallGrid(int width, int height) :
+        m_width(width),
+        m_height(height) {
+    ASSERT_LE(0, width);
+    ASSERT_LE(0, height);
+    m_words.fill(0, (width * height + TILES_PER_WORD - 1) / TILES_PER_WORD);
+}
+
+WallGrid WallGrid::fromWords(int width, int height, const quint64* words) {
+    WallGrid grid(width, height);
+    std::copy(words, words + grid.m_words.size(), grid.m_words.begin());
+    return grid;
+}
+
+int WallGrid::getNumWords() const {
+    return m_words.size();
+}
+
+const quint64* WallGrid::getWords() const {
+    return m_words.constData();
+}
+
+quint64 WallGrid::hash() const {
+    // 64-bit FNV-1a over the dimensions and the packed words
+    quint64 hash = 14695981039346656037ULL;
+    auto mix = [&hash](quint64 value) {
+        for (int i = 0; i < 8; i += 1) {
+            hash ^= (value >> (8 * i)) & 0xff;
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(static_cast<quint64>(m_width));
+    mix(static_cast<quint64>(m_height));
+    for (quint64 word : m_words) {
+        mix(word);
+    }
+    return hash;
+}
+
+int WallGrid::getWidth() const {
+    return m_width;
+}
+
+int WallGrid::getHeight() const {
+    return m_height;
+}
+
+bool WallGrid::withinGrid(int x, int y) const {
+    return 0 <= x && x < m_width && 0 <= y && y < m_height;
+}
+
+bool WallGrid::isWall(int x, int y, Direction direction) const {
+    return (getWalls(x, y) & directionBit(direction)) != 0;
+}
+
+void WallGrid::setWall(int x, int y, Direction direction, bool isWall) {
+    quint8 walls = getWalls(x, y);
+    if (isWall) {
+        walls |= directionBit(direction);
+    }
+    else {
+        walls &= ~directionBit(direction);
+    }
+    setWalls(x, y, walls);
+}
+
+quint8 WallGrid::getWalls(int x, int y) const {
+    ASSERT_TR(withinGrid(x, y));
+    int index = y * m_width + x;
+    int shift = (index % TILES_PER_WORD) * BITS_PER_TILE;
+    return static_cast<quint8>(
+        (m_words.at(index / TILES_PER_WORD) >> shift) & TILE_MASK);
+}
+
+void WallGrid::setWalls(int x, int y, quint8 walls) {
+    ASSERT_TR(withinGrid(x, y));
+    int index = y * m_width + x;
+    int shift = (index % TILES_PER_WORD) * BITS_PER_TILE;
+    quint64& word = m_words[index / TILES_PER_WORD];
+    word &= ~(TILE_MASK << shift);
+    word |= (static_cast<quint64>(walls) & TILE_MASK) << shift;
+}
+
+quint8 WallGrid::directionBit(Direction direction) {
+    return static_cast<quint8>(1 << static_cast<int>(direction));
+}
+
+bool WallGrid::operator==(const WallGrid& other) const {
+    return (
+        m_width == other.m_width &&
+        m_height == other.m_height &&
+        m_words == other.m_words
+    );
+}
+
+bool WallGrid::operator!=(const WallGrid& other) const {
+    return !(*this == other);
+}
+
+} // namespace mms
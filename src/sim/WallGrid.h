@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QVector>
+#include <QtGlobal>
+
+#include "Direction.h"
+
+namespace mms {
+
+// A flat, bit-packed store of the walls of a maze. Each tile gets four bits,
+// one per direction (in the order of DIRECTIONS()), and the tiles are laid
+// out in row-major order, sixteen to a word. A 16x16 maze fits in 128 bytes.
+//
+// NOTE: Walls are stored per tile rather than per shared edge so that mazes
+// with inconsistent walls (which MazeChecker reports) are represented exactly.
+class WallGrid {
+
+public:
+
+    WallGrid();
+    WallGrid(int width, int height);
+
+    // Constructs a grid directly from packed words, as returned by getWords()
+    static WallGrid fromWords(int width, int height, const quint64* words);
+
+    // The packed words, sixteen tiles to a word
+    int getNumWords() const;
+    const quint64* getWords() const;
+
+    // A hash of the dimensions and walls, for telling mazes apart
+    quint64 hash() const;
+
+    int getWidth() const;
+    int getHeight() const;
+    bool withinGrid(int x, int y) const;
+
+    bool isWall(int x, int y, Direction direction) const;
+    void setWall(int x, int y, Direction direction, bool isWall);
+
+    // All four walls of a tile, as a mask of directionBit() values
+    quint8 getWalls(int x, int y) const;
+    void setWalls(int x, int y, quint8 walls);
+
+    // The bit of a tile's wall mask that corresponds to the direction
+    static quint8 directionBit(Direction direction);
+
+    bool operator==(const WallGrid& other) const;
+    bool operator!=(const WallGrid& other) const;
+
+private:
+
+    static const int BITS_PER_TILE = 4;
+    static const int TILES_PER_WORD = 64 / BITS_PER_TILE;
+    static const quint64 TILE_MASK = (1 << BITS_PER_TILE) - 1;
+
+    int m_width;
+    int m_height;
+    QVector<quint64> m_words;
+};
+
+} // namespace mms
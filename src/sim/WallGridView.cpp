@@ -0,0 +1,148 @@
+#include "WallGridView.h"
+
+#include <utility>
+
+#include "Assert.h"
+#include "MazeSymmetry.h"
+
+namespace mms {
+
+WallGridView::WallGridView() : WallGridView(WallGrid()) {
+}
+
+WallGridView::WallGridView(const WallGrid& grid, int symmetry) :
+        m_grid(grid),
+        m_symmetry(symmetry) {
+
+    ASSERT_LE(0, symmetry);
+    ASSERT_LT(symmetry, MazeSymmetry::NUM_SYMMETRIES);
+    int rotations = symmetry % 4;
+    bool mirrored = 4 <= symmetry;
+
+    m_width = rotations % 2 == 0 ? grid.getWidth() : grid.getHeight();
+    m_height = rotations % 2 == 0 ? grid.getHeight() : grid.getWidth();
+
+    // The view is the grid mirrored, then rotated counter-clockwise; undo
+    // those steps in reverse, starting from the identity on view coordinates
+    int x0 = 0, xPerX = 1, xPerY = 0;
+    int y0 = 0, yPerX = 0, yPerY = 1;
+    int width = m_width;
+    int height = m_height;
+    for (Direction direction : DIRECTIONS()) {
+        m_gridDirections[static_cast<int>(direction)] = direction;
+    }
+    for (int i = 0; i < rotations; i += 1) {
+        // Tile (x, y) of a rotated grid came from tile (y, width - 1 - x),
+        // and its north wall was the east wall
+        int newX0 = y0, newXPerX = yPerX, newXPerY = yPerY;
+        y0 = width - 1 - x0;
+        yPerX = -xPerX;
+        yPerY = -xPerY;
+        x0 = newX0;
+        xPerX = newXPerX;
+        xPerY = newXPerY;
+        std::swap(width, height);
+        for (Direction& direction : m_gridDirections) {
+            direction = DIRECTION_ROTATE_RIGHT().value(direction);
+        }
+    }
+    if (mirrored) {
+        x0 = width - 1 - x0;
+        xPerX = -xPerX;
+        xPerY = -xPerY;
+        for (Direction& direction : m_gridDirections) {
+            if (direction == Direction::EAST || direction == Direction::WEST) {
+                direction = DIRECTION_OPPOSITE().value(direction);
+            }
+        }
+    }
+    m_gridX0 = x0;
+    m_gridXPerX = xPerX;
+    m_gridXPerY = xPerY;
+    m_gridY0 = y0;
+    m_gridYPerX = yPerX;
+    m_gridYPerY = yPerY;
+
+    for (int gridWalls = 0; gridWalls < 16; gridWalls += 1) {
+        quint8 viewWalls = 0;
+        for (Direction direction : DIRECTIONS()) {
+            Direction gridDirection = m_gridDirections[static_cast<int>(direction)];
+            if (gridWalls & WallGrid::directionBit(gridDirection)) {
+                viewWalls |= WallGrid::directionBit(direction);
+            }
+        }
+        m_viewWalls[gridWalls] = viewWalls;
+    }
+}
+
+WallGridView WallGridView::transformed(int symmetry) const {
+    return WallGridView(m_grid, MazeSymmetry::compose(m_symmetry, symmetry));
+}
+
+const WallGrid& WallGridView::getGrid() const {
+    return m_grid;
+}
+
+int WallGridView::getSymmetry() const {
+    return m_symmetry;
+}
+
+int WallGridView::getWidth() const {
+    return m_width;
+}
+
+int WallGridView::getHeight() const {
+    return m_height;
+}
+
+bool WallGridView::withinGrid(int x, int y) const {
+    return 0 <= x && x < m_width && 0 <= y && y < m_height;
+}
+
+bool WallGridView::isWall(int x, int y, Direction direction) const {
+    if (m_symmetry == 0) {
+        return m_grid.isWall(x, y, direction);
+    }
+    int gridX, gridY;
+    toGrid(x, y, &gridX, &gridY);
+    return m_grid.isWall(gridX, gridY, m_gridDirections[static_cast<int>(direction)]);
+}
+
+quint8 WallGridView::getWalls(int x, int y) const {
+    if (m_symmetry == 0) {
+        return m_grid.getWalls(x, y);
+    }
+    int gridX, gridY;
+    toGrid(x, y, &gridX, &gridY);
+    return m_viewWalls[m_grid.getWalls(gridX, gridY)];
+}
+
+void WallGridView::setWall(int x, int y, Direction direction, bool isWall) {
+    if (m_symmetry == 0) {
+        m_grid.setWall(x, y, direction, isWall);
+        return;
+    }
+    int gridX, gridY;
+    toGrid(x, y, &gridX, &gridY);
+    m_grid.setWall(gridX, gridY, m_gridDirections[static_cast<int>(direction)], isWall);
+}
+
+WallGrid WallGridView::toWallGrid() const {
+    if (m_symmetry == 0) {
+        return m_grid;
+    }
+    WallGrid grid(m_width, m_height);
+    for (int y = 0; y < m_height; y += 1) {
+        for (int x = 0; x < m_width; x += 1) {
+            grid.setWalls(x, y, getWalls(x, y));
+        }
+    }
+    return grid;
+}
+
+void WallGridView::toGrid(int x, int y, int* gridX, int* gridY) const {
+    *gridX = m_gridX0 + m_gridXPerX * x + m_gridXPerY * y;
+    *gridY = m_gridY0 + m_gridYPerX * x + m_gridYPerY * y;
+}
+
+} // namespace mms
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include "Direction.h"
+#include "WallGrid.h"
+
+namespace mms {
+
+// A view of a WallGrid under one of the eight symmetries of MazeSymmetry.
+// The view shares the grid's storage (WallGrid is implicitly shared) and
+// remaps coordinates and directions on access, so that rotating or mirroring
+// a maze doesn't copy its walls. Writing through a view only copies the
+// walls if they're still shared, just like writing to the grid itself.
+class WallGridView {
+
+public:
+
+    WallGridView();
+
+    // Not explicit, so that a WallGrid can be passed wherever a view is
+    // expected; such a view is the identity
+    WallGridView(const WallGrid& grid, int symmetry = 0);
+
+    // The view of the same grid under this view's symmetry followed by the
+    // given one
+    WallGridView transformed(int symmetry) const;
+
+    const WallGrid& getGrid() const;
+    int getSymmetry() const;
+
+    int getWidth() const;
+    int getHeight() const;
+    bool withinGrid(int x, int y) const;
+
+    bool isWall(int x, int y, Direction direction) const;
+    quint8 getWalls(int x, int y) const;
+    void setWall(int x, int y, Direction direction, bool isWall);
+
+    // Materializes the view, e.g., for saving or hashing
+    WallGrid toWallGrid() const;
+
+private:
+
+    WallGrid m_grid;
+    int m_symmetry;
+    int m_width;
+    int m_height;
+
+    // The grid coordinates of view tile (x, y) are an affine function of x
+    // and y, e.g., gridX = m_gridX0 + m_gridXPerX * x + m_gridXPerY * y
+    int m_gridX0;
+    int m_gridXPerX;
+    int m_gridXPerY;
+    int m_gridY0;
+    int m_gridYPerX;
+    int m_gridYPerY;
+
+    // The grid direction of each view direction, and the view wall mask of
+    // each grid wall mask
+    Direction m_gridDirections[4];
+    quint8 m_viewWalls[16];
+
+    void toGrid(int x, int y, int* gridX, int* gridY) const;
+};
+
+} // namespace mms
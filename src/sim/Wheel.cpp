@@ -120,6 +120,16 @@ void Wheel::resetRelativeEncoder() {
     m_relativeRotation = Angle::Radians(0);
 }
 
+WheelState Wheel::getState() const {
+    return {m_currentSpeed, m_absoluteRotation, m_relativeRotation};
+}
+
+void Wheel::setState(const WheelState& state) {
+    m_currentSpeed = state.speed;
+    m_absoluteRotation = state.absoluteRotation;
+    m_relativeRotation = state.relativeRotation;
+}
+
 WheelEffect Wheel::getEffect(const AngularVelocity& speed) const {
     return {
         m_unitForwardEffect * speed.getRadiansPerSecond(),
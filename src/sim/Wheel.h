@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EncoderType.h"
+#include "MouseState.h"
 #include "Polygon.h"
 #include "WheelEffect.h"
 
@@ -44,6 +45,10 @@ public:
     int readRelativeEncoder() const;
     void resetRelativeEncoder();
 
+    // The speed and encoder readings, see MouseState
+    WheelState getState() const;
+    void setState(const WheelState& state);
+
 private:
 
     // Wheel
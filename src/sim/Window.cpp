@@ -1,6 +1,7 @@
 #include "Window.h"
 
 #include <QAction>
+#include <QApplication>
 #include <QFileDialog>
 #include <QFrame>
 #include <QGroupBox>
@@ -14,9 +15,16 @@
 #include <QTimer>
 #include <QVBoxLayout>
 
+#include "AlgoBuilder.h"
 #include "ColorManager.h"
 #include "ConfigDialog.h"
+#include "FrameRecorder.h"
+#include "Instrumentation.h"
+#include "MazeAnalyzer.h"
+#include "MazeCorpus.h"
+#include "MazeFileUtilities.h"
 #include "MazeFilesTab.h"
+#include "MazeSymmetry.h"
 #include "Model.h"
 #include "Param.h"
 #include "ProcessUtilities.h"
@@ -37,6 +45,13 @@ Window::Window(QWidget *parent) :
         m_mazeDirLabel(new QLabel()),
         m_isValidLabel(new QLabel()),
         m_isOfficialLabel(new QLabel()),
+        m_shortestPathLabel(new QLabel()),
+        m_optimalTurnsLabel(new QLabel()),
+        m_deadEndsLabel(new QLabel()),
+        m_branchFactorLabel(new QLabel()),
+        m_straightawayLabel(new QLabel()),
+        m_wallFollowerLabel(new QLabel()),
+        m_runTimeLabel(new QLabel()),
         m_truthButton(new QRadioButton("Truth")),
         m_viewButton(new QRadioButton("Mouse")),
         m_distancesCheckbox(new QCheckBox("Distance")),
@@ -51,6 +66,7 @@ Window::Window(QWidget *parent) :
         m_mouseGraphic(nullptr),
         m_view(nullptr),
         m_mouseInterface(nullptr),
+        m_frameRecorder(nullptr),
         m_mouseAlgoThread(nullptr),
 
         // MazeAlgosTab
@@ -69,6 +85,7 @@ Window::Window(QWidget *parent) :
         m_mazeAlgoWidthBox(new QSpinBox()),
         m_mazeAlgoHeightBox(new QSpinBox()),
         m_mazeAlgoSeedWidget(new RandomSeedWidget()),
+        m_mazeAlgoBinaryOutputCheckbox(new QCheckBox("Binary Output")),
 
         // MouseAlgosTab
         m_mouseAlgoWidget(new QWidget()),
@@ -85,12 +102,30 @@ Window::Window(QWidget *parent) :
         m_mouseAlgoRunOutput(new QPlainTextEdit()),
         m_mouseAlgoStatsWidget(new MouseAlgoStatsWidget()),
         m_mouseAlgoSeedWidget(new RandomSeedWidget()),
-        m_mouseAlgoPauseButton(new QPushButton("Pause")) {
+        m_mouseAlgoPauseButton(new QPushButton("Pause")),
+        m_mouseAlgoRivalComboBox(new QComboBox()),
+        m_mouseAlgoRivalOutput(new QPlainTextEdit()),
+        m_rivalMouse(nullptr),
+        m_rivalMouseGraphic(nullptr),
+        m_rivalView(nullptr),
+        m_rivalMouseInterface(nullptr),
+        m_rivalMouseAlgoThread(nullptr),
+        m_ghostMouse(nullptr),
+        m_ghostMouseGraphic(nullptr),
+        m_ghostPlayer(nullptr),
+        m_rewindSlider(new QSlider(Qt::Horizontal)),
+        m_rewindLabel(new QLabel()),
+        m_rewindMouse(nullptr),
+        m_rewindView(nullptr),
+        m_rewindMouseGraphic(nullptr) {
 
     // First, some bookkeeping; we have to explicitly allow the
     // mouse process exit event to be handled on the GUI thread
     qRegisterMetaType<QProcess::ExitStatus>("QProcess::ExitStatus");
 
+    // Keep the trajectory of each run, so that it can be saved as a ghost
+    m_model.setTrajectoryRecording(true);
+
     // Next, start the physics loop
     connect(&m_modelThread, &QThread::started, &m_model, &Model::start);
     m_model.moveToThread(&m_modelThread);
@@ -119,6 +154,13 @@ Window::Window(QWidget *parent) :
         {"Start", m_mazeDirLabel},
         {"Valid", m_isValidLabel},
         {"Official", m_isOfficialLabel},
+        {"Path", m_shortestPathLabel},
+        {"Turns", m_optimalTurnsLabel},
+        {"Dead Ends", m_deadEndsLabel},
+        {"Branch", m_branchFactorLabel},
+        {"Straight", m_straightawayLabel},
+        {"Follower", m_wallFollowerLabel},
+        {"Run", m_runTimeLabel},
     }) {
         pair.second->setAlignment(Qt::AlignCenter);   
         pair.second->setFrameStyle(QFrame::StyledPanel | QFrame::Plain);
@@ -149,7 +191,10 @@ Window::Window(QWidget *parent) :
 
     // Add functionality to those map buttons
     connect(m_viewButton, &QRadioButton::toggled, this, [=](bool checked){
-        m_map.setView(checked ? m_view : m_truth);
+        // A rewound map keeps showing the checkpoint
+        if (m_rewindView == nullptr) {
+            m_map.setView(checked ? m_view : m_truth);
+        }
         m_distancesCheckbox->setEnabled(!checked);
         m_wallTruthCheckbox->setEnabled(checked);
         m_colorCheckbox->setEnabled(checked);
@@ -162,23 +207,32 @@ Window::Window(QWidget *parent) :
         }
     });
     connect(m_wallTruthCheckbox, &QCheckBox::stateChanged, this, [=](int state){
-        if (m_view != nullptr) {
-            m_view->getMazeGraphic()->setWallTruthVisible(state == Qt::Checked);
+        for (MazeView* view : {m_view, m_rewindView}) {
+            if (view != nullptr) {
+                view->getMazeGraphic()->setWallTruthVisible(state == Qt::Checked);
+            }
         }
+        m_map.invalidateStaticLayers();
     });
     connect(m_colorCheckbox, &QCheckBox::stateChanged, this, [=](int state){
-        if (m_view != nullptr) {
-            m_view->getMazeGraphic()->setTileColorsVisible(state == Qt::Checked);
+        for (MazeView* view : {m_view, m_rewindView}) {
+            if (view != nullptr) {
+                view->getMazeGraphic()->setTileColorsVisible(state == Qt::Checked);
+            }
         }
     });
     connect(m_fogCheckbox, &QCheckBox::stateChanged, this, [=](int state){
-        if (m_view != nullptr) {
-            m_view->getMazeGraphic()->setTileFogVisible(state == Qt::Checked);
+        for (MazeView* view : {m_view, m_rewindView}) {
+            if (view != nullptr) {
+                view->getMazeGraphic()->setTileFogVisible(state == Qt::Checked);
+            }
         }
     });
     connect(m_textCheckbox, &QCheckBox::stateChanged, this, [=](int state){
-        if (m_view != nullptr) {
-            m_view->getMazeGraphic()->setTileTextVisible(state == Qt::Checked);
+        for (MazeView* view : {m_view, m_rewindView}) {
+            if (view != nullptr) {
+                view->getMazeGraphic()->setTileTextVisible(state == Qt::Checked);
+            }
         }
     });
     connect(m_followCheckbox, &QCheckBox::stateChanged, this, [=](int state){
@@ -221,6 +275,19 @@ Window::Window(QWidget *parent) :
             }
         }
     );
+    connect(
+        mazeFilesTab, &MazeFilesTab::corpusEntryChanged,
+        this, [=](const QString& path, int index){
+            MazeCorpus* corpus = MazeCorpus::open(path);
+            if (corpus == nullptr) {
+                return;
+            }
+            if (index < corpus->size()) {
+                setMaze(Maze::fromWallGrid(corpus->getWallGrid(index)));
+            }
+            delete corpus;
+        }
+    );
     tabWidget->addTab(mazeFilesTab, "Maze Files");
 
     // Create the maze algos tab
@@ -244,6 +311,75 @@ Window::Window(QWidget *parent) :
     connect(quitAction, &QAction::triggered, this, &Window::close);
     fileMenu->addAction(quitAction);
 
+    // Export an image of the map
+    QAction* exportImageAction = new QAction(tr("&Export Map Image ..."), this);
+    connect(exportImageAction, &QAction::triggered, this, [=](){
+        QString path = QFileDialog::getSaveFileName(
+            this,
+            tr("Export Map Image"),
+            "",
+            tr("Images (*.png)")
+        );
+        if (path.isEmpty()) {
+            return;
+        }
+        updateFrameRecorderScene();
+        getFrameRecorder()->exportImage(path);
+    });
+    fileMenu->addAction(exportImageAction);
+
+    // Record a sequence of frames of the map
+    QAction* recordFramesAction = new QAction(tr("&Record Frames ..."), this);
+    recordFramesAction->setCheckable(true);
+    connect(recordFramesAction, &QAction::toggled, this, [=](bool checked){
+        if (!checked) {
+            getFrameRecorder()->stop();
+            return;
+        }
+        QString directory = QFileDialog::getExistingDirectory(
+            this,
+            tr("Record Frames Into Directory")
+        );
+        if (directory.isEmpty()) {
+            recordFramesAction->setChecked(false);
+            return;
+        }
+        updateFrameRecorderScene();
+        getFrameRecorder()->start(
+            directory,
+            Duration::Milliseconds(SettingsMisc::getExportFrameInterval()));
+    });
+    fileMenu->addAction(recordFramesAction);
+
+    // Save the trajectory of the latest run, and play back saved ones
+    QAction* saveTrajectoryAction = new QAction(tr("Save Run &Trajectory ..."), this);
+    connect(saveTrajectoryAction, &QAction::triggered, this, &Window::saveTrajectory);
+    fileMenu->addAction(saveTrajectoryAction);
+    QAction* loadGhostAction = new QAction(tr("Load &Ghost ..."), this);
+    connect(loadGhostAction, &QAction::triggered, this, &Window::loadGhost);
+    fileMenu->addAction(loadGhostAction);
+    QAction* clearGhostAction = new QAction(tr("&Clear Ghost"), this);
+    connect(clearGhostAction, &QAction::triggered, this, &Window::clearGhost);
+    fileMenu->addAction(clearGhostAction);
+
+    // Rotate and mirror the maze
+    QMenu* mazeMenu = menuBar()->addMenu(tr("Ma&ze"));
+    QAction* rotateCounterClockwiseAction = new QAction(tr("Rotate &Counter-Clockwise"), this);
+    connect(rotateCounterClockwiseAction, &QAction::triggered, this, [=](){
+        transformMaze(MazeSymmetry::fromMirrorAndRotations(false, 1));
+    });
+    mazeMenu->addAction(rotateCounterClockwiseAction);
+    QAction* rotateClockwiseAction = new QAction(tr("Rotate C&lockwise"), this);
+    connect(rotateClockwiseAction, &QAction::triggered, this, [=](){
+        transformMaze(MazeSymmetry::fromMirrorAndRotations(false, 3));
+    });
+    mazeMenu->addAction(rotateClockwiseAction);
+    QAction* mirrorAction = new QAction(tr("&Mirror Across Vertical"), this);
+    connect(mirrorAction, &QAction::triggered, this, [=](){
+        transformMaze(MazeSymmetry::fromMirrorAndRotations(true, 0));
+    });
+    mazeMenu->addAction(mirrorAction);
+
     // Save the maze
     // TODO: MACK - select the maze type here...
     /*
@@ -321,7 +457,17 @@ Window::Window(QWidget *parent) :
             if (now - then < secondsPerFrame) {
                 return;
             }
+            if (m_ghostPlayer != nullptr) {
+                QPair<Coordinate, Angle> pose =
+                    m_ghostPlayer->getPose(SimTime::get()->elapsedSimTime());
+                m_ghostMouse->teleport(pose.first, pose.second);
+            }
+            updateRewindSlider();
             m_map.update();
+            if (m_frameRecorder != nullptr && m_frameRecorder->isRecording()) {
+                updateFrameRecorderScene();
+                m_frameRecorder->captureFrame();
+            }
             then = now;
         }
     );
@@ -366,6 +512,8 @@ void Window::closeEvent(QCloseEvent *event) {
     mazeAlgoRunStop();
     mouseAlgoBuildStop();
     mouseAlgoRunStop();
+    delete m_frameRecorder;
+    m_frameRecorder = nullptr;
     m_map.shutdown();
     m_model.shutdown();
     m_modelThread.quit();
@@ -379,6 +527,10 @@ void Window::setMaze(Maze* maze) {
     mazeAlgoRunStop();
     mouseAlgoRunStop();
 
+    // The ghost and the checkpoints are of the old maze
+    clearGhost();
+    m_checkpoints.clear();
+
     // Next, update the maze and truth
     Maze* oldMaze = m_maze;
     MazeView* oldTruth = m_truth;
@@ -396,8 +548,45 @@ void Window::setMaze(Maze* maze) {
     m_model.setMaze(m_maze);
     m_map.setMaze(m_maze);
     m_map.setView(m_truth);
+    updateMazeStats();
+
+    // Delete the old objects
+    delete oldMaze;
+    delete oldTruth;
+}
 
-    // Update maze stats UI widgets
+void Window::transformMaze(int symmetry) {
+
+    if (m_maze == nullptr) {
+        return;
+    }
+
+    // Stop running maze/mouse algos, which refer to the old maze
+    mazeAlgoRunStop();
+    mouseAlgoRunStop();
+    clearGhost();
+    m_checkpoints.clear();
+    Maze* maze = m_maze->transformed(symmetry);
+
+    // If the dimensions changed, the geometry has to be rebuilt anyways
+    if (!m_truth->setMaze(maze)) {
+        setMaze(maze);
+        return;
+    }
+
+    // Otherwise the truth view was rebound in place, and only the walls and
+    // distances were rewritten
+    Maze* oldMaze = m_maze;
+    m_maze = maze;
+    m_model.setMaze(m_maze);
+    m_map.setMaze(m_maze);
+    m_map.setView(m_truth);
+    m_map.invalidateStaticLayers();
+    updateMazeStats();
+    delete oldMaze;
+}
+
+void Window::updateMazeStats() {
     m_mazeWidthLabel->setText(QString::number(m_maze->getWidth()));
     m_mazeHeightLabel->setText(QString::number(m_maze->getHeight()));
     m_maxDistanceLabel->setText(
@@ -408,10 +597,59 @@ void Window::setMaze(Maze* maze) {
     );
     m_isValidLabel->setText(m_maze->isValidMaze() ? "TRUE" : "FALSE");
     m_isOfficialLabel->setText(m_maze->isOfficialMaze() ? "TRUE" : "FALSE");
+    QStringList issues;
+    for (const MazeCheckIssue& issue : m_maze->getCheckIssues()) {
+        issues.append(MazeChecker::describe(issue));
+    }
+    m_isValidLabel->setToolTip(issues.join("\n"));
+    m_isOfficialLabel->setToolTip(issues.join("\n"));
 
-    // Delete the old objects
-    delete oldMaze;
-    delete oldTruth;
+    // The run time is estimated for the mouse of the selected mouse algo
+    MouseSpeeds speeds;
+    QString algoName = m_mouseAlgoComboBox->currentText();
+    QString mouseFile = algoName.isEmpty() ? "" : getMouseFile(algoName);
+    bool hasSpeeds = (
+        !mouseFile.isEmpty() &&
+        MazeAnalyzer::getMouseSpeeds(mouseFile, &speeds)
+    );
+    MazeMetrics metrics = MazeAnalyzer::analyze(*m_maze, hasSpeeds ? &speeds : nullptr);
+    m_shortestPathLabel->setText(QString::number(metrics.shortestPath));
+    m_optimalTurnsLabel->setText(QString::number(metrics.optimalTurns));
+    m_deadEndsLabel->setText(QString::number(metrics.deadEnds));
+    m_branchFactorLabel->setText(QString::number(metrics.branchFactor, 'f', 2));
+    m_straightawayLabel->setText(QString::number(metrics.longestStraightaway));
+    m_wallFollowerLabel->setText(metrics.solvableByWallFollower ? "TRUE" : "FALSE");
+    m_runTimeLabel->setText(
+        metrics.optimalRunTime < 0
+        ? "-"
+        : QString::number(metrics.optimalRunTime, 'f', 2) + "s"
+    );
+}
+
+QString Window::getMouseFile(const QString& algoName) const {
+    return SettingsMouseAlgos::getMouseFilePath(algoName);
+}
+
+FrameRecorder* Window::getFrameRecorder() {
+    if (m_frameRecorder == nullptr) {
+        m_frameRecorder = new FrameRecorder(
+            SettingsMisc::getExportWidth(),
+            SettingsMisc::getExportHeight());
+    }
+    return m_frameRecorder;
+}
+
+void Window::updateFrameRecorderScene() {
+    if (m_maze == nullptr) {
+        return;
+    }
+    bool showView = m_viewButton->isChecked() && m_view != nullptr;
+    bool isRewound = m_rewindView != nullptr;
+    getFrameRecorder()->setScene(
+        m_maze,
+        isRewound ? m_rewindView : showView ? m_view : m_truth,
+        isRewound ? m_rewindMouseGraphic : m_mouseGraphic,
+        m_followCheckbox->isChecked() ? LayoutType::ZOOMED : LayoutType::FULL);
 }
 
 void Window::editSettings() {
@@ -433,11 +671,37 @@ void Window::editSettings() {
     tileTextFontImageField.comboBoxSelected = 
         SettingsMisc::getFontImagePathComboBoxSelected();
 
+    // The resolution and frame interval of exported images
+    ConfigDialogField exportWidthField;
+    exportWidthField.label = "Export Width";
+    exportWidthField.type = ConfigDialogFieldType::INTEGER;
+    exportWidthField.initialSpinBoxValue = SettingsMisc::getExportWidth();
+    exportWidthField.spinBoxMinimum = 1;
+    exportWidthField.spinBoxMaximum = MAX_EXPORT_SIZE;
+
+    ConfigDialogField exportHeightField;
+    exportHeightField.label = "Export Height";
+    exportHeightField.type = ConfigDialogFieldType::INTEGER;
+    exportHeightField.initialSpinBoxValue = SettingsMisc::getExportHeight();
+    exportHeightField.spinBoxMinimum = 1;
+    exportHeightField.spinBoxMaximum = MAX_EXPORT_SIZE;
+
+    ConfigDialogField exportFrameIntervalField;
+    exportFrameIntervalField.label = "Frame Interval (ms)";
+    exportFrameIntervalField.type = ConfigDialogFieldType::INTEGER;
+    exportFrameIntervalField.initialSpinBoxValue =
+        SettingsMisc::getExportFrameInterval();
+    exportFrameIntervalField.spinBoxMinimum = 1;
+    exportFrameIntervalField.spinBoxMaximum = MAX_EXPORT_FRAME_INTERVAL;
+
     ConfigDialog dialog(
         "Edit",
         "Settings",
         {
             tileTextFontImageField,
+            exportWidthField,
+            exportHeightField,
+            exportFrameIntervalField,
         },
         false // No "Remove" button
     );
@@ -455,6 +719,18 @@ void Window::editSettings() {
     SettingsMisc::setFontImagePathComboBoxSelected(
         dialog.getComboBoxSelected(tileTextFontImageField.label));
 
+    // Update the export settings; the frame interval takes effect when the
+    // next recording starts
+    SettingsMisc::setExportWidth(dialog.getSpinBoxValue(exportWidthField.label));
+    SettingsMisc::setExportHeight(dialog.getSpinBoxValue(exportHeightField.label));
+    SettingsMisc::setExportFrameInterval(
+        dialog.getSpinBoxValue(exportFrameIntervalField.label));
+    if (m_frameRecorder != nullptr) {
+        m_frameRecorder->setSize(
+            SettingsMisc::getExportWidth(),
+            SettingsMisc::getExportHeight());
+    }
+
     // TODO: upforgrabs
     // Refresh the font, both in the map and in
     // the FontImage singleton, after any updates
@@ -476,7 +752,9 @@ void Window::algoActionStart(
     void (Window::*actionStart)(void),
     void (Window::*actionStop)(void),
     void (Window::*stderrMidAction)(void),
-    void (Window::*stderrPostAction)(void)
+    void (Window::*stderrPostAction)(void),
+    bool (*isUpToDate)(const QString&),
+    void (*actionSucceeded)(const QString&)
 ) {
     // The action should not be running
     ASSERT_FA(actionProcessVariable == nullptr);
@@ -518,6 +796,24 @@ void Window::algoActionStart(
     // Clear the action ouput
     actionOutput->clear();
 
+    // Skip the action if nothing it depends on changed since it last
+    // succeeded, unless the button was shift-clicked
+    if (
+        isUpToDate != nullptr &&
+        !(QApplication::keyboardModifiers() & Qt::ShiftModifier) &&
+        isUpToDate(algoName)
+    ) {
+        actionOutput->appendPlainText(QString(
+            "Nothing changed since the last %1. Shift-click %2 to %1 anyway."
+        ).arg(actionName.toLower(), actionName));
+        actionStatus->setText("UP TO DATE");
+        actionStatus->setStyleSheet(
+            "QLabel { background: rgb(150, 255, 100); }"
+        );
+        outputTabWidget->setCurrentWidget(actionOutput);
+        return;
+    }
+
     // Instantiate a new process
     QProcess* process = new QProcess(this);
 
@@ -557,6 +853,9 @@ void Window::algoActionStart(
                 if (stderrPostAction != nullptr) {
                     (this->*stderrPostAction)();
                 }
+                if (actionSucceeded != nullptr) {
+                    actionSucceeded(algoName);
+                }
                 actionStatus->setText("COMPLETE");
                 actionStatus->setStyleSheet(
                     "QLabel { background: rgb(150, 255, 100); }"
@@ -823,14 +1122,33 @@ void Window::mazeAlgoTabInit() {
     QHBoxLayout* mazeSizeLayout = new QHBoxLayout();
     mazeSizeBox->setLayout(mazeSizeLayout);
 
-    // Add the maze size inputs
-    m_mazeAlgoWidthBox->setValue(16);
-    m_mazeAlgoHeightBox->setValue(16);
+    // Add the maze size inputs; large mazes are only practical with the
+    // binary output, but the text output still works for them
+    for (QSpinBox* box : {m_mazeAlgoWidthBox, m_mazeAlgoHeightBox}) {
+        box->setRange(1, MAZE_ALGO_MAX_DIMENSION);
+        box->setValue(16);
+    }
     mazeSizeLayout->addWidget(new QLabel("Width"));
     mazeSizeLayout->addWidget(m_mazeAlgoWidthBox);
     mazeSizeLayout->addWidget(new QLabel("Height"));
     mazeSizeLayout->addWidget(m_mazeAlgoHeightBox);
 
+    // Add the binary output checkbox
+    optionsLayout->addWidget(m_mazeAlgoBinaryOutputCheckbox);
+    m_mazeAlgoBinaryOutputCheckbox->setToolTip(
+        "Pass --binary to the algorithm, which then writes the maze as a "
+        "compact wall bitmap rather than as text"
+    );
+    m_mazeAlgoBinaryOutputCheckbox->setChecked(
+        SettingsMisc::getMazeAlgoBinaryOutput()
+    );
+    connect(
+        m_mazeAlgoBinaryOutputCheckbox, &QCheckBox::stateChanged,
+        this, [=](int state){
+            SettingsMisc::setMazeAlgoBinaryOutput(state == Qt::Checked);
+        }
+    );
+
     // Add the build and run output
     m_mazeAlgoOutputTabWidget = new QTabWidget();
     layout->addWidget(m_mazeAlgoOutputTabWidget);
@@ -966,7 +1284,9 @@ void Window::mazeAlgoBuildStart() {
         &Window::mazeAlgoBuildStart,
         &Window::mazeAlgoBuildStop,
         &Window::mazeAlgoBuildStderr,
-        nullptr
+        nullptr,
+        AlgoBuilder::isMazeAlgoBuilt,
+        AlgoBuilder::setMazeAlgoBuilt
     );
 }
 
@@ -987,14 +1307,19 @@ void Window::mazeAlgoBuildStderr() {
 }
 
 QVector<QString> Window::mazeAlgoRunExtraArgs() {
-    return {
+    QVector<QString> args = {
         m_mazeAlgoWidthBox->cleanText(),
         m_mazeAlgoHeightBox->cleanText(),
         QString::number(m_mazeAlgoSeedWidget->next()),
     };
+    if (m_mazeAlgoBinaryOutputCheckbox->isChecked()) {
+        args.append("--binary");
+    }
+    return args;
 }
 
 void Window::mazeAlgoRunStart() {
+    m_mazeAlgoRunBuffer.clear();
     algoActionStart(
         &m_mazeAlgoRunProcess,
         m_mazeAlgoRunButton,
@@ -1010,7 +1335,9 @@ void Window::mazeAlgoRunStart() {
         &Window::mazeAlgoRunStart,
         &Window::mazeAlgoRunStop,
         nullptr,
-        &Window::mazeAlgoRunStderr
+        &Window::mazeAlgoRunStderr,
+        nullptr,
+        nullptr
     );
 }
 
@@ -1023,8 +1350,26 @@ void Window::mazeAlgoRunStop() {
 
 void Window::mazeAlgoRunStderr() {
     ASSERT_FA(m_mazeAlgoRunProcess == nullptr);
-    QString output = m_mazeAlgoRunProcess->readAllStandardError();
-    Maze* maze = Maze::fromAlgo(output.toUtf8());
+    QByteArray output = m_mazeAlgoRunProcess->readAllStandardError();
+    if (m_mazeAlgoBinaryOutputCheckbox->isChecked()) {
+        // This runs once the algorithm has exited, so a record that isn't all
+        // here never will be. An invalid header is handed over as is, to be
+        // reported as such.
+        m_mazeAlgoRunBuffer.append(output);
+        int size = MazeFileUtilities::getMmswRecordSize(m_mazeAlgoRunBuffer);
+        if (0 <= size && m_mazeAlgoRunBuffer.size() < size) {
+            m_mazeAlgoRunBuffer.clear();
+            QMessageBox::warning(
+                this,
+                "Invalid Maze",
+                "Could not load generated maze"
+            );
+            return;
+        }
+        output = size < 0 ? m_mazeAlgoRunBuffer : m_mazeAlgoRunBuffer.left(size);
+        m_mazeAlgoRunBuffer.remove(0, output.size());
+    }
+    Maze* maze = Maze::fromAlgo(output);
     if (maze != nullptr) {
         setMaze(maze);
     }
@@ -1114,6 +1459,8 @@ void Window::mouseAlgoTabInit() {
     algorithmLayout->addWidget(m_mouseAlgoComboBox, 0, 0, 1, 2);
     algorithmLayout->addWidget(m_mouseAlgoImportButton, 1, 0);
     algorithmLayout->addWidget(m_mouseAlgoEditButton, 1, 1);
+    algorithmLayout->addWidget(new QLabel("Race Against"), 2, 0);
+    algorithmLayout->addWidget(m_mouseAlgoRivalComboBox, 2, 1);
     connect(
         m_mouseAlgoComboBox, &QComboBox::currentTextChanged,
         this, [=](QString name){
@@ -1186,6 +1533,28 @@ void Window::mouseAlgoTabInit() {
     );
     speedSlider->setValue(100.0 / speedBox->maximum() - 1.0);
 
+    // Add the rewind slider, whose last position is the live run
+    QHBoxLayout* rewindLayout = new QHBoxLayout();
+    controlLayout->addLayout(rewindLayout);
+    rewindLayout->addWidget(new QLabel("Rewind"));
+    rewindLayout->addWidget(m_rewindSlider);
+    rewindLayout->addWidget(m_rewindLabel);
+    m_rewindSlider->setRange(0, 0);
+    m_rewindSlider->setEnabled(false);
+    m_rewindLabel->setText("Live");
+    m_rewindLabel->setMinimumWidth(60);
+    connect(
+        m_rewindSlider, &QSlider::valueChanged,
+        this, [=](int value){
+            if (value < m_rewindSlider->maximum()) {
+                rewindTo(value);
+            }
+            else {
+                rewindStop();
+            }
+        }
+    );
+
     // Add the input buttons
     QHBoxLayout* inputButtonsLayout = new QHBoxLayout();
     inputButtonsLayout->addWidget(new QLabel("Input Buttons"));
@@ -1206,12 +1575,14 @@ void Window::mouseAlgoTabInit() {
     m_mouseAlgoOutputTabWidget->addTab(m_mouseAlgoBuildOutput, "Build Output");
     m_mouseAlgoOutputTabWidget->addTab(m_mouseAlgoRunOutput, "Run Output");
     m_mouseAlgoOutputTabWidget->addTab(m_mouseAlgoRunOutput, "Run Output");
+    m_mouseAlgoOutputTabWidget->addTab(m_mouseAlgoRivalOutput, "Rival Output");
     m_mouseAlgoOutputTabWidget->addTab(m_mouseAlgoStatsWidget, "Stats");
 
     // Set the default values for some widgets
     for (QPlainTextEdit* output : {
         m_mouseAlgoBuildOutput,
         m_mouseAlgoRunOutput,
+        m_mouseAlgoRivalOutput,
     }) {
         output->setReadOnly(true);
         output->setLineWrapMode(QPlainTextEdit::NoWrap);
@@ -1224,9 +1595,23 @@ void Window::mouseAlgoTabInit() {
         output->document()->setDefaultFont(font);
     }
 
-    // Add the algo run stats
+    // Add the algo run stats, followed by the performance stats
     QPair<QStringList, QVector<QVariant>> runStats = getRunStats();
-    m_mouseAlgoStatsWidget->init(runStats.first);
+    QPair<QStringList, QStringList> performanceStats =
+        Instrumentation::get()->summarize();
+    m_mouseAlgoStatsWidget->init(runStats.first + performanceStats.first);
+
+    // Refreshing the performance stats is cheap, since they're just reads
+    // of a handful of lock-free ring buffers
+    QTimer* performanceStatsTimer = new QTimer(this);
+    connect(performanceStatsTimer, &QTimer::timeout, this, [=](){
+        QPair<QStringList, QStringList> stats =
+            Instrumentation::get()->summarize();
+        for (int i = 0; i < stats.first.size(); i += 1) {
+            m_mouseAlgoStatsWidget->setValue(stats.first.at(i), stats.second.at(i));
+        }
+    });
+    performanceStatsTimer->start(250);
 
     // Add the mouse algos
     mouseAlgoRefresh(SettingsMisc::getRecentMouseAlgo());
@@ -1357,7 +1742,9 @@ void Window::mouseAlgoBuildStart() {
         &Window::mouseAlgoBuildStart,
         &Window::mouseAlgoBuildStop,
         &Window::mouseAlgoBuildStderr,
-        nullptr
+        nullptr,
+        AlgoBuilder::isMouseAlgoBuilt,
+        AlgoBuilder::setMouseAlgoBuilt
     );
 }
 
@@ -1377,22 +1764,8 @@ void Window::mouseAlgoBuildStderr() {
     m_mouseAlgoBuildOutput->appendPlainText(error);
 }
 
-void Window::mouseAlgoRunStart() {
-
-    QString algoName = m_mouseAlgoComboBox->currentText();
-    QString dirPath = SettingsMouseAlgos::getDirPath(algoName);
-    QString command = SettingsMouseAlgos::getRunCommand(algoName);
-
-    // If the combobox was selected, use the combobox value
-    QString mouseFile;
-    if (SettingsMouseAlgos::getMouseFilePathComboBoxSelected(algoName)) {
-        mouseFile = SettingsMouseAlgos::getMouseFilePathComboBoxValue(algoName);
-    } else {
-        mouseFile = SettingsMouseAlgos::getMouseFilePathLineEditValue(algoName);
-    }
-
-    // Perform config validation
-    if (command.isEmpty()) {
+bool Window::checkMouseAlgoConfig(const QString& algoName) {
+    if (SettingsMouseAlgos::getRunCommand(algoName).isEmpty()) {
         QMessageBox::warning(
             this,
             "Empty Run Command",
@@ -1400,9 +1773,9 @@ void Window::mouseAlgoRunStart() {
                 algoName
             )
         );
-        return;
+        return false;
     }
-    if (dirPath.isEmpty()) {
+    if (SettingsMouseAlgos::getDirPath(algoName).isEmpty()) {
         QMessageBox::warning(
             this,
             "Empty Directory",
@@ -1410,9 +1783,9 @@ void Window::mouseAlgoRunStart() {
                 algoName
             )
         );
-        return;
+        return false;
     }
-    if (mouseFile.isEmpty()) {
+    if (getMouseFile(algoName).isEmpty()) {
         QMessageBox::warning(
             this,
             "Empty Mouse File",
@@ -1420,6 +1793,21 @@ void Window::mouseAlgoRunStart() {
                 algoName
             )
         );
+        return false;
+    }
+    return true;
+}
+
+void Window::mouseAlgoRunStart() {
+
+    QString algoName = m_mouseAlgoComboBox->currentText();
+    QString dirPath = SettingsMouseAlgos::getDirPath(algoName);
+    QString command = SettingsMouseAlgos::getRunCommand(algoName);
+
+    QString mouseFile = getMouseFile(algoName);
+
+    // Perform config validation
+    if (!checkMouseAlgoConfig(algoName)) {
         return;
     }
 
@@ -1433,15 +1821,52 @@ void Window::mouseAlgoRunStart() {
         return;
     }
     if (!m_maze->isValidMaze()) {
+        QStringList issues;
+        for (const MazeCheckIssue& issue : m_maze->getCheckIssues()) {
+            issues.append(MazeChecker::describe(issue));
+        }
         QMessageBox::warning(
             this,
             "Invalid Maze",
             "Cannot run mouse algorithm because the maze is invalid. The maze "
-            "must be nonempty, rectangular, enclosed, and self-consistent."
+            "must be nonempty, rectangular, enclosed, and self-consistent.\n\n"
+            + issues.join("\n")
         );
         return;
     }
 
+    // The rival, if one was chosen, races the algorithm on the same maze
+    QString rivalName;
+    if (m_mouseAlgoRivalComboBox->currentIndex() > 0) {
+        rivalName = m_mouseAlgoRivalComboBox->currentText();
+        if (!checkMouseAlgoConfig(rivalName)) {
+            return;
+        }
+    }
+
+    // A persistent algo that's waiting for its next run is given the run
+    // instead of being started again, and its mouse and view are reset
+    if (
+        m_mouseInterface != nullptr &&
+        m_mouseAlgoWaitingName == algoName &&
+        m_mouse->getMouseFile() == mouseFile &&
+        rivalName.isEmpty()
+    ) {
+        mazeAlgoRunStop();
+        rivalAlgoRunStop();
+        rewindStop();
+        m_checkpoints.start(
+            mouseFile,
+            Duration::Milliseconds(SettingsMisc::getCheckpointInterval()),
+            SettingsMisc::getCheckpointCapacity());
+        m_mouseAlgoWaitingName.clear();
+        m_mouseAlgoRunOutput->clear();
+        m_mouseAlgoOutputTabWidget->setCurrentWidget(m_mouseAlgoRunOutput);
+        mouseAlgoResume();
+        emit mouseAlgoRunContinued(m_mouseAlgoSeedWidget->next());
+        return;
+    }
+
     // Generate the mouse, check mouse file success
     Mouse* newMouse = new Mouse(m_maze);
     bool success = newMouse->reload(mouseFile);
@@ -1456,6 +1881,22 @@ void Window::mouseAlgoRunStart() {
         delete newMouse;
         return;
     }
+    Mouse* newRivalMouse = nullptr;
+    if (!rivalName.isEmpty()) {
+        newRivalMouse = new Mouse(m_maze);
+        if (!newRivalMouse->reload(getMouseFile(rivalName))) {
+            QMessageBox::warning(
+                this,
+                "Invalid Mouse File",
+                QString("Mouse file \"%1\"could not be loaded.").arg(
+                    getMouseFile(rivalName)
+                )
+            );
+            delete newRivalMouse;
+            delete newMouse;
+            return;
+        }
+    }
 
     // Stop running maze/mouse algorithms
     mazeAlgoRunStop();
@@ -1477,13 +1918,92 @@ void Window::mouseAlgoRunStart() {
         newView
     );
 
+    // The rival gets its own view and interface, so that neither algorithm
+    // can see what the other has discovered
+    MazeView* newRivalView = nullptr;
+    MouseGraphic* newRivalMouseGraphic = nullptr;
+    MouseInterface* newRivalMouseInterface = nullptr;
+    if (newRivalMouse != nullptr) {
+        newRivalView = new MazeView(
+            m_maze,
+            m_wallTruthCheckbox->isChecked(),
+            m_colorCheckbox->isChecked(),
+            m_fogCheckbox->isChecked(),
+            m_textCheckbox->isChecked(),
+            false // autopopulateTextWithDistance
+        );
+        newRivalMouseGraphic = new MouseGraphic(newRivalMouse, RIVAL_MOUSE_ALPHA);
+        newRivalMouseInterface = new MouseInterface(
+            m_maze,
+            newRivalMouse,
+            newRivalView
+        );
+    }
+
     // Clear the output, and jump to it
     m_mouseAlgoRunOutput->clear();
+    m_mouseAlgoRivalOutput->clear();
     m_mouseAlgoOutputTabWidget->setCurrentWidget(m_mouseAlgoRunOutput);
 
-    // Append the random seed to the command
+    // Append the random seed to the command. A rival gets the same seed, so
+    // that the race is fair.
+    quint32 seed = m_mouseAlgoSeedWidget->next();
     command += " ";
-    command += QString::number(m_mouseAlgoSeedWidget->next());
+    command += QString::number(seed);
+
+    // First, connect the newTileLocationTraversed signal to a lambda that
+    // clears tile fog *before* adding the mouse to the maze. This ensures
+    // that the first tile's fog is always cleared (the initial value of
+    // automaticallyClearFog is true). This means that, if an algorithm
+    // doesn't want to automatically clear tile fog, it'll have to disable
+    // tile fog and then mark the first tile as foggy. Each mouse only
+    // clears the fog of its own view.
+    QVector<Mouse*> newMice = {newMouse};
+    QVector<QPair<MazeView*, MouseInterface*>> newControllers = {
+        {newView, newMouseInterface}
+    };
+    if (newRivalMouse != nullptr) {
+        newMice.append(newRivalMouse);
+        newControllers.append({newRivalView, newRivalMouseInterface});
+    }
+    for (int i = 0; i < newMice.size(); i += 1) {
+        const Mouse* mouse = newMice.at(i);
+        MazeView* view = newControllers.at(i).first;
+        MouseInterface* mouseInterface = newControllers.at(i).second;
+        connect(
+            &m_model,
+            &Model::newTileLocationTraversed,
+            // TODO: upforgrabs
+            // Changing "mouseInterface" to "this" makes it so that the fog
+            // clears as soon as the mouse enters a tile (rather than waiting
+            // for the algorithm-requested action to finish). However, it also
+            // causes segfaults. Your mission is to make this work without
+            // causing segfaults.
+            mouseInterface,
+            [=](const Mouse* traversingMouse, int x, int y){
+                if (
+                    traversingMouse == mouse &&
+                    mouseInterface->getDynamicOptions().automaticallyClearFog
+                ) {
+                    view->getMazeGraphic()->setTileFogginess(x, y, false);
+                }
+            }
+        );
+    }
+
+    // Checkpoints are taken of the main mouse only
+    m_checkpoints.start(
+        mouseFile,
+        Duration::Milliseconds(SettingsMisc::getCheckpointInterval()),
+        SettingsMisc::getCheckpointCapacity());
+
+    // We need to add the mice to the world *after* making the previous
+    // connections (thus ensuring that tile fog is cleared automatically), but
+    // *before* we actually start the algorithms (lest the mouse
+    // position/orientation not be updated properly during the beginning of
+    // the mouse algo's execution). The mice are added together, so that
+    // they share the sim clock from the very start.
+    m_model.setMice(newMice);
 
     // The thread on which the mouse interface will execute
     QThread* newMouseAlgoThread = new QThread();
@@ -1532,13 +2052,14 @@ void Window::mouseAlgoRunStart() {
             newMouseInterface,
             [=](){
                 QString text = newProcess->readAllStandardError();
-                QStringList lines = getLines(text, &m_stderrBuffer);
+                QStringList lines = SimUtilities::getLines(text, &m_stderrBuffer);
                 for (const QString& line : lines) {
                     QString response = newMouseInterface->dispatch(line);
                     if (!response.isEmpty()) {
                         newProcess->write((response + "\n").toStdString().c_str());
                     }
                 }
+                captureCheckpoint(newMouseInterface);
             }
         );
 
@@ -1567,35 +2088,35 @@ void Window::mouseAlgoRunStart() {
             );
         }
 
-        // First, connect the newTileLocationTraversed signal to a lambda that
-        // clears tile fog *before* adding the mouse to the maze. This ensures
-        // that the first tile's fog is always cleared (the initial value of
-        // automaticallyClearFog is true). This means that, if an algorithm
-        // doesn't want to automatically clear tile fog, it'll have to disable
-        // tile fog and then mark the first tile as foggy.
-        connect(
-            &m_model,
-            &Model::newTileLocationTraversed,
-            // TODO: upforgrabs
-            // Changing "newMouseInterface" to "this" makes it so that the fog
-            // clears as soon as the mouse enters a tile (rather than waiting
-            // for the algorithm-requested action to finish). However, it also
-            // causes segfaults. Your mission is to make this work without
-            // causing segfaults.
-            newMouseInterface,
-            [=](int x, int y){
-                if (newMouseInterface->getDynamicOptions().automaticallyClearFog) {
-                    newView->getMazeGraphic()->setTileFogginess(x, y, false);
-                }
-            }
-        );
-
-        // We need to add the mouse to the world *after* the making the
-        // previous connection (thus ensuring that tile fog is cleared
-        // automatically), but *before* we actually start the algorithm (lest
-        // the mouse position/orientation not be updated properly during the
-        // beginning of the mouse algo's execution)
-        m_model.setMouse(newMouse);
+        // A persistent algo is done with its run once it waits for the next
+        // one, at which point the run is complete but the process lives on
+        connect(newMouseInterface, &MouseInterface::waitingForRun, this, [=](){
+            m_mouseAlgoWaitingName = algoName;
+            disconnect(
+                m_mouseAlgoRunButton, &QPushButton::clicked,
+                this, &Window::mouseAlgoRunStop
+            );
+            connect(
+                m_mouseAlgoRunButton, &QPushButton::clicked,
+                this, &Window::mouseAlgoRunStart
+            );
+            m_mouseAlgoRunButton->setText("Run");
+            m_mouseAlgoRunStatus->setText("COMPLETE");
+            m_mouseAlgoRunStatus->setStyleSheet(
+                "QLabel { background: rgb(150, 255, 100); }"
+            );
+        });
+        const Maze* maze = m_maze;
+        connect(this, &Window::mouseAlgoRunContinued, newMouseInterface, [=](quint32 seed){
+            newMouse->stopAllWheels();
+            newMouse->reset();
+            newView->reset();
+            QString response = newMouseInterface->beginRun(maze, newMouse, newView, seed);
+            m_model.removeMouse();
+            m_model.setMouse(newMouse);
+            newProcess->write((response + "\n").toStdString().c_str());
+            newMouseInterface->emitMouseAlgoStarted();
+        });
 
         // Re-enable run button when build finishes, clean up the process
         connect(
@@ -1608,6 +2129,9 @@ void Window::mouseAlgoRunStart() {
 
                 // TODO: MACK - does the thread get cleaned up if the mouse exits normally?
 
+                // A persistent algo can't be given another run once it exits
+                m_mouseAlgoWaitingName.clear();
+
                 // Set the button to "Action"
                 disconnect(
                     m_mouseAlgoRunButton, &QPushButton::clicked,
@@ -1714,10 +2238,356 @@ void Window::mouseAlgoRunStart() {
     // Start the mouse interface thread
     newMouseInterface->moveToThread(newMouseAlgoThread);
     newMouseAlgoThread->start();
+
+    // Then start the rival, if any
+    if (newRivalMouse != nullptr) {
+        rivalAlgoRunStart(
+            rivalName,
+            newRivalMouse,
+            newRivalView,
+            newRivalMouseGraphic,
+            newRivalMouseInterface,
+            seed
+        );
+    }
+}
+
+void Window::rivalAlgoRunStart(
+        const QString& algoName,
+        Mouse* mouse,
+        MazeView* view,
+        MouseGraphic* mouseGraphic,
+        MouseInterface* mouseInterface,
+        quint32 seed) {
+
+    QString dirPath = SettingsMouseAlgos::getDirPath(algoName);
+    QString command = SettingsMouseAlgos::getRunCommand(algoName);
+    command += " ";
+    command += QString::number(seed);
+
+    // The rival joins the race right away, on the UI thread, which is the
+    // only one that touches these members
+    QThread* thread = new QThread();
+    m_rivalMouse = mouse;
+    m_rivalView = view;
+    m_rivalMouseGraphic = mouseGraphic;
+    m_rivalMouseInterface = mouseInterface;
+    m_rivalMouseAlgoThread = thread;
+    updateOtherMouseGraphics();
+
+    connect(
+        mouseInterface,
+        &MouseInterface::algoOutput,
+        this,
+        [=](QString output){
+            m_mouseAlgoRivalOutput->appendPlainText(output);
+        }
+    );
+
+    // Both algorithms see every press of the input buttons
+    connect(
+        this,
+        &Window::inputButtonWasPressed,
+        mouseInterface,
+        &MouseInterface::inputButtonWasPressed
+    );
+
+    // If the process fails to start, take the rival out of the race. This is
+    // emitted from the rival's thread, so it's queued to the UI thread.
+    connect(
+        mouseInterface,
+        &MouseInterface::mouseAlgoCannotStart,
+        this,
+        [=](QString errorString){
+            m_mouseAlgoRivalOutput->appendPlainText(errorString);
+            if (m_rivalMouseInterface == mouseInterface) {
+                rivalAlgoRunStop();
+            }
+        }
+    );
+
+    // Like the main algorithm, the rival's process lives on its own thread,
+    // see mouseAlgoRunStart()
+    connect(thread, &QThread::started, mouseInterface, [=](){
+
+        QProcess* process = new QProcess();
+        connect(
+            process,
+            &QProcess::readyReadStandardOutput,
+            mouseInterface,
+            [=](){
+                QString output = process->readAllStandardOutput();
+                mouseInterface->handleStandardOutput(output);
+            }
+        );
+        connect(
+            process,
+            &QProcess::readyReadStandardError,
+            mouseInterface,
+            [=](){
+                QString text = process->readAllStandardError();
+                QStringList lines = SimUtilities::getLines(text, &m_rivalStderrBuffer);
+                for (const QString& line : lines) {
+                    QString response = mouseInterface->dispatch(line);
+                    if (!response.isEmpty()) {
+                        process->write((response + "\n").toStdString().c_str());
+                    }
+                }
+            }
+        );
+
+        // When the thread finishes, clean everything up
+        connect(thread, &QThread::finished, this, [=](){
+            process->terminate();
+            process->waitForFinished();
+            delete process;
+            delete thread;
+            delete mouseInterface;
+            delete mouseGraphic;
+            delete view;
+            delete mouse;
+        });
+
+        if (!ProcessUtilities::start(command, dirPath, process)) {
+            mouseInterface->emitMouseAlgoCannotStart(process->errorString());
+        }
+    });
+
+    mouseInterface->moveToThread(thread);
+    thread->start();
+}
+
+void Window::rivalAlgoRunStop() {
+    if (m_rivalMouseInterface != nullptr) {
+        ASSERT_FA(m_rivalMouseAlgoThread == nullptr);
+        m_rivalMouseAlgoThread->quit();
+        m_rivalMouseInterface->requestStop();
+        m_rivalMouseAlgoThread->wait();
+        m_model.removeMouse(m_rivalMouse);
+    }
+    m_rivalStderrBuffer.clear();
+    m_rivalMouseAlgoThread = nullptr;
+    m_rivalMouseInterface = nullptr;
+    m_rivalMouseGraphic = nullptr;
+    m_rivalView = nullptr;
+    m_rivalMouse = nullptr;
+    updateOtherMouseGraphics();
+}
+
+void Window::saveTrajectory() {
+    Trajectory trajectory = m_model.getTrajectory();
+    if (trajectory.samples.isEmpty()) {
+        QMessageBox::warning(
+            this,
+            "No Trajectory",
+            "There is no run to save. Run a mouse algorithm first."
+        );
+        return;
+    }
+    QString path = QFileDialog::getSaveFileName(
+        this,
+        tr("Save Run Trajectory"),
+        "",
+        tr("Trajectories (*.%1)").arg(TrajectoryRecorder::SUFFIX)
+    );
+    if (path.isEmpty()) {
+        return;
+    }
+    // The model only keeps the trajectory for as long as the maze is loaded
+    trajectory.mazeHash = m_maze->getWalls().toWallGrid().hash();
+    if (!TrajectoryRecorder::save(path, trajectory)) {
+        QMessageBox::warning(
+            this,
+            "Unable to Save Trajectory",
+            QString("The trajectory couldn't be written to \"%1\".").arg(path)
+        );
+    }
+}
+
+void Window::loadGhost() {
+    if (m_maze == nullptr) {
+        QMessageBox::warning(
+            this,
+            "No Maze",
+            "You must load a maze before loading a ghost."
+        );
+        return;
+    }
+    QString path = QFileDialog::getOpenFileName(
+        this,
+        tr("Load Ghost"),
+        "",
+        tr("Trajectories (*.%1)").arg(TrajectoryRecorder::SUFFIX)
+    );
+    if (path.isEmpty()) {
+        return;
+    }
+    Trajectory trajectory;
+    if (!TrajectoryRecorder::load(path, &trajectory) || trajectory.samples.isEmpty()) {
+        QMessageBox::warning(
+            this,
+            "Invalid Trajectory",
+            QString("\"%1\" isn't a trajectory with any samples.").arg(path)
+        );
+        return;
+    }
+
+    // The ghost is drawn with the mouse that made the run
+    Mouse* ghostMouse = new Mouse(m_maze);
+    if (!ghostMouse->reload(trajectory.mouseFile)) {
+        QMessageBox::warning(
+            this,
+            "Invalid Mouse File",
+            QString("The ghost's mouse file \"%1\" could not be loaded.").arg(
+                trajectory.mouseFile
+            )
+        );
+        delete ghostMouse;
+        return;
+    }
+    if (trajectory.mazeHash != m_maze->getWalls().toWallGrid().hash()) {
+        QMessageBox::warning(
+            this,
+            "Different Maze",
+            "The ghost ran on a different maze, so it may go through walls."
+        );
+    }
+
+    clearGhost();
+    m_ghostMouse = ghostMouse;
+    m_ghostMouseGraphic = new MouseGraphic(ghostMouse, GHOST_MOUSE_ALPHA);
+    m_ghostPlayer = new TrajectoryPlayer(trajectory.samples);
+    updateOtherMouseGraphics();
+}
+
+void Window::clearGhost() {
+    if (m_ghostPlayer == nullptr) {
+        return;
+    }
+    MouseGraphic* ghostMouseGraphic = m_ghostMouseGraphic;
+    m_ghostMouseGraphic = nullptr;
+    updateOtherMouseGraphics();
+    delete m_ghostPlayer;
+    delete ghostMouseGraphic;
+    delete m_ghostMouse;
+    m_ghostPlayer = nullptr;
+    m_ghostMouse = nullptr;
+}
+
+void Window::updateOtherMouseGraphics() {
+    QVector<const MouseGraphic*> mouseGraphics;
+    if (m_ghostMouseGraphic != nullptr) {
+        mouseGraphics.append(m_ghostMouseGraphic);
+    }
+    if (m_rivalMouseGraphic != nullptr) {
+        mouseGraphics.append(m_rivalMouseGraphic);
+    }
+    m_map.setOtherMouseGraphics(mouseGraphics);
+}
+
+void Window::captureCheckpoint(const MouseInterface* mouseInterface) {
+    // Called on the algorithm's thread, the only one that draws on its view
+    Duration simTime = SimTime::get()->elapsedSimTime();
+    if (!m_checkpoints.isDue(simTime)) {
+        return;
+    }
+    const Mouse* mouse = mouseInterface->getMouse();
+    m_checkpoints.capture(
+        simTime,
+        mouse,
+        m_model.getMouseStats(mouse),
+        mouseInterface->getView());
+}
+
+void Window::updateRewindSlider() {
+    int size = m_checkpoints.size();
+    if (size == m_rewindSlider->maximum()) {
+        return;
+    }
+    // A live slider stays live, and a rewound one stays where it is
+    bool isLive = m_rewindSlider->value() == m_rewindSlider->maximum();
+    m_rewindSlider->blockSignals(true);
+    m_rewindSlider->setMaximum(size);
+    if (isLive) {
+        m_rewindSlider->setValue(size);
+    }
+    m_rewindSlider->blockSignals(false);
+    m_rewindSlider->setEnabled(0 < size);
+    // The oldest checkpoints are dropped as new ones are taken, which may
+    // include the one that's shown
+    if (!isLive && size <= m_rewindSlider->value()) {
+        rewindStop();
+    }
+}
+
+void Window::rewindTo(int index) {
+
+    // The mouse and view of the checkpoints are only made once per rewind
+    if (m_rewindView == nullptr) {
+        Mouse* rewindMouse = new Mouse(m_maze);
+        if (!rewindMouse->reload(m_checkpoints.getMouseFile())) {
+            delete rewindMouse;
+            return;
+        }
+        m_rewindMouse = rewindMouse;
+        m_rewindView = new MazeView(
+            m_maze,
+            m_wallTruthCheckbox->isChecked(),
+            m_colorCheckbox->isChecked(),
+            m_fogCheckbox->isChecked(),
+            m_textCheckbox->isChecked(),
+            false // autopopulateTextWithDistance
+        );
+        m_rewindMouseGraphic = new MouseGraphic(m_rewindMouse);
+    }
+
+    // Only the tiles that differ from the checkpoint shown before are redrawn
+    Checkpoint checkpoint = m_checkpoints.get(index);
+    if (m_rewindView->getTileGraphicTextSize() != checkpoint.tileTextSize) {
+        m_rewindView->initTileGraphicText(
+            checkpoint.tileTextSize.first,
+            checkpoint.tileTextSize.second);
+    }
+    m_rewindView->getMazeGraphic()->setTileStates(checkpoint.tileStates);
+    m_rewindMouse->setState(checkpoint.mouseState);
+    m_map.setView(m_rewindView);
+    m_map.setMouseGraphic(m_rewindMouseGraphic);
+    m_rewindLabel->setText(
+        QString("%1 s, %2 tiles%3")
+            .arg(checkpoint.simTime.getSeconds(), 0, 'f', 1)
+            .arg(checkpoint.stats.traversedTileLocations.size())
+            .arg(checkpoint.mouseState.crashed ? ", crashed" : "")
+    );
+}
+
+void Window::rewindStop() {
+    m_rewindSlider->blockSignals(true);
+    m_rewindSlider->setValue(m_rewindSlider->maximum());
+    m_rewindSlider->blockSignals(false);
+    m_rewindLabel->setText("Live");
+    if (m_rewindView == nullptr) {
+        return;
+    }
+    bool showView = m_viewButton->isChecked() && m_view != nullptr;
+    m_map.setMouseGraphic(nullptr);
+    m_map.setView(showView ? m_view : m_truth);
+    m_map.setMouseGraphic(m_mouseGraphic);
+    delete m_rewindMouseGraphic;
+    delete m_rewindView;
+    delete m_rewindMouse;
+    m_rewindMouseGraphic = nullptr;
+    m_rewindView = nullptr;
+    m_rewindMouse = nullptr;
 }
 
 void Window::mouseAlgoRunStop() {
 
+    // A rival only races while the main algorithm runs
+    rivalAlgoRunStop();
+
+    // The checkpoints are kept, so that the run can still be rewound
+    rewindStop();
+
     // Only stop the algo thread if an algo is running
     if (m_mouseInterface != nullptr) {
         // If the mouse interface exists, the thread exists
@@ -1737,6 +2607,7 @@ void Window::mouseAlgoRunStop() {
     // separate callback). Note that we do this *after* stopping the algo
     // thread so that we can be sure no more stderr will be emitted.
     m_stderrBuffer.clear();
+    m_mouseAlgoWaitingName.clear();
     m_map.setMouseGraphic(nullptr);
     m_map.setView(m_truth);
     m_model.removeMouse();
@@ -1765,6 +2636,7 @@ void Window::handleMouseAlgoCannotStart(QString errorString) {
         "QLabel { background: rgb(255, 150, 150); }"
     );
     m_mouseAlgoRunOutput->appendPlainText(errorString);
+    rivalAlgoRunStop();
     m_model.removeMouse();
 }
 
@@ -1796,16 +2668,23 @@ void Window::mouseAlgoResume() {
 }
 
 void Window::mouseAlgoRefresh(const QString& name) {
+    QString rivalName = m_mouseAlgoRivalComboBox->currentText();
     m_mouseAlgoComboBox->clear();
+    m_mouseAlgoRivalComboBox->clear();
+    m_mouseAlgoRivalComboBox->addItem("None");
     for (const QString& algoName : SettingsMouseAlgos::names()) {
         m_mouseAlgoComboBox->addItem(algoName);
+        m_mouseAlgoRivalComboBox->addItem(algoName);
     }
     int index = m_mouseAlgoComboBox->findText(name);
     if (index != -1) {
         m_mouseAlgoComboBox->setCurrentIndex(index);
     }
+    int rivalIndex = m_mouseAlgoRivalComboBox->findText(rivalName);
+    m_mouseAlgoRivalComboBox->setCurrentIndex(rivalIndex == -1 ? 0 : rivalIndex);
     bool isEmpty = (m_mouseAlgoComboBox->count() == 0);
     m_mouseAlgoComboBox->setEnabled(!isEmpty);
+    m_mouseAlgoRivalComboBox->setEnabled(!isEmpty);
     m_mouseAlgoEditButton->setEnabled(!isEmpty);
     m_mouseAlgoBuildButton->setEnabled(!isEmpty);
     m_mouseAlgoRunButton->setEnabled(!isEmpty);
@@ -1848,36 +2727,4 @@ QVector<ConfigDialogField> Window::mouseAlgoGetFields() {
     };
 }
 
-QStringList Window::getLines(const QString& text, QStringList* buffer) {
-
-    // TODO: upforgrabs
-    // Determine whether or not this function is perf sensitive. If so,
-    // refactor this so that we're not copying QStrings between lists.
-
-    // Separate the text by line
-    QStringList parts = SimUtilities::splitLines(text);
-
-    // We'll return list of complete lines
-    QStringList lines;
-
-    // If the text has at least one newline character, we definitely have a
-    // complete line; combine it with the contents of the buffer and append
-    // it to the list of lines to be returned
-    if (1 < parts.size()) {
-        lines.append(buffer->join("") + parts.at(0));
-        buffer->clear();
-    }
-
-    // All newline-separated parts in the text are lines
-    for (int i = 1; i < parts.size() - 1; i += 1) {
-        lines.append(parts.at(i));
-    }
-
-    // Store the last part of the text (empty string if the text ended
-    // with newline) in the buffer, to be combined with future input
-    buffer->append(parts.at(parts.size() - 1));
-
-    return lines;
-}
-
 } // namespace mms
@@ -9,9 +9,12 @@
 #include <QProcess>
 #include <QPushButton>
 #include <QRadioButton>
+#include <QSlider>
 #include <QThread>
 
+#include "CheckpointHistory.h"
 #include "ConfigDialogField.h"
+#include "FrameRecorder.h"
 #include "Map.h"
 #include "Maze.h"
 #include "MazeView.h"
@@ -20,6 +23,7 @@
 #include "MouseGraphic.h"
 #include "MouseInterface.h"
 #include "RandomSeedWidget.h"
+#include "TrajectoryPlayer.h"
 
 namespace mms {
 
@@ -41,6 +45,9 @@ signals:
     // Emits this signal when the mouse algo can't start
     void mouseAlgoCannotStart(QString errorString);
 
+    // Emits this signal to give a persistent mouse algo its next run
+    void mouseAlgoRunContinued(quint32 seed);
+
 private:
 
     // A separate thread for the model ensures that updates don't get blocked
@@ -56,6 +63,13 @@ private:
     QLabel* m_mazeDirLabel;
     QLabel* m_isValidLabel;
     QLabel* m_isOfficialLabel;
+    QLabel* m_shortestPathLabel;
+    QLabel* m_optimalTurnsLabel;
+    QLabel* m_deadEndsLabel;
+    QLabel* m_branchFactorLabel;
+    QLabel* m_straightawayLabel;
+    QLabel* m_wallFollowerLabel;
+    QLabel* m_runTimeLabel;
 
     // The map object
     Map m_map;
@@ -81,9 +95,27 @@ private:
     MazeView* m_view;
     MouseInterface* m_mouseInterface;
 
+    // Renders offscreen images of the map, created on first use
+    FrameRecorder* m_frameRecorder;
+    FrameRecorder* getFrameRecorder();
+    void updateFrameRecorderScene();
+
+    // The largest export resolution and frame interval (in milliseconds) that
+    // the settings dialog accepts
+    static const int MAX_EXPORT_SIZE = 16384;
+    static const int MAX_EXPORT_FRAME_INTERVAL = 60000;
+
     // Helper function for updating the maze 
     void setMaze(Maze* maze);
 
+    // Replaces the maze with a rotated or mirrored copy of itself (see
+    // MazeSymmetry), rebinding the truth view in place when possible
+    void transformMaze(int symmetry);
+    void updateMazeStats();
+
+    // The mouse file configured for a mouse algorithm
+    QString getMouseFile(const QString& algoName) const;
+
     // Helper function for editing settings
     void editColors();
     void editSettings();
@@ -105,7 +137,9 @@ private:
         void (Window::*actionStart)(void),
         void (Window::*actionStop)(void),
         void (Window::*stderrMidAction)(void),
-        void (Window::*stderrPostAction)(void)
+        void (Window::*stderrPostAction)(void),
+        bool (*isUpToDate)(const QString&),
+        void (*actionSucceeded)(const QString&)
     );
     void algoActionStop(
         QProcess* actionProcess,
@@ -137,6 +171,7 @@ private:
     QPushButton* m_mazeAlgoRunButton;
     QLabel* m_mazeAlgoRunStatus;
     QPlainTextEdit* m_mazeAlgoRunOutput;
+    QByteArray m_mazeAlgoRunBuffer;
     QVector<QString> mazeAlgoRunExtraArgs();
     void mazeAlgoRunStart();
     void mazeAlgoRunStop();
@@ -145,6 +180,8 @@ private:
     QSpinBox* m_mazeAlgoWidthBox;
     QSpinBox* m_mazeAlgoHeightBox;
     RandomSeedWidget* m_mazeAlgoSeedWidget;
+    QCheckBox* m_mazeAlgoBinaryOutputCheckbox;
+    static const int MAZE_ALGO_MAX_DIMENSION = 4096;
 
     void mazeAlgoRefresh(const QString& name = "");
     QVector<ConfigDialogField> mazeAlgoGetFields();
@@ -176,10 +213,15 @@ private:
     // Mouse algo running
     QStringList m_stderrBuffer;
     QProcess* m_mouseAlgoRunProcess;
+    // The name of the persistent mouse algo that's waiting for its next run,
+    // if any, see MouseInterface::beginRun()
+    QString m_mouseAlgoWaitingName;
     QPushButton* m_mouseAlgoRunButton;
     QLabel* m_mouseAlgoRunStatus;
     QPlainTextEdit* m_mouseAlgoRunOutput;
     MouseAlgoStatsWidget* m_mouseAlgoStatsWidget;
+    // Warns about, and returns false for, an incomplete configuration
+    bool checkMouseAlgoConfig(const QString& algoName);
     void mouseAlgoRunStart();
     void mouseAlgoRunStop();
     void handleMouseAlgoCannotStart(QString errorString);
@@ -190,13 +232,59 @@ private:
     RandomSeedWidget* m_mouseAlgoSeedWidget;
     QVector<QPushButton*> m_mouseAlgoInputButtons;
 
+    // Mouse algo racing: a rival algorithm runs on the same maze, under the
+    // same sim clock, with its own mouse, view, interface, thread, process
+    // and stats. The main mouse is followed, and the rival is drawn over the
+    // main mouse's view, translucent.
+    static constexpr double RIVAL_MOUSE_ALPHA = 0.5;
+    QComboBox* m_mouseAlgoRivalComboBox;
+    QPlainTextEdit* m_mouseAlgoRivalOutput;
+    QStringList m_rivalStderrBuffer;
+    Mouse* m_rivalMouse;
+    MouseGraphic* m_rivalMouseGraphic;
+    MazeView* m_rivalView;
+    MouseInterface* m_rivalMouseInterface;
+    QThread* m_rivalMouseAlgoThread;
+    void rivalAlgoRunStart(
+        const QString& algoName,
+        Mouse* mouse,
+        MazeView* view,
+        MouseGraphic* mouseGraphic,
+        MouseInterface* mouseInterface,
+        quint32 seed);
+    void rivalAlgoRunStop();
+
+    // Ghost runs: a recorded trajectory, e.g., a stored best run, played back
+    // as a translucent mouse alongside the live one. The ghost follows the
+    // sim clock, and is interpolated between samples rather than simulated.
+    static constexpr double GHOST_MOUSE_ALPHA = 0.3;
+    Mouse* m_ghostMouse;
+    MouseGraphic* m_ghostMouseGraphic;
+    TrajectoryPlayer* m_ghostPlayer;
+    void saveTrajectory();
+    void loadGhost();
+    void clearGhost();
+
+    // Draws the rival and the ghost, whichever there are, with the map
+    void updateOtherMouseGraphics();
+
+    // Checkpoints of the latest run, which the map can be rewound to. The
+    // last position of the rewind slider is the live run, and the others
+    // show checkpoints, with a mouse and view of their own.
+    CheckpointHistory m_checkpoints;
+    QSlider* m_rewindSlider;
+    QLabel* m_rewindLabel;
+    Mouse* m_rewindMouse;
+    MazeView* m_rewindView;
+    MouseGraphic* m_rewindMouseGraphic;
+    void captureCheckpoint(const MouseInterface* mouseInterface);
+    void updateRewindSlider();
+    void rewindTo(int index);
+    void rewindStop();
+
     void mouseAlgoRefresh(const QString& name = "");
     QVector<ConfigDialogField> mouseAlgoGetFields();
 
-    // Given some text (and a buffer containing past input), return
-    // all complete lines and append remaining text to the buffer
-    QStringList getLines(const QString& text, QStringList* buffer);
-
     // ----- Misc ----- //
 
     QMap<QString, QLabel*> m_runStats;
@@ -17,3 +17,7 @@ DESTDIR     = ../../bin
 MOC_DIR     = ../../build/moc/sim
 OBJECTS_DIR = ../../build/obj/sim
 RCC_DIR     = ../../build/rcc/sim
+
+# The tomasz maze algorithm, which MazeGenerator runs in-process
+SOURCES += ../maze/algos/tomasz/Algo.cpp ../maze/algos/tomasz/Interface.cpp
+HEADERS += ../maze/algos/tomasz/Algo.h ../maze/algos/tomasz/Interface.h